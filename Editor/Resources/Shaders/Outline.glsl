@@ -4,13 +4,14 @@
 #version 430
 
 layout(location = 0) in vec3 a_Position;
+// Per instance, locations 5 to 8
+layout(location = 5) in mat4 a_Transform;
 
 uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
 
 void main()
 {
-	gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
+	gl_Position = u_ViewProjection * a_Transform * vec4(a_Position, 1.0);
 }
 
 #type fragment
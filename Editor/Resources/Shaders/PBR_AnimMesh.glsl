@@ -21,17 +21,43 @@ layout(location = 4) in vec2 a_TexCoord;
 layout(location = 5) in ivec4 a_BoneIndices;
 layout(location = 6) in vec4 a_BoneWeights;
 
-uniform mat4 u_ViewProjectionMatrix;
-uniform mat4 u_ViewMatrix;
-uniform mat4 u_Transform;
+struct DirectionalLight
+{
+	vec3 Direction;
+	vec3 Radiance;
+	float Multiplier;
+};
 
-uniform mat4 u_LightMatrixCascade0;
-uniform mat4 u_LightMatrixCascade1;
-uniform mat4 u_LightMatrixCascade2;
-uniform mat4 u_LightMatrixCascade3;
+// Per frame, filled by SceneRenderer (SceneUniformData)
+layout(std140, binding = 0) uniform SceneData
+{
+	mat4 u_ViewProjectionMatrix;
+	mat4 u_ViewMatrix;
+	mat4 u_LightMatrixCascade0;
+	mat4 u_LightMatrixCascade1;
+	mat4 u_LightMatrixCascade2;
+	mat4 u_LightMatrixCascade3;
+	mat4 u_LightView;
+	vec4 u_CascadeSplits;
+	DirectionalLight u_DirectionalLights;
+	vec3 u_CameraPosition;
+	float u_LightSize;
+	float u_MaxShadowDistance;
+	float u_ShadowFade;
+	float u_CascadeTransitionFade;
+	float u_IBLContribution;
+	bool u_ShowCascades;
+	bool u_SoftShadows;
+	bool u_CascadeFading;
+};
 
-const int MAX_BONES = 100;
-uniform mat4 u_BoneTransforms[100];
+uniform mat4 u_Transform;
+
+// Bone palette of the mesh being drawn, filled by Renderer
+layout(std430, binding = 1) readonly buffer BoneTransforms
+{
+	mat4 u_BoneTransforms[];
+};
 
 out VertexOutput
 {
@@ -103,8 +129,28 @@ in VertexOutput
 layout(location = 0) out vec4 color;
 layout(location = 1) out vec4 o_BloomColor;
 
-uniform DirectionalLight u_DirectionalLights;
-uniform vec3 u_CameraPosition;
+// Per frame, filled by SceneRenderer (SceneUniformData)
+layout(std140, binding = 0) uniform SceneData
+{
+	mat4 u_ViewProjectionMatrix;
+	mat4 u_ViewMatrix;
+	mat4 u_LightMatrixCascade0;
+	mat4 u_LightMatrixCascade1;
+	mat4 u_LightMatrixCascade2;
+	mat4 u_LightMatrixCascade3;
+	mat4 u_LightView;
+	vec4 u_CascadeSplits;
+	DirectionalLight u_DirectionalLights;
+	vec3 u_CameraPosition;
+	float u_LightSize;
+	float u_MaxShadowDistance;
+	float u_ShadowFade;
+	float u_CascadeTransitionFade;
+	float u_IBLContribution;
+	bool u_ShowCascades;
+	bool u_SoftShadows;
+	bool u_CascadeFading;
+};
 
 // PBR texture inputs
 uniform sampler2D u_AlbedoTexture;
@@ -121,18 +167,6 @@ uniform sampler2D u_BRDFLUTTexture;
 
 // PCSS
 uniform sampler2D u_ShadowMapTexture[4];
-uniform mat4 u_LightView;
-uniform bool u_ShowCascades;
-uniform bool u_SoftShadows;
-uniform float u_LightSize;
-uniform float u_MaxShadowDistance;
-uniform float u_ShadowFade;
-uniform bool u_CascadeFading;
-uniform float u_CascadeTransitionFade;
-
-uniform vec4 u_CascadeSplits;
-
-uniform float u_IBLContribution;
 
 uniform float u_BloomThreshold;
 
@@ -17,15 +17,38 @@ layout(location = 1) in vec3 a_Normal;
 layout(location = 2) in vec3 a_Tangent;
 layout(location = 3) in vec3 a_Binormal;
 layout(location = 4) in vec2 a_TexCoord;
+// Per instance, locations 5 to 8
+layout(location = 5) in mat4 a_Transform;
 
-uniform mat4 u_ViewProjectionMatrix;
-uniform mat4 u_ViewMatrix;
-uniform mat4 u_Transform;
+struct DirectionalLight
+{
+	vec3 Direction;
+	vec3 Radiance;
+	float Multiplier;
+};
 
-uniform mat4 u_LightMatrixCascade0;
-uniform mat4 u_LightMatrixCascade1;
-uniform mat4 u_LightMatrixCascade2;
-uniform mat4 u_LightMatrixCascade3;
+// Per frame, filled by SceneRenderer (SceneUniformData)
+layout(std140, binding = 0) uniform SceneData
+{
+	mat4 u_ViewProjectionMatrix;
+	mat4 u_ViewMatrix;
+	mat4 u_LightMatrixCascade0;
+	mat4 u_LightMatrixCascade1;
+	mat4 u_LightMatrixCascade2;
+	mat4 u_LightMatrixCascade3;
+	mat4 u_LightView;
+	vec4 u_CascadeSplits;
+	DirectionalLight u_DirectionalLights;
+	vec3 u_CameraPosition;
+	float u_LightSize;
+	float u_MaxShadowDistance;
+	float u_ShadowFade;
+	float u_CascadeTransitionFade;
+	float u_IBLContribution;
+	bool u_ShowCascades;
+	bool u_SoftShadows;
+	bool u_CascadeFading;
+};
 
 out VertexOutput
 {
@@ -41,11 +64,11 @@ out VertexOutput
 
 void main()
 {
-	vs_Output.WorldPosition = vec3(u_Transform * vec4(a_Position, 1.0));
-	vs_Output.Normal = mat3(u_Transform) * a_Normal;
+	vs_Output.WorldPosition = vec3(a_Transform * vec4(a_Position, 1.0));
+	vs_Output.Normal = mat3(a_Transform) * a_Normal;
 	vs_Output.TexCoord = vec2(a_TexCoord.x, 1.0 - a_TexCoord.y);
-	vs_Output.WorldNormals = mat3(u_Transform) * mat3(a_Tangent, a_Binormal, a_Normal);
-	vs_Output.WorldTransform = mat3(u_Transform);
+	vs_Output.WorldNormals = mat3(a_Transform) * mat3(a_Tangent, a_Binormal, a_Normal);
+	vs_Output.WorldTransform = mat3(a_Transform);
 	vs_Output.Binormal = a_Binormal;
 
 	vs_Output.ShadowMapCoords[0] = u_LightMatrixCascade0 * vec4(vs_Output.WorldPosition, 1.0);
@@ -54,7 +77,7 @@ void main()
 	vs_Output.ShadowMapCoords[3] = u_LightMatrixCascade3 * vec4(vs_Output.WorldPosition, 1.0);
 	vs_Output.ViewPosition = vec3(u_ViewMatrix * vec4(vs_Output.WorldPosition, 1.0));
 	
-	gl_Position = u_ViewProjectionMatrix * u_Transform * vec4(a_Position, 1.0);
+	gl_Position = u_ViewProjectionMatrix * a_Transform * vec4(a_Position, 1.0);
 }
 
 #type fragment
@@ -90,8 +113,28 @@ in VertexOutput
 layout(location = 0) out vec4 color;
 layout(location = 1) out vec4 o_BloomColor;
 
-uniform DirectionalLight u_DirectionalLights;
-uniform vec3 u_CameraPosition;
+// Per frame, filled by SceneRenderer (SceneUniformData)
+layout(std140, binding = 0) uniform SceneData
+{
+	mat4 u_ViewProjectionMatrix;
+	mat4 u_ViewMatrix;
+	mat4 u_LightMatrixCascade0;
+	mat4 u_LightMatrixCascade1;
+	mat4 u_LightMatrixCascade2;
+	mat4 u_LightMatrixCascade3;
+	mat4 u_LightView;
+	vec4 u_CascadeSplits;
+	DirectionalLight u_DirectionalLights;
+	vec3 u_CameraPosition;
+	float u_LightSize;
+	float u_MaxShadowDistance;
+	float u_ShadowFade;
+	float u_CascadeTransitionFade;
+	float u_IBLContribution;
+	bool u_ShowCascades;
+	bool u_SoftShadows;
+	bool u_CascadeFading;
+};
 
 // PBR texture inputs
 uniform sampler2D u_AlbedoTexture;
@@ -108,18 +151,6 @@ uniform sampler2D u_BRDFLUTTexture;
 
 // PCSS
 uniform sampler2D u_ShadowMapTexture[4];
-uniform mat4 u_LightView;
-uniform bool u_ShowCascades;
-uniform bool u_SoftShadows;
-uniform float u_LightSize;
-uniform float u_MaxShadowDistance;
-uniform float u_ShadowFade;
-uniform bool u_CascadeFading;
-uniform float u_CascadeTransitionFade;
-
-uniform vec4 u_CascadeSplits;
-
-uniform float u_IBLContribution;
 
 uniform float u_BloomThreshold;
 
@@ -3,26 +3,38 @@
 #type vertex
 #version 430 core
 
-layout(location = 0) in vec3 a_Position;
-layout(location = 1) in vec4 a_Color;
-layout(location = 2) in vec2 a_TexCoord;
-layout(location = 3) in float a_TexIndex;
-layout(location = 4) in float a_TilingFactor;
+// One instance per quad, see QuadInstance in Renderer2D.cpp
+layout(location = 0) in vec3 a_Origin;
+layout(location = 1) in vec3 a_AxisX;
+layout(location = 2) in vec3 a_AxisY;
+layout(location = 3) in vec4 a_Color;
+layout(location = 4) in vec4 a_TexRect;
+layout(location = 5) in float a_TexIndex;
+layout(location = 6) in float a_TexLayer;
+layout(location = 7) in float a_TilingFactor;
 
 uniform mat4 u_ViewProjection;
 
 out vec4 v_Color;
 out vec2 v_TexCoord;
 out float v_TexIndex;
+out float v_TexLayer;
 out float v_TilingFactor;
 
+// Indexed by the quad index buffer, which only references the vertices 0-3
+const vec2 QuadCorners[4] = vec2[4](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
+
 void main()
 {
+	vec2 corner = QuadCorners[gl_VertexID];
+	vec3 position = a_Origin + (corner.x - 0.5) * a_AxisX + (corner.y - 0.5) * a_AxisY;
+
 	v_Color = a_Color;
-	v_TexCoord = a_TexCoord;
+	v_TexCoord = mix(a_TexRect.xy, a_TexRect.zw, corner);
 	v_TexIndex = a_TexIndex;
+	v_TexLayer = a_TexLayer;
 	v_TilingFactor = a_TilingFactor;
-	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+	gl_Position = u_ViewProjection * vec4(position, 1.0);
 }
 
 #type fragment
@@ -33,11 +45,13 @@ layout(location = 0) out vec4 color;
 in vec4 v_Color;
 in vec2 v_TexCoord;
 in float v_TexIndex;
+in float v_TexLayer;
 in float v_TilingFactor;
 
-uniform sampler2D u_Textures[32];
+// Renderer2D copies every texture into a layer of an array shared by the textures of the same size and format
+uniform sampler2DArray u_Textures[32];
 
 void main()
 {
-	color = texture(u_Textures[int(v_TexIndex)], v_TexCoord * v_TilingFactor) * v_Color;
+	color = texture(u_Textures[int(v_TexIndex)], vec3(v_TexCoord * v_TilingFactor, v_TexLayer)) * v_Color;
 }
\ No newline at end of file
@@ -11,8 +11,11 @@ layout(location = 6) in vec4 a_BoneWeights;
 uniform mat4 u_ViewProjection;
 uniform mat4 u_Transform;
 
-const int MAX_BONES = 100;
-uniform mat4 u_BoneTransforms[100];
+// Bone palette of the mesh being drawn, filled by Renderer
+layout(std430, binding = 1) readonly buffer BoneTransforms
+{
+	mat4 u_BoneTransforms[];
+};
 
 void main()
 {
@@ -52,6 +52,10 @@ Luma::Application* Luma::CreateApplication(int argc, char** argv)
 	specification.WindowHeight = 900;
 	specification.Mode = WindowMode::Windowed;
 	specification.VSync = true;
+	if (cli.HaveOpt("render-thread"))
+		specification.CoreThreadingPolicy = ThreadingPolicy::MultiThreaded;
+	if (cli.HaveOpt("no-shader-cache"))
+		specification.ShaderCacheDirectory.clear();
 
 	return new LumaEditorApplication(specification);
 }
\ No newline at end of file
@@ -3,9 +3,11 @@
 
 #include "Luma/Renderer/Renderer.hpp"
 #include "Luma/Renderer/Framebuffer.hpp"
+#include "Luma/Renderer/Shader.hpp"
 
 #include "Input.hpp"
 #include "FatalSignal.hpp"
+#include "FrameAllocator.hpp"
 
 #include "Luma/Utilities/StringUtils.hpp"
 #include "Luma/Debug/Profiler.hpp"
@@ -27,7 +29,7 @@ namespace Luma {
 	static std::thread::id s_MainThreadID;
 
 	Application::Application(const ApplicationSpecification& specification)
-		: m_Specification(specification)
+		: m_Specification(specification), m_RenderThread(specification.CoreThreadingPolicy)
 	{
 		FatalSignal::Install();
 
@@ -51,9 +53,18 @@ namespace Luma {
 
 		LM_CORE_VERIFY(NFD::Init() == NFD_OKAY);
 
+		Shader::SetProgramCacheDirectory(specification.ShaderCacheDirectory);
+
+		// Most of the start-up time goes into creating the shader programs, compare runs with and without the cache
+		Timer rendererInitTimer;
 		Renderer::Init();
 		Renderer::WaitAndRender();
 
+		ShaderProgramCacheStats shaderCacheStats = Shader::GetProgramCacheStats();
+		LM_CORE_INFO_TAG("Renderer", "Renderer initialized in {:.2f}ms, {} shader programs loaded from cache and {} compiled ({} rejected) in {:.2f}ms",
+			rendererInitTimer.ElapsedMillis(), shaderCacheStats.LoadedPrograms, shaderCacheStats.CompiledPrograms,
+			shaderCacheStats.RejectedPrograms, shaderCacheStats.ProgramCreationTime);
+
 		m_Window->SetResizable(specification.Resizable);
 		if (windowSpec.Mode == WindowMode::Windowed)
 			m_Window->CenterWindow();
@@ -77,6 +88,10 @@ namespace Luma {
 			delete layer;
 		}
 
+		// The render thread is gone, the context belongs to this thread again
+		Renderer::Shutdown();
+		Renderer::WaitAndRender();
+
 		m_Window->Shutdown();
 
 		delete m_Profiler;
@@ -116,6 +131,23 @@ namespace Luma {
 
 		for (int i = 0; i < m_LayerStack.Size(); i++)
 			m_LayerStack[i]->OnImGuiRender();
+
+		m_ImGuiLayer->End();
+	}
+
+	void Application::FlushRenderCommands()
+	{
+		LM_CORE_ASSERT(IsMainThread());
+
+		if (!m_RenderThread.IsRunning())
+		{
+			Renderer::WaitAndRender();
+			return;
+		}
+
+		m_RenderThread.BlockUntilRenderComplete();
+		m_RenderThread.Kick();
+		m_RenderThread.BlockUntilRenderComplete();
 	}
 
 	void Application::SyncEvents()
@@ -130,15 +162,36 @@ namespace Luma {
 	void Application::Run()
 	{
 		OnInit();
+
+		// Anything submitted during initialization still runs on this thread
+		Renderer::WaitAndRender();
+		m_RenderThread.Run();
+
 		while (m_Running)
 		{
 			static uint64_t frameCounter = 0;
 
+			// Wait for the render thread to finish the previous frame,
+			// until the next kick neither thread touches render state
+			{
+				Timer waitTimer;
+				m_RenderThread.BlockUntilRenderComplete();
+				m_PerformanceTimers.MainThreadWaitTime = waitTimer.ElapsedMillis();
+			}
+			m_PerformanceTimers.RenderThreadWorkTime = m_RenderThread.GetWorkTime();
+			m_PerformanceTimers.RenderThreadWaitTime = m_RenderThread.GetWaitTime();
+
+			FrameAllocator::BeginFrame();
+
 			ProcessEvents();
 
 			m_ProfilerPreviousFrameData = m_Profiler->GetPerFrameData();
 			m_Profiler->Clear();
 
+			// Start executing the previous frame while this one is recorded
+			if (m_RenderThread.GetPolicy() == ThreadingPolicy::MultiThreaded)
+				m_RenderThread.Kick();
+
 			if (!m_Minimized)
 			{
 				Timer cpuTimer;
@@ -149,15 +202,16 @@ namespace Luma {
 						layer->OnUpdate(m_TimeStep);
 				}
 
-				// Render ImGui on render thread
-				Application* app = this;
+				// Layers build their UI from the state OnUpdate just left behind, so the previous frame has
+				// to be done rendering first. It still reads the ImGui context and the render statistics.
 				if (m_Specification.EnableImGui)
 				{
-					Renderer::Submit([app]() { app->RenderImGui(); });
-					Renderer::Submit([=]() { m_ImGuiLayer->End(); });
-				}
+					Timer waitTimer;
+					m_RenderThread.BlockUntilRenderComplete();
+					m_PerformanceTimers.MainThreadWaitTime += waitTimer.ElapsedMillis();
 
-				Renderer::WaitAndRender();
+					RenderImGui();
+				}
 
 				Renderer::Submit([&]()
 				{
@@ -167,6 +221,10 @@ namespace Luma {
 				m_PerformanceTimers.MainThreadWorkTime = cpuTimer.ElapsedMillis();
 			}
 
+			// Without a render thread the frame executes right away instead of one frame late
+			if (m_RenderThread.GetPolicy() == ThreadingPolicy::SingleThreaded)
+				m_RenderThread.Kick();
+
 			Input::ClearReleasedKeys();
 
 			float time = GetTime();
@@ -178,6 +236,10 @@ namespace Luma {
 
 			LM_PROFILE_MARK_FRAME;
 		}
+
+		// Executes the last frame and gives the context back to this thread for shutdown
+		m_RenderThread.Terminate();
+
 		OnShutdown();
 	}
 
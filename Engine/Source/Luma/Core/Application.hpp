@@ -5,6 +5,7 @@
 #include "Luma/Core/Timer.hpp"
 #include "Luma/Core/Window.hpp"
 #include "Luma/Core/LayerStack.hpp"
+#include "Luma/Core/RenderThread.hpp"
 
 #include "Luma/Events/ApplicationEvent.hpp"
 
@@ -25,7 +26,10 @@ namespace Luma {
 		std::string WorkingDirectory;
 		bool Resizable = true;
 		bool EnableImGui = true;
+		ThreadingPolicy CoreThreadingPolicy = ThreadingPolicy::SingleThreaded;
 		std::filesystem::path IconPath;
+		// Linked shader programs are cached here, an empty path disables the cache
+		std::filesystem::path ShaderCacheDirectory = "Cache/Shaders";
 	};
 
 	class Application
@@ -36,6 +40,8 @@ namespace Luma {
 		{
 			float MainThreadWorkTime = 0.0f;
 			float MainThreadWaitTime = 0.0f;
+			float RenderThreadWorkTime = 0.0f;
+			float RenderThreadWaitTime = 0.0f;
 		};
 	public:
 		Application(const ApplicationSpecification& specification);
@@ -56,6 +62,10 @@ namespace Luma {
 		void PopOverlay(Layer* overlay);
 		void RenderImGui();
 
+		// Executes everything submitted so far and waits until it has run. Stalls the render thread,
+		// only meant for code that needs results back from the GPU right away, like tests reading pixels.
+		void FlushRenderCommands();
+
 		void AddEventCallback(const EventCallbackFn& eventCallback) { m_EventCallbacks.push_back(eventCallback); }
 
 		template<typename Func>
@@ -126,6 +136,7 @@ namespace Luma {
 	private:
 		Ref<Window> m_Window;
 		ApplicationSpecification m_Specification;
+		RenderThread m_RenderThread;
 
 		bool m_Running = true, m_Minimized = false;
 		LayerStack m_LayerStack;
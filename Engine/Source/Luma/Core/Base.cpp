@@ -3,6 +3,8 @@
 
 #include "Log.hpp"
 #include "Memory.hpp"
+#include "FrameAllocator.hpp"
+#include "JobSystem.hpp"
 
 namespace Luma {
 
@@ -11,6 +13,8 @@ namespace Luma {
 		Platform::Init();
 		Allocator::Init();
 		Log::Init();
+		FrameAllocator::Init();
+		JobSystem::Init();
 
 		LM_CORE_TRACE_TAG("Core", "Luma Engine {}", LM_VERSION);
 		LM_CORE_TRACE_TAG("Core", "Initializing...");
@@ -19,6 +23,8 @@ namespace Luma {
 	void ShutdownCore()
 	{
 		LM_CORE_TRACE_TAG("Core", "Shutting down...");
+		JobSystem::Shutdown();
+		FrameAllocator::Shutdown();
 		Log::Shutdown();
 	}
 
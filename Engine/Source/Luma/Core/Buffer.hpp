@@ -4,11 +4,67 @@
 
 namespace Luma {
 
+	// Non-owning view of a range of bytes, slicing it never allocates or copies
+	struct BufferView
+	{
+		const void* Data = nullptr;
+		uint64_t Size = 0;
+
+		BufferView() = default;
+
+		BufferView(const void* data, uint64_t size)
+			: Data(data), Size(size) { }
+
+		BufferView Slice(uint64_t offset, uint64_t size) const
+		{
+			LM_CORE_ASSERT(offset <= Size && size <= Size - offset, "BufferView slice out of range!");
+			return BufferView((const byte*)Data + offset, size);
+		}
+
+		BufferView Slice(uint64_t offset) const
+		{
+			LM_CORE_ASSERT(offset <= Size, "BufferView slice out of range!");
+			return BufferView((const byte*)Data + offset, Size - offset);
+		}
+
+		template<typename T>
+		const T* As(uint64_t offset = 0) const
+		{
+			LM_CORE_ASSERT(offset <= Size && sizeof(T) <= Size - offset, "BufferView read out of range!");
+			return (const T*)((const byte*)Data + offset);
+		}
+
+		template<typename T>
+		const T& Read(uint64_t offset = 0) const
+		{
+			return *As<T>(offset);
+		}
+
+		bool IsAligned(uint64_t alignment) const
+		{
+			return ((uintptr_t)Data & (alignment - 1)) == 0;
+		}
+
+		operator bool() const
+		{
+			return (bool)Data;
+		}
+
+		byte operator[](uint64_t index) const
+		{
+			return ((const byte*)Data)[index];
+		}
+
+		inline uint64_t GetSize() const { return Size; }
+	};
+
 	struct Buffer
 	{
 		void* Data = nullptr;
 		uint64_t Size = 0;
 
+		static constexpr uint64_t DefaultAlignment = alignof(std::max_align_t);
+
 		Buffer() = default;
 
 		Buffer(const void* data, uint64_t size = 0)
@@ -30,21 +86,27 @@ namespace Luma {
 			return buffer;
 		}
 
-		void Allocate(uint64_t size)
+		// Data is aligned to alignment (a power of two), the block is over-allocated to make room for it
+		void Allocate(uint64_t size, uint64_t alignment = DefaultAlignment)
 		{
-			delete[] (byte*)Data;
-			Data = nullptr;
+			Release();
 			Size = size;
 
 			if (size == 0)
 				return;
 
-			Data = lnew byte[size];
+			LM_CORE_ASSERT(alignment && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two!");
+
+			m_Allocation = lnew byte[size + alignment - 1];
+			Data = (void*)(((uintptr_t)m_Allocation + alignment - 1) & ~(uintptr_t)(alignment - 1));
 		}
 
+		// Only frees memory that Allocate returned, wrapped memory stays with whoever owns it
 		void Release()
 		{
-			delete[] (byte*)Data;
+			delete[] m_Allocation;
+			m_Allocation = nullptr;
+
 			Data = nullptr;
 			Size = 0;
 		}
@@ -67,12 +129,9 @@ namespace Luma {
 			return *(T*)((byte*)Data + offset);
 		}
 
-		byte* ReadBytes(uint64_t size, uint64_t offset) const
+		BufferView ReadBytes(uint64_t size, uint64_t offset) const
 		{
-			LM_CORE_ASSERT(offset + size <= Size, "Buffer overflow!");
-			byte* buffer = lnew byte[size];
-			memcpy(buffer, (byte*)Data + offset, size);
-			return buffer;
+			return GetView().Slice(offset, size);
 		}
 
 		void Write(const void* data, uint64_t size, uint64_t offset = 0)
@@ -103,6 +162,11 @@ namespace Luma {
 		}
 
 		inline uint64_t GetSize() const { return Size; }
+
+		BufferView GetView() const { return BufferView(Data, Size); }
+		operator BufferView() const { return GetView(); }
+	private:
+		byte* m_Allocation = nullptr;
 	};
 
 	struct BufferSafe : public Buffer
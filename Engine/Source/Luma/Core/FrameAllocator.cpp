@@ -0,0 +1,125 @@
+#include "lmpch.hpp"
+#include "FrameAllocator.hpp"
+
+#include "Memory.hpp"
+
+#include <algorithm>
+
+namespace Luma {
+
+	static const char* s_FrameAllocatorCategory = "FrameAllocator";
+
+	static uintptr_t AlignUp(uintptr_t value, size_t alignment)
+	{
+		return (value + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	}
+
+	LinearAllocator::LinearAllocator(size_t capacity)
+		: m_Capacity(capacity)
+	{
+		m_Data = (uint8_t*)Allocator::Allocate(m_Capacity, s_FrameAllocatorCategory);
+	}
+
+	LinearAllocator::~LinearAllocator()
+	{
+		Reset();
+		Allocator::Free(m_Data);
+	}
+
+	void* LinearAllocator::Allocate(size_t size, size_t alignment)
+	{
+		LM_CORE_ASSERT(alignment && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+		const uintptr_t base = (uintptr_t)m_Data;
+		size_t offset = m_Offset.load(std::memory_order_relaxed);
+		size_t alignedOffset;
+		do
+		{
+			alignedOffset = AlignUp(base + offset, alignment) - base;
+			if (alignedOffset + size > m_Capacity)
+				return AllocateOverflow(size, alignment);
+		} while (!m_Offset.compare_exchange_weak(offset, alignedOffset + size, std::memory_order_relaxed));
+
+		return m_Data + alignedOffset;
+	}
+
+	void* LinearAllocator::AllocateOverflow(size_t size, size_t alignment)
+	{
+		std::scoped_lock<std::mutex> lock(m_OverflowMutex);
+
+		void* block = Allocator::Allocate(size + alignment - 1, s_FrameAllocatorCategory);
+		m_OverflowBlocks.push_back(block);
+		m_OverflowSize += size;
+
+		return (void*)AlignUp((uintptr_t)block, alignment);
+	}
+
+	void LinearAllocator::Reset()
+	{
+		const size_t usedSize = GetUsedSize();
+		m_PeakUsedSize = std::max(m_PeakUsedSize, usedSize);
+
+		if (!m_OverflowBlocks.empty())
+		{
+			for (void* block : m_OverflowBlocks)
+				Allocator::Free(block);
+			m_OverflowBlocks.clear();
+
+			// Grow with some headroom so that a slowly growing workload doesn't reallocate every frame
+			m_Capacity = usedSize + usedSize / 2;
+			Allocator::Free(m_Data);
+			m_Data = (uint8_t*)Allocator::Allocate(m_Capacity, s_FrameAllocatorCategory);
+		}
+
+		m_OverflowSize = 0;
+		m_Offset.store(0, std::memory_order_relaxed);
+	}
+
+	void FrameAllocator::Init(size_t capacity)
+	{
+		for (auto& arena : s_Arenas)
+			arena = new LinearAllocator(capacity);
+		s_CurrentArena = 0;
+	}
+
+	void FrameAllocator::Shutdown()
+	{
+		for (auto& arena : s_Arenas)
+		{
+			delete arena;
+			arena = nullptr;
+		}
+	}
+
+	void FrameAllocator::BeginFrame()
+	{
+		s_CurrentArena = (s_CurrentArena + 1) % 2;
+		s_Arenas[s_CurrentArena]->Reset();
+		s_FrameIndex++;
+	}
+
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		LM_CORE_ASSERT(s_Arenas[s_CurrentArena], "FrameAllocator has not been initialized!");
+		return s_Arenas[s_CurrentArena]->Allocate(size, alignment);
+	}
+
+	FrameAllocatorStats FrameAllocator::GetStats()
+	{
+		FrameAllocatorStats stats;
+		for (const auto* arena : s_Arenas)
+		{
+			if (!arena)
+				continue;
+
+			stats.Capacity += arena->GetCapacity();
+			stats.PeakUsedSize = std::max(stats.PeakUsedSize, arena->GetPeakUsedSize());
+		}
+
+		if (s_Arenas[s_CurrentArena])
+			stats.UsedSize = s_Arenas[s_CurrentArena]->GetUsedSize();
+
+		return stats;
+	}
+
+}
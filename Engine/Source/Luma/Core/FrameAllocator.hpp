@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Luma {
+
+	// Bump allocator over a single block. Memory is never freed individually, Reset() releases
+	// everything at once. Allocations that don't fit spill into overflow blocks, and the next
+	// Reset() grows the main block to the peak usage so a steady workload stops overflowing.
+	class LinearAllocator
+	{
+	public:
+		LinearAllocator(size_t capacity);
+		~LinearAllocator();
+
+		LinearAllocator(const LinearAllocator&) = delete;
+		LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+		// Safe to call from multiple threads, but not concurrently with Reset()
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		void Reset();
+
+		size_t GetCapacity() const { return m_Capacity; }
+		size_t GetUsedSize() const { return m_Offset.load(std::memory_order_relaxed) + m_OverflowSize; }
+		size_t GetPeakUsedSize() const { return m_PeakUsedSize; }
+	private:
+		void* AllocateOverflow(size_t size, size_t alignment);
+	private:
+		uint8_t* m_Data = nullptr;
+		size_t m_Capacity = 0;
+		std::atomic<size_t> m_Offset = 0;
+
+		std::mutex m_OverflowMutex;
+		std::vector<void*> m_OverflowBlocks;
+		size_t m_OverflowSize = 0;
+
+		size_t m_PeakUsedSize = 0;
+	};
+
+	struct FrameAllocatorStats
+	{
+		size_t Capacity = 0;
+		size_t UsedSize = 0;
+		size_t PeakUsedSize = 0;
+	};
+
+	// Arena for data that only lives for the current frame. There are two arenas which are swapped at
+	// the start of every frame, so memory handed out during frame N stays valid until frame N + 2 begins.
+	// That covers render commands submitted in frame N but executed at the start of frame N + 1.
+	class FrameAllocator
+	{
+	public:
+		static void Init(size_t capacity = 4 * 1024 * 1024);
+		static void Shutdown();
+
+		static void BeginFrame();
+
+		static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		template<typename T>
+		static T* Allocate(size_t count)
+		{
+			return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		static FrameAllocatorStats GetStats();
+
+		// Incremented by BeginFrame. Lets per-frame caches tell whether arena memory they point to is still current.
+		static uint64_t GetFrameIndex() { return s_FrameIndex; }
+	private:
+		inline static LinearAllocator* s_Arenas[2] = { nullptr, nullptr };
+		inline static uint32_t s_CurrentArena = 0;
+		inline static uint64_t s_FrameIndex = 0;
+	};
+
+	// Allocator adapter for STL containers. Deallocation is a no-op, so containers must not outlive the frame
+	// they were filled in (destroy them or swap them with an empty container before the arena is reused).
+	template<typename T>
+	struct FrameStlAllocator
+	{
+		typedef T value_type;
+
+		FrameStlAllocator() = default;
+		template<typename U> constexpr FrameStlAllocator(const FrameStlAllocator<U>&) noexcept {}
+
+		T* allocate(std::size_t n) { return FrameAllocator::Allocate<T>(n); }
+		void deallocate(T* p, std::size_t n) noexcept {}
+
+		template<typename U> bool operator==(const FrameStlAllocator<U>&) const noexcept { return true; }
+		template<typename U> bool operator!=(const FrameStlAllocator<U>&) const noexcept { return false; }
+	};
+
+	template<typename T>
+	using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+
+	using FrameString = std::basic_string<char, std::char_traits<char>, FrameStlAllocator<char>>;
+
+}
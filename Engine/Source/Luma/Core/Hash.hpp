@@ -27,6 +27,19 @@ namespace Luma {
 			return hash;
 		}
 
+		// 64-bit FNV-1a, pass the previous result as hash to continue hashing over several strings
+		static constexpr uint64_t GenerateFNVHash64(std::string_view str, uint64_t hash = 14695981039346656037ull)
+		{
+			constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+			for (char c : str)
+			{
+				hash ^= (uint8_t)c;
+				hash *= FNV_PRIME;
+			}
+			return hash;
+		}
+
 		static uint32_t CRC32(const char* str);
 		static uint32_t CRC32(const std::string& string);
 	};
@@ -0,0 +1,353 @@
+#include "lmpch.hpp"
+#include "JobSystem.hpp"
+
+#include "Platform.hpp"
+#include "PoolAllocator.hpp"
+#include "Thread.hpp"
+
+#include "Luma/Debug/Profiler.hpp"
+
+namespace Luma {
+
+	static constexpr uint32_t s_JobSizeClass = PoolAllocator::GetSizeClass(sizeof(Job));
+	static_assert(PoolAllocator::CanAllocate(sizeof(Job), alignof(Job)));
+
+	// Chase-Lev deque. Only the owning thread pushes and pops (LIFO, keeps caches warm),
+	// any other thread may steal from the opposite end.
+	class WorkStealingDeque
+	{
+	public:
+		static constexpr int64_t Capacity = 4096;
+
+		bool Push(Job* job)
+		{
+			int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+			int64_t top = m_Top.load(std::memory_order_acquire);
+			if (bottom - top >= Capacity)
+				return false;
+
+			m_Jobs[bottom & (Capacity - 1)].store(job, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		Job* Pop()
+		{
+			int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+			m_Bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = m_Top.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			Job* job = m_Jobs[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+			if (top == bottom)
+			{
+				// Last job, race the thieves for it
+				if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					job = nullptr;
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+			return job;
+		}
+
+		Job* Steal()
+		{
+			int64_t top = m_Top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+			if (top >= bottom)
+				return nullptr;
+
+			Job* job = m_Jobs[top & (Capacity - 1)].load(std::memory_order_relaxed);
+			if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+			return job;
+		}
+	private:
+		alignas(64) std::atomic<int64_t> m_Top = 0;
+		alignas(64) std::atomic<int64_t> m_Bottom = 0;
+		alignas(64) std::array<std::atomic<Job*>, Capacity> m_Jobs{};
+	};
+
+	struct JobSystemData
+	{
+		std::vector<Thread> Workers;
+		// Queue 0 belongs to the thread that called Init, the rest to the workers
+		std::vector<std::unique_ptr<WorkStealingDeque>> Queues;
+
+		// Jobs submitted from threads that don't own a queue
+		std::mutex GlobalQueueMutex;
+		std::deque<Job*> GlobalQueue;
+		std::atomic<uint32_t> GlobalQueueSize = 0;
+
+		std::atomic<uint32_t> QueuedJobs = 0;
+		std::atomic<uint32_t> SleepingWorkers = 0;
+		std::mutex SleepMutex;
+		std::condition_variable SleepCondition;
+		std::atomic<bool> Running = false;
+	};
+
+	static JobSystemData* s_Data = nullptr;
+	static thread_local int32_t s_QueueIndex = -1;
+	static thread_local uint32_t s_StealOffset = 0;
+
+	static void PushJob(Job* job)
+	{
+		s_Data->QueuedJobs.fetch_add(1);
+
+		if (s_QueueIndex < 0 || !s_Data->Queues[s_QueueIndex]->Push(job))
+		{
+			std::scoped_lock<std::mutex> lock(s_Data->GlobalQueueMutex);
+			s_Data->GlobalQueue.push_back(job);
+			s_Data->GlobalQueueSize.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (s_Data->SleepingWorkers.load() > 0)
+		{
+			// Taking the lock orders this against a worker that is about to sleep
+			{ std::scoped_lock<std::mutex> lock(s_Data->SleepMutex); }
+			s_Data->SleepCondition.notify_one();
+		}
+	}
+
+	static Job* FindJob()
+	{
+		Job* job = nullptr;
+
+		if (s_QueueIndex >= 0)
+			job = s_Data->Queues[s_QueueIndex]->Pop();
+
+		if (!job && s_Data->GlobalQueueSize.load(std::memory_order_relaxed) > 0)
+		{
+			std::scoped_lock<std::mutex> lock(s_Data->GlobalQueueMutex);
+			if (!s_Data->GlobalQueue.empty())
+			{
+				job = s_Data->GlobalQueue.front();
+				s_Data->GlobalQueue.pop_front();
+				s_Data->GlobalQueueSize.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+
+		if (!job)
+		{
+			const uint32_t queueCount = (uint32_t)s_Data->Queues.size();
+			const uint32_t start = s_StealOffset++;
+			for (uint32_t i = 0; i < queueCount && !job; i++)
+			{
+				uint32_t victim = (start + i) % queueCount;
+				if ((int32_t)victim != s_QueueIndex)
+					job = s_Data->Queues[victim]->Steal();
+			}
+		}
+
+		if (job)
+			s_Data->QueuedJobs.fetch_sub(1);
+		return job;
+	}
+
+	void JobSystem::Execute(Job* job)
+	{
+		job->Invoke(job->Storage);
+
+		JobCounter* counter = job->Counter;
+		PoolAllocator::Free(job, s_JobSizeClass);
+
+		if (counter)
+			Release(*counter);
+	}
+
+	void JobSystem::WorkerLoop(uint32_t queueIndex)
+	{
+		LM_PROFILE_THREAD(std::format("Job Worker {}", queueIndex).c_str());
+		s_QueueIndex = (int32_t)queueIndex;
+
+		while (s_Data->Running.load(std::memory_order_relaxed))
+		{
+			if (Job* job = FindJob())
+			{
+				Execute(job);
+				continue;
+			}
+
+			// Spin for a bit before sleeping, new work tends to arrive in bursts
+			bool hasWork = false;
+			for (uint32_t i = 0; i < 64 && !hasWork; i++)
+			{
+				std::this_thread::yield();
+				hasWork = s_Data->QueuedJobs.load(std::memory_order_relaxed) > 0;
+			}
+			if (hasWork)
+				continue;
+
+			std::unique_lock<std::mutex> lock(s_Data->SleepMutex);
+			s_Data->SleepingWorkers.fetch_add(1);
+			s_Data->SleepCondition.wait(lock, []
+			{
+				return s_Data->QueuedJobs.load() > 0 || !s_Data->Running.load();
+			});
+			s_Data->SleepingWorkers.fetch_sub(1);
+		}
+
+		s_QueueIndex = -1;
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		LM_CORE_ASSERT(!s_Data, "JobSystem already initialized!");
+
+		if (workerCount == 0)
+		{
+			// One thread per physical core, the calling thread takes part in the work while waiting.
+			// SMT siblings mostly contend for the same execution units with this kind of work.
+			CPUTopology topology = Platform::GetCPUTopology();
+			workerCount = std::max(topology.PhysicalCores, 2u) - 1;
+		}
+
+		s_Data = new JobSystemData();
+		s_Data->Running = true;
+
+		s_Data->Queues.reserve(workerCount + 1);
+		for (uint32_t i = 0; i < workerCount + 1; i++)
+			s_Data->Queues.push_back(std::make_unique<WorkStealingDeque>());
+		s_QueueIndex = 0;
+
+		s_Data->Workers.reserve(workerCount);
+		for (uint32_t i = 1; i <= workerCount; i++)
+		{
+			Thread& worker = s_Data->Workers.emplace_back(std::format("Job Worker {}", i));
+			worker.Dispatch(WorkerLoop, i);
+		}
+
+		LM_CORE_INFO_TAG("Core", "JobSystem initialized with {} workers", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (!s_Data)
+			return;
+
+		s_Data->Running = false;
+		{
+			std::scoped_lock<std::mutex> lock(s_Data->SleepMutex);
+			s_Data->SleepCondition.notify_all();
+		}
+
+		for (Thread& worker : s_Data->Workers)
+			worker.Join();
+
+		// Run whatever is still queued so that counters being waited on elsewhere complete
+		while (Job* job = FindJob())
+			Execute(job);
+
+		s_QueueIndex = -1;
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		while (counter.m_Value.load(std::memory_order_acquire) > 0)
+		{
+			if (s_Data)
+			{
+				if (Job* job = FindJob())
+				{
+					Execute(job);
+					continue;
+				}
+			}
+
+			std::this_thread::yield();
+		}
+
+		// The last job may still be handing over the jobs that depend on this counter
+		std::scoped_lock<std::mutex> lock(counter.m_WaitingJobsMutex);
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return s_Data ? (uint32_t)s_Data->Workers.size() : 0;
+	}
+
+	bool JobSystem::IsInitialized()
+	{
+		return s_Data != nullptr;
+	}
+
+	Job* JobSystem::AllocateJob()
+	{
+		return new (PoolAllocator::Allocate(s_JobSizeClass)) Job();
+	}
+
+	void JobSystem::Submit(Job* job, JobCounter* counter, JobCounter* dependency)
+	{
+		if (!s_Data)
+		{
+			// Without workers everything runs inline, so dependencies have already completed
+			Execute(job);
+			return;
+		}
+
+		job->Counter = counter;
+		if (counter)
+			counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+
+		if (dependency)
+		{
+			std::scoped_lock<std::mutex> lock(dependency->m_WaitingJobsMutex);
+			if (dependency->m_Value.load(std::memory_order_acquire) > 0)
+			{
+				job->Next = dependency->m_WaitingJobs;
+				dependency->m_WaitingJobs = job;
+				return;
+			}
+		}
+
+		PushJob(job);
+	}
+
+	void JobSystem::Release(JobCounter& counter)
+	{
+		// Only the final decrement needs the lock, it hands the waiting jobs over and
+		// keeps Wait from returning (and the counter from going away) until it is done
+		uint32_t value = counter.m_Value.load(std::memory_order_relaxed);
+		while (value > 1)
+		{
+			if (counter.m_Value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+				return;
+		}
+
+		Job* released = nullptr;
+		{
+			std::scoped_lock<std::mutex> lock(counter.m_WaitingJobsMutex);
+			if (counter.m_Value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				std::swap(released, counter.m_WaitingJobs);
+		}
+
+		while (released)
+		{
+			Job* next = released->Next;
+			released->Next = nullptr;
+			PushJob(released);
+			released = next;
+		}
+	}
+
+	uint32_t JobSystem::GetBatchCount(uint32_t count, uint32_t batchSize)
+	{
+		if (!s_Data)
+			return 1;
+
+		// A few batches per thread so that stealing can even out uneven work
+		uint32_t batchCount = (count + std::max(batchSize, 1u) - 1) / std::max(batchSize, 1u);
+		uint32_t maxBatchCount = ((uint32_t)s_Data->Workers.size() + 1) * 4;
+		return std::clamp(batchCount, 1u, maxBatchCount);
+	}
+
+}
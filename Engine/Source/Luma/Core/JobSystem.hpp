@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Luma {
+
+	struct Job;
+
+	// Number of outstanding jobs. Jobs scheduled with a counter increment it and decrement it once they
+	// have run, jobs scheduled with a dependency are held back until that counter reaches zero.
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		bool IsDone() const { return m_Value.load(std::memory_order_acquire) == 0; }
+		uint32_t GetValue() const { return m_Value.load(std::memory_order_acquire); }
+	private:
+		std::atomic<uint32_t> m_Value = 0;
+
+		std::mutex m_WaitingJobsMutex;
+		Job* m_WaitingJobs = nullptr;
+
+		friend class JobSystem;
+	};
+
+	struct Job
+	{
+		static constexpr size_t StorageSize = 64;
+
+		// Runs and destroys the callable held in Storage
+		void(*Invoke)(void* storage) = nullptr;
+		JobCounter* Counter = nullptr;
+		Job* Next = nullptr;
+
+		alignas(std::max_align_t) std::byte Storage[StorageSize];
+	};
+
+	// Work-stealing job system. Every worker owns a deque it pushes to and pops from, idle workers steal
+	// from the other end of the other deques. Threads waiting on a counter run jobs until it is done,
+	// so waiting inside a job or on the main thread never blocks a core.
+	class JobSystem
+	{
+	public:
+		// workerCount = 0 sizes the pool from the CPU topology
+		static void Init(uint32_t workerCount = 0);
+		static void Shutdown();
+
+		template<typename Fn>
+		static void Schedule(Fn&& func, JobCounter* counter = nullptr, JobCounter* dependency = nullptr)
+		{
+			using FnType = std::decay_t<Fn>;
+			static_assert(sizeof(FnType) <= Job::StorageSize, "Job captures are too large, capture by reference instead");
+			static_assert(alignof(FnType) <= alignof(std::max_align_t));
+
+			Job* job = AllocateJob();
+			new (job->Storage) FnType(std::forward<Fn>(func));
+			job->Invoke = [](void* storage)
+			{
+				FnType& fn = *(FnType*)storage;
+				fn();
+				fn.~FnType();
+			};
+
+			Submit(job, counter, dependency);
+		}
+
+		// Calls func(index) for every index in [0, count), at most batchSize indices per job.
+		// Returns once every index has been processed, the calling thread takes part in the work.
+		template<typename Fn>
+		static void ParallelFor(uint32_t count, uint32_t batchSize, Fn&& func)
+		{
+			if (count == 0)
+				return;
+
+			uint32_t batchCount = GetBatchCount(count, batchSize);
+			if (batchCount == 1)
+			{
+				for (uint32_t i = 0; i < count; i++)
+					func(i);
+				return;
+			}
+
+			JobCounter counter;
+			uint32_t indicesPerBatch = (count + batchCount - 1) / batchCount;
+			for (uint32_t begin = 0; begin < count; begin += indicesPerBatch)
+			{
+				uint32_t end = std::min(begin + indicesPerBatch, count);
+				Schedule([&func, begin, end]()
+				{
+					for (uint32_t i = begin; i < end; i++)
+						func(i);
+				}, &counter);
+			}
+
+			Wait(counter);
+		}
+
+		static void Wait(JobCounter& counter);
+
+		static uint32_t GetWorkerCount();
+		static bool IsInitialized();
+	private:
+		static Job* AllocateJob();
+		static void Submit(Job* job, JobCounter* counter, JobCounter* dependency);
+		static void Execute(Job* job);
+		static void Release(JobCounter& counter);
+		static void WorkerLoop(uint32_t queueIndex);
+		static uint32_t GetBatchCount(uint32_t count, uint32_t batchSize);
+	};
+
+}
@@ -1,9 +1,12 @@
 #include "lmpch.hpp"
 #include "Memory.hpp"
+#include "PoolAllocator.hpp"
 
+#include <atomic>
 #include <memory>
 #include <map>
 #include <mutex>
+#include <new>
 
 #include "Log.hpp"
 
@@ -11,45 +14,61 @@
 
 namespace Luma {
 
-	static Luma::AllocationStats s_GlobalStats;
+	// Every block handed out by Allocator is prefixed with this header so Free can recover
+	// the size and category without a global lookup table.
+	struct alignas(std::max_align_t) AllocationHeader
+	{
+		size_t Size;
+		const char* Category;
+	};
+
+	// Counters are only written by their owning thread, so updating them needs neither a lock nor an
+	// atomic read-modify-write. Memory::GetAllocationStats sums the counters of every thread.
+	struct ThreadAllocationCounters
+	{
+		std::atomic<size_t> TotalAllocated = 0;
+		std::atomic<size_t> TotalFreed = 0;
+		ThreadAllocationCounters* Next = nullptr;
+	};
 
-	static bool s_InInit = false;
+	static std::atomic<ThreadAllocationCounters*> s_ThreadCountersHead = nullptr;
+	static thread_local ThreadAllocationCounters* s_ThreadCounters = nullptr;
 
-	void Allocator::Init()
+	static ThreadAllocationCounters& GetThreadCounters()
 	{
-		if (s_Data)
-			return;
+		if (!s_ThreadCounters)
+		{
+			// We may be inside operator new here, so the counters come straight from malloc. They are never
+			// released so that allocations made by threads that have since exited stay in the totals.
+			ThreadAllocationCounters* counters = (ThreadAllocationCounters*)Allocator::AllocateRaw(sizeof(ThreadAllocationCounters));
+			new(counters) ThreadAllocationCounters();
 
-		s_InInit = true;
-		AllocatorData* data = (AllocatorData*)Allocator::AllocateRaw(sizeof(AllocatorData));
-		new(data) AllocatorData();
-		s_Data = data;
-		s_InInit = false;
+			counters->Next = s_ThreadCountersHead.load(std::memory_order_relaxed);
+			while (!s_ThreadCountersHead.compare_exchange_weak(counters->Next, counters, std::memory_order_release, std::memory_order_relaxed));
+
+			s_ThreadCounters = counters;
+		}
+
+		return *s_ThreadCounters;
 	}
 
-	void* Allocator::AllocateRaw(size_t size)
+	static void IncrementCounter(std::atomic<size_t>& counter, size_t value)
 	{
-		return malloc(size);
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
 	}
 
-	void* Allocator::Allocate(size_t size)
+	static void* AllocateWithHeader(size_t size, const char* category)
 	{
-		if (s_InInit)
-			return AllocateRaw(size);
+		AllocationHeader* header = (AllocationHeader*)malloc(sizeof(AllocationHeader) + size);
+		if (!header)
+			return nullptr;
 
-		if (!s_Data)
-			Init();
+		header->Size = size;
+		header->Category = category;
 
-		void* memory = malloc(size);
+		IncrementCounter(GetThreadCounters().TotalAllocated, size);
 
-		{
-			std::scoped_lock<std::mutex> lock(s_Data->m_Mutex);
-			Allocation& alloc = s_Data->m_AllocationMap[memory];
-			alloc.Memory = memory;
-			alloc.Size = size;
-		
-			s_GlobalStats.TotalAllocated += size;
-		}
+		void* memory = header + 1;
 
 #if LM_ENABLE_PROFILING
 		TracyAlloc(memory, size);
@@ -58,29 +77,39 @@ namespace Luma {
 		return memory;
 	}
 
+	void Allocator::Init()
+	{
+		if (s_Data)
+			return;
+
+		AllocatorData* data = (AllocatorData*)Allocator::AllocateRaw(sizeof(AllocatorData));
+		new(data) AllocatorData();
+		s_Data = data;
+	}
+
+	void* Allocator::AllocateRaw(size_t size)
+	{
+		return malloc(size);
+	}
+
+	void* Allocator::Allocate(size_t size)
+	{
+		return AllocateWithHeader(size, nullptr);
+	}
+
 	void* Allocator::Allocate(size_t size, const char* desc)
 	{
 		if (!s_Data)
 			Init();
 
-		void* memory = malloc(size);
+		void* memory = AllocateWithHeader(size, desc);
 
+		if (desc)
 		{
-			std::scoped_lock<std::mutex> lock(s_Data->m_Mutex);
-			Allocation& alloc = s_Data->m_AllocationMap[memory];
-			alloc.Memory = memory;
-			alloc.Size = size;
-			alloc.Category = desc;
-
-			s_GlobalStats.TotalAllocated += size;
-			if (desc)
-				s_Data->m_AllocationStatsMap[desc].TotalAllocated += size;
+			std::scoped_lock<std::mutex> lock(s_Data->m_StatsMutex);
+			s_Data->m_AllocationStatsMap[desc].TotalAllocated += size;
 		}
 
-#if LM_ENABLE_PROFILING
-		TracyAlloc(memory, size);
-#endif
-
 		return memory;
 	}
 
@@ -89,23 +118,13 @@ namespace Luma {
 		if (!s_Data)
 			Init();
 
-		void* memory = malloc(size);
+		void* memory = AllocateWithHeader(size, file);
 
 		{
-			std::scoped_lock<std::mutex> lock(s_Data->m_Mutex);
-			Allocation& alloc = s_Data->m_AllocationMap[memory];
-			alloc.Memory = memory;
-			alloc.Size = size;
-			alloc.Category = file;
-
-			s_GlobalStats.TotalAllocated += size;
+			std::scoped_lock<std::mutex> lock(s_Data->m_StatsMutex);
 			s_Data->m_AllocationStatsMap[file].TotalAllocated += size;
 		}
 
-#if LM_ENABLE_PROFILING
-		TracyAlloc(memory, size);
-#endif
-
 		return memory;
 	}
 
@@ -114,39 +133,47 @@ namespace Luma {
 		if (memory == nullptr)
 			return;
 
+		AllocationHeader* header = (AllocationHeader*)memory - 1;
+
+		IncrementCounter(GetThreadCounters().TotalFreed, header->Size);
+
+		if (header->Category)
 		{
-			bool found = false;
-			{
-				std::scoped_lock<std::mutex> lock(s_Data->m_Mutex);
-				auto allocMapIt = s_Data->m_AllocationMap.find(memory);
-				found = allocMapIt != s_Data->m_AllocationMap.end();
-				if (found)
-				{
-					const Allocation& alloc = allocMapIt->second;
-					s_GlobalStats.TotalFreed += alloc.Size;
-					if (alloc.Category)
-						s_Data->m_AllocationStatsMap[alloc.Category].TotalFreed += alloc.Size;
-
-					s_Data->m_AllocationMap.erase(memory);
-				}
-			}
+			std::scoped_lock<std::mutex> lock(s_Data->m_StatsMutex);
+			s_Data->m_AllocationStatsMap[header->Category].TotalFreed += header->Size;
+		}
 
 #if LM_ENABLE_PROFILING
-			TracyFree(memory);
+		TracyFree(memory);
 #endif
 
-#ifndef LM_DIST
-			if (!found)
-				LM_CORE_WARN_TAG("Memory", "Memory block {0} not present in alloc map", memory);
-#endif
-		}
+		free(header);
+	}
 
-		free(memory);
+	size_t Allocator::GetAllocationSize(const void* memory)
+	{
+		if (memory == nullptr)
+			return 0;
+
+		return ((const AllocationHeader*)memory - 1)->Size;
 	}
 
 	namespace Memory {
 
-		const AllocationStats& GetAllocationStats() { return s_GlobalStats; }
+		AllocationStats GetAllocationStats()
+		{
+			AllocationStats stats;
+			for (ThreadAllocationCounters* counters = s_ThreadCountersHead.load(std::memory_order_acquire); counters; counters = counters->Next)
+			{
+				stats.TotalAllocated += counters->TotalAllocated.load(std::memory_order_relaxed);
+				stats.TotalFreed += counters->TotalFreed.load(std::memory_order_relaxed);
+			}
+
+			PoolAllocatorStats poolStats = PoolAllocator::GetStats();
+			stats.PoolReserved = poolStats.ReservedSize;
+			stats.PoolUsed = poolStats.UsedSize;
+			return stats;
+		}
 	}
 }
 
@@ -218,4 +245,106 @@ void __CRTDECL operator delete[](void* memory, const char* file, int line)
 	return Luma::Allocator::Free(memory);
 }
 
-#endif
\ No newline at end of file
+#endif
+
+#if defined(LM_TRACK_MEMORY) && defined(LM_PLATFORM_LINUX)
+
+static void* CheckedAllocation(void* memory)
+{
+	if (!memory)
+		throw std::bad_alloc();
+
+	return memory;
+}
+
+void* operator new(size_t size)
+{
+	return CheckedAllocation(Luma::Allocator::Allocate(size));
+}
+
+void* operator new[](size_t size)
+{
+	return CheckedAllocation(Luma::Allocator::Allocate(size));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return Luma::Allocator::Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return Luma::Allocator::Allocate(size);
+}
+
+void* operator new(size_t size, const char* desc)
+{
+	return CheckedAllocation(Luma::Allocator::Allocate(size, desc));
+}
+
+void* operator new[](size_t size, const char* desc)
+{
+	return CheckedAllocation(Luma::Allocator::Allocate(size, desc));
+}
+
+void* operator new(size_t size, const char* file, int line)
+{
+	return CheckedAllocation(Luma::Allocator::Allocate(size, file, line));
+}
+
+void* operator new[](size_t size, const char* file, int line)
+{
+	return CheckedAllocation(Luma::Allocator::Allocate(size, file, line));
+}
+
+void operator delete(void* memory) noexcept
+{
+	Luma::Allocator::Free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	Luma::Allocator::Free(memory);
+}
+
+void operator delete(void* memory, size_t size) noexcept
+{
+	Luma::Allocator::Free(memory);
+}
+
+void operator delete[](void* memory, size_t size) noexcept
+{
+	Luma::Allocator::Free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	Luma::Allocator::Free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+	Luma::Allocator::Free(memory);
+}
+
+void operator delete(void* memory, const char* desc) noexcept
+{
+	Luma::Allocator::Free(memory);
+}
+
+void operator delete(void* memory, const char* file, int line) noexcept
+{
+	Luma::Allocator::Free(memory);
+}
+
+void operator delete[](void* memory, const char* desc) noexcept
+{
+	Luma::Allocator::Free(memory);
+}
+
+void operator delete[](void* memory, const char* file, int line) noexcept
+{
+	Luma::Allocator::Free(memory);
+}
+
+#endif
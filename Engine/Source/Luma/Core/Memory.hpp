@@ -5,6 +5,7 @@
 #include <limits>
 #include <map>
 #include <mutex>
+#include <new>
 #include <utility>
 
 namespace Luma {
@@ -13,18 +14,16 @@ namespace Luma {
 	{
 		size_t TotalAllocated = 0;
 		size_t TotalFreed = 0;
-	};
 
-	struct Allocation
-	{
-		void* Memory = 0;
-		size_t Size = 0;
-		const char* Category = 0;
+		// Occupancy of the PoolAllocator size classes. The chunks themselves are included in the totals above
+		size_t PoolReserved = 0;
+		size_t PoolUsed = 0;
 	};
 
 	namespace Memory
 	{
-		const AllocationStats& GetAllocationStats();
+		// Sums the per-thread counters of every thread that has allocated through Allocator
+		AllocationStats GetAllocationStats();
 	}
 
 	template <class T>
@@ -55,15 +54,13 @@ namespace Luma {
 
 	struct AllocatorData
 	{
-		using MapAlloc = Mallocator<std::pair<const void* const, Allocation>>;
 		using StatsMapAlloc = Mallocator<std::pair<const char* const, AllocationStats>>;
 
 		using AllocationStatsMap = std::map<const char*, AllocationStats, std::less<const char*>, StatsMapAlloc>;
 
-		std::map<const void*, Allocation, std::less<const void*>, MapAlloc> m_AllocationMap;
 		AllocationStatsMap m_AllocationStatsMap;
 
-		std::mutex m_Mutex, m_StatsMutex;
+		std::mutex m_StatsMutex;
 	};
 
 
@@ -79,6 +76,9 @@ namespace Luma {
 		static void* Allocate(size_t size, const char* file, int line);
 		static void Free(void* memory);
 
+		// Size requested for a block returned by Allocate
+		static size_t GetAllocationSize(const void* memory);
+
 		static const AllocatorData::AllocationStatsMap& GetAllocationStats() { return s_Data->m_AllocationStatsMap; }
 	private:
 		inline static AllocatorData* s_Data = nullptr;
@@ -127,8 +127,30 @@ void __CRTDECL operator delete[](void* memory, const char* file, int line);
 #define lnew new(__FILE__, __LINE__)
 #define ldelete delete
 
+#elif defined(LM_PLATFORM_LINUX)
+
+// The global operator new/delete are replaced in Memory.cpp, only the tagged overloads need declaring
+
+[[nodiscard]] inline void* operator new(size_t size, char* placementNewPtr) noexcept { return placementNewPtr; }
+[[nodiscard]] inline void* operator new[](size_t size, char* placementNewPtr) noexcept { return placementNewPtr; }
+
+[[nodiscard]] void* operator new(size_t size, const char* desc);
+[[nodiscard]] void* operator new[](size_t size, const char* desc);
+[[nodiscard]] void* operator new(size_t size, const char* file, int line);
+[[nodiscard]] void* operator new[](size_t size, const char* file, int line);
+
+inline void operator delete(void* memory, char* placementNewPtr) noexcept {}
+void operator delete(void* memory, const char* desc) noexcept;
+void operator delete(void* memory, const char* file, int line) noexcept;
+inline void operator delete[](void* memory, char* placementNewPtr) noexcept {}
+void operator delete[](void* memory, const char* desc) noexcept;
+void operator delete[](void* memory, const char* file, int line) noexcept;
+
+#define lnew new(__FILE__, __LINE__)
+#define ldelete delete
+
 #else
-#warning "Memory tracking not available on non-Windows platform"
+
 #define lnew new
 #define ldelete delete
 
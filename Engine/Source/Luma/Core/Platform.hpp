@@ -4,6 +4,12 @@
 
 namespace Luma {
 
+	struct CPUTopology
+	{
+		uint32_t PhysicalCores = 1;
+		uint32_t LogicalProcessors = 1;
+	};
+
 	class Platform
 	{
 	public:
@@ -14,6 +20,9 @@ namespace Luma {
 
 		static double GetTime();
 
+		// Cores and hardware threads available to this process
+		static CPUTopology GetCPUTopology();
+
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "lmpch.hpp"
+#include "PoolAllocator.hpp"
+
+#include "Memory.hpp"
+
+#include <mutex>
+
+namespace Luma {
+
+	static constexpr size_t s_PoolChunkSize = 64 * 1024;
+
+	struct PoolFreeBlock
+	{
+		PoolFreeBlock* Next;
+	};
+
+	struct SizeClassPool
+	{
+		std::mutex Mutex;
+		PoolFreeBlock* FreeList = nullptr;
+		size_t ReservedBlocks = 0;
+		size_t UsedBlocks = 0;
+	};
+
+	static SizeClassPool s_Pools[PoolAllocator::SizeClassCount];
+
+	static void AllocateChunk(SizeClassPool& pool, size_t blockSize)
+	{
+		uint8_t* chunk = (uint8_t*)Allocator::Allocate(s_PoolChunkSize, "PoolAllocator");
+
+		const size_t blockCount = s_PoolChunkSize / blockSize;
+		for (size_t i = blockCount; i > 0; i--)
+		{
+			PoolFreeBlock* block = (PoolFreeBlock*)(chunk + (i - 1) * blockSize);
+			block->Next = pool.FreeList;
+			pool.FreeList = block;
+		}
+
+		pool.ReservedBlocks += blockCount;
+	}
+
+	void* PoolAllocator::Allocate(uint32_t sizeClass)
+	{
+		LM_CORE_ASSERT(sizeClass < SizeClassCount);
+		SizeClassPool& pool = s_Pools[sizeClass];
+
+		std::scoped_lock<std::mutex> lock(pool.Mutex);
+		if (!pool.FreeList)
+			AllocateChunk(pool, GetBlockSize(sizeClass));
+
+		PoolFreeBlock* block = pool.FreeList;
+		pool.FreeList = block->Next;
+		pool.UsedBlocks++;
+		return block;
+	}
+
+	void PoolAllocator::Free(void* memory, uint32_t sizeClass)
+	{
+		if (!memory)
+			return;
+
+		LM_CORE_ASSERT(sizeClass < SizeClassCount);
+		SizeClassPool& pool = s_Pools[sizeClass];
+
+		std::scoped_lock<std::mutex> lock(pool.Mutex);
+		PoolFreeBlock* block = (PoolFreeBlock*)memory;
+		block->Next = pool.FreeList;
+		pool.FreeList = block;
+		pool.UsedBlocks--;
+	}
+
+	PoolAllocatorStats PoolAllocator::GetStats()
+	{
+		PoolAllocatorStats stats;
+		for (uint32_t sizeClass = 0; sizeClass < SizeClassCount; sizeClass++)
+		{
+			SizeClassPool& pool = s_Pools[sizeClass];
+			std::scoped_lock<std::mutex> lock(pool.Mutex);
+
+			stats.ReservedSize += pool.ReservedBlocks * GetBlockSize(sizeClass);
+			stats.UsedSize += pool.UsedBlocks * GetBlockSize(sizeClass);
+			stats.UsedBlocks += (uint32_t)pool.UsedBlocks;
+		}
+		return stats;
+	}
+
+}
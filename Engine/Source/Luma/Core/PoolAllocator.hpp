@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Luma {
+
+	struct PoolAllocatorStats
+	{
+		size_t ReservedSize = 0;
+		size_t UsedSize = 0;
+		uint32_t UsedBlocks = 0;
+	};
+
+	// Fixed size-class pools for small, frequently created objects. Blocks are carved out of
+	// 64KB chunks and recycled through a per size class free list, chunks are never released.
+	class PoolAllocator
+	{
+	public:
+		static constexpr uint32_t SizeClassCount = 6;
+		static constexpr size_t MinBlockSize = 64;
+		static constexpr size_t MaxBlockSize = MinBlockSize << (SizeClassCount - 1);
+		static constexpr size_t BlockAlignment = alignof(std::max_align_t);
+
+		static constexpr bool CanAllocate(size_t size, size_t alignment)
+		{
+			return size <= MaxBlockSize && alignment <= BlockAlignment;
+		}
+
+		static constexpr uint32_t GetSizeClass(size_t size)
+		{
+			uint32_t sizeClass = 0;
+			while ((MinBlockSize << sizeClass) < size)
+				sizeClass++;
+			return sizeClass;
+		}
+
+		static constexpr size_t GetBlockSize(uint32_t sizeClass) { return MinBlockSize << sizeClass; }
+
+		static void* Allocate(uint32_t sizeClass);
+		static void Free(void* memory, uint32_t sizeClass);
+
+		static PoolAllocatorStats GetStats();
+	};
+
+}
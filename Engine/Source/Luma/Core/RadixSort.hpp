@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace Luma {
+
+	// Stable LSD radix sort by the 64-bit key getKey(element) returns, one byte per pass.
+	// Passes in which every key has the same byte are skipped, so keys that only differ in a
+	// few bytes take a few passes. scratch must hold count elements, the result ends up in data.
+	template<typename T, typename KeyFn>
+	void RadixSort(T* data, T* scratch, uint32_t count, KeyFn&& getKey)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "RadixSort moves elements with memcpy");
+
+		if (count < 2)
+			return;
+
+		uint32_t histograms[8][256] = {};
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint64_t key = getKey(data[i]);
+			for (uint32_t pass = 0; pass < 8; pass++)
+				histograms[pass][(key >> (pass * 8)) & 0xff]++;
+		}
+
+		T* source = data;
+		T* destination = scratch;
+		for (uint32_t pass = 0; pass < 8; pass++)
+		{
+			const uint32_t shift = pass * 8;
+			uint32_t* histogram = histograms[pass];
+			if (histogram[(getKey(source[0]) >> shift) & 0xff] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t digit = 0; digit < 256; digit++)
+			{
+				uint32_t digitCount = histogram[digit];
+				histogram[digit] = offset;
+				offset += digitCount;
+			}
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				uint64_t key = getKey(source[i]);
+				destination[histogram[(key >> shift) & 0xff]++] = source[i];
+			}
+			std::swap(source, destination);
+		}
+
+		if (source != data)
+			memcpy(data, source, sizeof(T) * count);
+	}
+
+}
@@ -0,0 +1,82 @@
+#include "lmpch.hpp"
+#include "RangeAllocator.hpp"
+
+namespace Luma {
+
+	RangeAllocator::RangeAllocator(uint32_t capacity)
+	{
+		Grow(capacity);
+	}
+
+	uint32_t RangeAllocator::Allocate(uint32_t size)
+	{
+		LM_CORE_ASSERT(size > 0, "Can't allocate an empty range!");
+
+		for (size_t i = 0; i < m_FreeRanges.size(); i++)
+		{
+			Range& range = m_FreeRanges[i];
+			if (range.Size < size)
+				continue;
+
+			const uint32_t offset = range.Offset;
+			range.Offset += size;
+			range.Size -= size;
+			if (range.Size == 0)
+				m_FreeRanges.erase(m_FreeRanges.begin() + i);
+
+			m_UsedSize += size;
+			return offset;
+		}
+
+		return InvalidOffset;
+	}
+
+	void RangeAllocator::Free(uint32_t offset, uint32_t size)
+	{
+		LM_CORE_ASSERT(size > 0 && offset + size <= m_Capacity, "Range is out of bounds!");
+
+		auto next = std::lower_bound(m_FreeRanges.begin(), m_FreeRanges.end(), offset, [](const Range& range, uint32_t offset)
+		{
+			return range.Offset < offset;
+		});
+		LM_CORE_ASSERT(next == m_FreeRanges.end() || offset + size <= next->Offset, "Range is already free!");
+
+		m_UsedSize -= size;
+
+		const bool mergePrevious = next != m_FreeRanges.begin() && (next - 1)->Offset + (next - 1)->Size == offset;
+		const bool mergeNext = next != m_FreeRanges.end() && offset + size == next->Offset;
+		if (mergePrevious && mergeNext)
+		{
+			(next - 1)->Size += size + next->Size;
+			m_FreeRanges.erase(next);
+		}
+		else if (mergePrevious)
+		{
+			(next - 1)->Size += size;
+		}
+		else if (mergeNext)
+		{
+			next->Offset = offset;
+			next->Size += size;
+		}
+		else
+		{
+			m_FreeRanges.insert(next, { offset, size });
+		}
+	}
+
+	void RangeAllocator::Grow(uint32_t newCapacity)
+	{
+		if (newCapacity <= m_Capacity)
+			return;
+
+		const uint32_t added = newCapacity - m_Capacity;
+		if (!m_FreeRanges.empty() && m_FreeRanges.back().Offset + m_FreeRanges.back().Size == m_Capacity)
+			m_FreeRanges.back().Size += added;
+		else
+			m_FreeRanges.push_back({ m_Capacity, added });
+
+		m_Capacity = newCapacity;
+	}
+
+}
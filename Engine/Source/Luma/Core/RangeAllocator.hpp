@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Luma {
+
+	// First-fit allocator for ranges of a resource that is addressed by offset, such as a GPU buffer.
+	// It only does the bookkeeping, offsets and sizes are in whatever unit the owner uses.
+	// Freed ranges are merged with their free neighbours.
+	class RangeAllocator
+	{
+	public:
+		static constexpr uint32_t InvalidOffset = 0xffffffff;
+
+		RangeAllocator(uint32_t capacity = 0);
+
+		// Returns InvalidOffset if no free range can hold size
+		uint32_t Allocate(uint32_t size);
+		void Free(uint32_t offset, uint32_t size);
+		// Adds [capacity, newCapacity) to the free space
+		void Grow(uint32_t newCapacity);
+
+		uint32_t GetCapacity() const { return m_Capacity; }
+		uint32_t GetUsedSize() const { return m_UsedSize; }
+		uint32_t GetFreeRangeCount() const { return (uint32_t)m_FreeRanges.size(); }
+	private:
+		struct Range
+		{
+			uint32_t Offset;
+			uint32_t Size;
+		};
+		// Sorted by offset, two free ranges never touch
+		std::vector<Range> m_FreeRanges;
+		uint32_t m_Capacity = 0;
+		uint32_t m_UsedSize = 0;
+	};
+
+}
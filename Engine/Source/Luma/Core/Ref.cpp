@@ -4,32 +4,54 @@
 
 namespace Luma {
 
-	static std::unordered_set<void*> s_LiveReferences;
-	static std::mutex s_LiveReferenceMutex;
+	// Instances are registered when they receive their first reference and removed when they are destroyed,
+	// so copying a Ref never reaches the registry. The registry is sharded by address so that threads
+	// creating and destroying unrelated objects do not serialise on a single lock.
+	static constexpr uint32_t s_LiveReferenceShardCount = 64;
+
+	struct alignas(64) LiveReferenceShard
+	{
+		std::mutex Mutex;
+		std::unordered_set<const RefCounted*> Instances;
+	};
+
+	static std::array<LiveReferenceShard, s_LiveReferenceShardCount> s_LiveReferenceShards;
+
+	static LiveReferenceShard& GetLiveReferenceShard(const RefCounted* instance)
+	{
+		// Heap blocks are at least 16 byte aligned, drop the low bits before mixing
+		uintptr_t address = (uintptr_t)instance >> 4;
+		address ^= address >> 6;
+		return s_LiveReferenceShards[address % s_LiveReferenceShardCount];
+	}
 
 	namespace RefUtils {
 
-		void AddToLiveReferences(void* instance)
+		void AddToLiveReferences(const RefCounted* instance)
 		{
-			std::scoped_lock<std::mutex> lock(s_LiveReferenceMutex);
 			LM_CORE_ASSERT(instance);
-			s_LiveReferences.insert(instance);
+			LiveReferenceShard& shard = GetLiveReferenceShard(instance);
+			std::scoped_lock<std::mutex> lock(shard.Mutex);
+			shard.Instances.insert(instance);
 		}
 
-		void RemoveFromLiveReferences(void* instance)
+		void RemoveFromLiveReferences(const RefCounted* instance)
 		{
-			std::scoped_lock<std::mutex> lock(s_LiveReferenceMutex);
 			LM_CORE_ASSERT(instance);
-			LM_CORE_ASSERT(s_LiveReferences.find(instance) != s_LiveReferences.end());
-			s_LiveReferences.erase(instance);
+			LiveReferenceShard& shard = GetLiveReferenceShard(instance);
+			std::scoped_lock<std::mutex> lock(shard.Mutex);
+			LM_CORE_ASSERT(shard.Instances.find(instance) != shard.Instances.end());
+			shard.Instances.erase(instance);
 		}
 
-		bool IsLive(void* instance)
+		bool IsLive(const RefCounted* instance)
 		{
 			LM_CORE_ASSERT(instance);
-			return s_LiveReferences.find(instance) != s_LiveReferences.end();
+			LiveReferenceShard& shard = GetLiveReferenceShard(instance);
+			std::scoped_lock<std::mutex> lock(shard.Mutex);
+			return shard.Instances.find(instance) != shard.Instances.end();
 		}
 	}
 
 
-}
\ No newline at end of file
+}
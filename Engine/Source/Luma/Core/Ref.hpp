@@ -1,10 +1,13 @@
 #pragma once
 
 #include "Memory.hpp"
+#include "PoolAllocator.hpp"
 
 #include <atomic>
 #include <cstddef>
+#include <memory>
 #include <type_traits>
+#include <typeinfo>
 
 namespace Luma {
 
@@ -13,24 +16,41 @@ namespace Luma {
 	public:
 		virtual ~RefCounted() = default;
 
-		void IncRefCount() const
+		uint32_t IncRefCount() const
 		{
-			++m_RefCount;
+			return ++m_RefCount;
 		}
-		void DecRefCount() const
+		uint32_t DecRefCount() const
 		{
-			--m_RefCount;
+			return --m_RefCount;
 		}
 
 		uint32_t GetRefCount() const { return m_RefCount.load(); }
 	private:
 		mutable std::atomic<uint32_t> m_RefCount = 0;
+
+		// PoolAllocator size class + 1, or 0 if the object was not allocated from a pool
+		uint32_t m_PoolSizeClass = 0;
+
+		template<class T>
+		friend class Ref;
+	};
+
+	// Specialise (see LM_POOLED_REF) for types that are created and destroyed often, so that
+	// Ref<T>::Create allocates them from PoolAllocator instead of the heap
+	template<typename T>
+	struct RefAllocationTraits
+	{
+		static constexpr bool Pooled = false;
 	};
 
+#define LM_POOLED_REF(T) template<> struct RefAllocationTraits<T> { static constexpr bool Pooled = true; }
+
+	// Keyed on the RefCounted subobject, its address is the same whichever Ref<T> adds, removes or looks up the instance
 	namespace RefUtils {
-		void AddToLiveReferences(void* instance);
-		void RemoveFromLiveReferences(void* instance);
-		bool IsLive(void* instance);
+		void AddToLiveReferences(const RefCounted* instance);
+		void RemoveFromLiveReferences(const RefCounted* instance);
+		bool IsLive(const RefCounted* instance);
 	}
 
 	template<typename T>
@@ -155,7 +175,15 @@ namespace Luma {
 		template<typename... Args>
 		static Ref<T> Create(Args&&... args)
 		{
-#if LM_TRACK_MEMORY && defined(LM_PLATFORM_WINDOWS)
+			if constexpr (RefAllocationTraits<T>::Pooled && PoolAllocator::CanAllocate(sizeof(T), alignof(T)))
+			{
+				constexpr uint32_t sizeClass = PoolAllocator::GetSizeClass(sizeof(T));
+				T* instance = new(PoolAllocator::Allocate(sizeClass)) T(std::forward<Args>(args)...);
+				instance->m_PoolSizeClass = sizeClass + 1;
+				return Ref<T>(instance);
+			}
+
+#if LM_TRACK_MEMORY
 			return Ref<T>(new(typeid(T).name()) T(std::forward<Args>(args)...));
 #else
 			return Ref<T>(new T(std::forward<Args>(args)...));
@@ -184,8 +212,9 @@ namespace Luma {
 		{
 			if (m_Instance)
 			{
-				m_Instance->IncRefCount();
-				RefUtils::AddToLiveReferences((void*)m_Instance);
+				// Only the first reference registers the instance, copies never touch the live reference registry
+				if (m_Instance->IncRefCount() == 1)
+					RefUtils::AddToLiveReferences(m_Instance);
 			}
 		}
 
@@ -193,12 +222,20 @@ namespace Luma {
 		{
 			if (m_Instance)
 			{
-				m_Instance->DecRefCount();
-
-				if (m_Instance->GetRefCount() == 0)
+				if (m_Instance->DecRefCount() == 0)
 				{
-					delete m_Instance;
-					RefUtils::RemoveFromLiveReferences((void*)m_Instance);
+					RefUtils::RemoveFromLiveReferences(m_Instance);
+					if (uint32_t poolSizeClass = m_Instance->m_PoolSizeClass)
+					{
+						// m_Instance may point into a base subobject, the pool block starts at the most derived object
+						void* memory = const_cast<void*>(dynamic_cast<const void*>(m_Instance));
+						std::destroy_at(m_Instance);
+						PoolAllocator::Free(memory, poolSizeClass - 1);
+					}
+					else
+					{
+						delete m_Instance;
+					}
 					m_Instance = nullptr;
 				}
 			}
@@ -231,7 +268,8 @@ namespace Luma {
 		T& operator*() { return *m_Instance; }
 		const T& operator*() const { return *m_Instance; }
 
-		bool IsValid() const { return m_Instance ? RefUtils::IsLive(m_Instance) : false; }
+		// The instance may be destroyed, static_cast only adjusts the address where dynamic_cast would read it
+		bool IsValid() const { return m_Instance ? RefUtils::IsLive(static_cast<const RefCounted*>(m_Instance)) : false; }
 		operator bool() const { return IsValid(); }
 
 		template<typename T2>
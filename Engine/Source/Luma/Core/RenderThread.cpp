@@ -0,0 +1,104 @@
+#include "lmpch.hpp"
+#include "RenderThread.hpp"
+
+#include "Timer.hpp"
+
+#include "Luma/Renderer/Renderer.hpp"
+#include "Luma/Debug/Profiler.hpp"
+
+namespace Luma {
+
+	RenderThread::RenderThread(ThreadingPolicy policy)
+		: m_Policy(policy), m_Thread("Render Thread"), m_KickSignal("RenderThreadKick"), m_RenderCompleteSignal("RenderThreadComplete")
+	{
+	}
+
+	RenderThread::~RenderThread()
+	{
+		LM_CORE_ASSERT(!m_Running, "Render thread has to be terminated before it is destroyed!");
+	}
+
+	void RenderThread::Run()
+	{
+		m_Running = true;
+		if (m_Policy == ThreadingPolicy::SingleThreaded)
+			return;
+
+		// The context can only be current on one thread at a time
+		Renderer::GetContext()->ReleaseCurrent();
+		m_Thread.Dispatch(Loop, this);
+	}
+
+	void RenderThread::Terminate()
+	{
+		if (!m_Running)
+			return;
+
+		BlockUntilRenderComplete();
+		Kick();
+
+		if (m_Policy == ThreadingPolicy::MultiThreaded)
+		{
+			BlockUntilRenderComplete();
+			m_Running = false;
+			m_KickSignal.Signal();
+			m_Thread.Join();
+
+			Renderer::GetContext()->MakeCurrent();
+		}
+
+		m_Running = false;
+	}
+
+	void RenderThread::BlockUntilRenderComplete()
+	{
+		if (!m_KickPending)
+			return;
+
+		m_RenderCompleteSignal.Wait();
+		m_KickPending = false;
+	}
+
+	void RenderThread::Kick()
+	{
+		LM_CORE_ASSERT(!m_KickPending, "The previous frame is still being rendered!");
+
+		if (m_Policy == ThreadingPolicy::SingleThreaded)
+		{
+			Timer workTimer;
+			Renderer::WaitAndRender();
+			m_WorkTime = workTimer.ElapsedMillis();
+			return;
+		}
+
+		Renderer::SwapQueues();
+		m_KickPending = true;
+		m_KickSignal.Signal();
+	}
+
+	void RenderThread::Loop(RenderThread* renderThread)
+	{
+		LM_PROFILE_THREAD("Render Thread");
+
+		Renderer::GetContext()->MakeCurrent();
+
+		while (true)
+		{
+			Timer waitTimer;
+			renderThread->m_KickSignal.Wait();
+			if (!renderThread->m_Running)
+				break;
+
+			renderThread->m_WaitTime = waitTimer.ElapsedMillis();
+
+			Timer workTimer;
+			Renderer::ExecuteRenderQueue();
+			renderThread->m_WorkTime = workTimer.ElapsedMillis();
+
+			renderThread->m_RenderCompleteSignal.Signal();
+		}
+
+		Renderer::GetContext()->ReleaseCurrent();
+	}
+
+}
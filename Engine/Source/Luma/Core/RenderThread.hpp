@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Luma/Core/Thread.hpp"
+
+#include <atomic>
+
+namespace Luma {
+
+	enum class ThreadingPolicy
+	{
+		// Render commands are executed on the main thread at the end of the frame that recorded them
+		SingleThreaded = 0,
+		// A render thread owns the GL context and executes frame N while the main thread records frame N+1
+		MultiThreaded
+	};
+
+	class RenderThread
+	{
+	public:
+		RenderThread(ThreadingPolicy policy);
+		~RenderThread();
+
+		// Hands the GL context over to the render thread
+		void Run();
+		// Executes the commands that are still queued and gives the GL context back to the calling thread
+		void Terminate();
+		bool IsRunning() const { return m_Running; }
+
+		// Waits until the render thread has executed the last kick. Between this and the next
+		// kick neither thread touches the render command queues.
+		void BlockUntilRenderComplete();
+		// Starts executing the commands submitted since the last kick
+		void Kick();
+
+		ThreadingPolicy GetPolicy() const { return m_Policy; }
+
+		// Updated by the render thread, only read them after BlockUntilRenderComplete
+		float GetWorkTime() const { return m_WorkTime; }
+		float GetWaitTime() const { return m_WaitTime; }
+	private:
+		static void Loop(RenderThread* renderThread);
+	private:
+		ThreadingPolicy m_Policy;
+
+		Thread m_Thread;
+		ThreadSignal m_KickSignal;
+		ThreadSignal m_RenderCompleteSignal;
+		std::atomic<bool> m_Running = false;
+		bool m_KickPending = false;
+
+		float m_WorkTime = 0.0f;
+		float m_WaitTime = 0.0f;
+	};
+
+}
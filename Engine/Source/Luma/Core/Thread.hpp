@@ -31,6 +31,10 @@ namespace Luma {
 	{
 	public:
 		ThreadSignal(const std::string& name, bool manualReset = false);
+		~ThreadSignal();
+
+		ThreadSignal(const ThreadSignal&) = delete;
+		ThreadSignal& operator=(const ThreadSignal&) = delete;
 
 		void Wait();
 		void Signal();
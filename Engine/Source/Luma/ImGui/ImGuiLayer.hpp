@@ -7,6 +7,7 @@ namespace Luma {
 	class ImGuiLayer : public Layer
 	{
 	public:
+		// Main thread. End builds the frame and submits rendering its draw data.
 		virtual void Begin() = 0;
 		virtual void End() = 0;
 
@@ -0,0 +1,138 @@
+#include "lmpch.hpp"
+#include "Frustum.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define LM_FRUSTUM_SSE
+	#include <emmintrin.h>
+#endif
+
+namespace Luma {
+
+	void AABBPacket::Set(uint32_t lane, const AABB& aabb, const glm::mat4& transform)
+	{
+		glm::vec3 center = (aabb.Min + aabb.Max) * 0.5f;
+		glm::vec3 extent = (aabb.Max - aabb.Min) * 0.5f;
+
+		// The extent along each world axis is the projection of the box axes onto it
+		glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+		glm::vec3 worldExtent = glm::abs(glm::vec3(transform[0])) * extent.x
+			+ glm::abs(glm::vec3(transform[1])) * extent.y
+			+ glm::abs(glm::vec3(transform[2])) * extent.z;
+
+		CenterX[lane] = worldCenter.x;
+		CenterY[lane] = worldCenter.y;
+		CenterZ[lane] = worldCenter.z;
+		ExtentX[lane] = worldExtent.x;
+		ExtentY[lane] = worldExtent.y;
+		ExtentZ[lane] = worldExtent.z;
+	}
+
+	Frustum Frustum::FromMatrix(const glm::mat4& viewProjection)
+	{
+		// Gribb/Hartmann, rows of the matrix combined with the w row
+		glm::vec4 rowX = { viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0] };
+		glm::vec4 rowY = { viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1] };
+		glm::vec4 rowZ = { viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2] };
+		glm::vec4 rowW = { viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3] };
+
+		Frustum frustum;
+		frustum.Planes[0] = rowW + rowX;
+		frustum.Planes[1] = rowW - rowX;
+		frustum.Planes[2] = rowW + rowY;
+		frustum.Planes[3] = rowW - rowY;
+		frustum.Planes[4] = rowZ; // 0..1 depth, rowW + rowZ would be the -1..1 near plane
+		frustum.Planes[5] = rowW - rowZ;
+
+		for (glm::vec4& plane : frustum.Planes)
+			plane /= glm::length(glm::vec3(plane));
+
+		return frustum;
+	}
+
+	bool Frustum::Intersects(const AABB& aabb) const
+	{
+		glm::vec3 center = (aabb.Min + aabb.Max) * 0.5f;
+		glm::vec3 extent = (aabb.Max - aabb.Min) * 0.5f;
+
+		for (const glm::vec4& plane : Planes)
+		{
+			glm::vec3 normal = glm::vec3(plane);
+			if (glm::dot(normal, center) + glm::dot(glm::abs(normal), extent) + plane.w < 0.0f)
+				return false;
+		}
+		return true;
+	}
+
+	uint32_t Frustum::Cull(const AABBPacket* packets, uint32_t aabbCount, uint8_t* visible) const
+	{
+		uint32_t visibleCount = 0;
+		const uint32_t packetCount = (aabbCount + 3) / 4;
+
+#ifdef LM_FRUSTUM_SSE
+		__m128 planeX[6], planeY[6], planeZ[6], planeAbsX[6], planeAbsY[6], planeAbsZ[6], planeW[6];
+		for (uint32_t i = 0; i < 6; i++)
+		{
+			planeX[i] = _mm_set1_ps(Planes[i].x);
+			planeY[i] = _mm_set1_ps(Planes[i].y);
+			planeZ[i] = _mm_set1_ps(Planes[i].z);
+			planeAbsX[i] = _mm_set1_ps(std::abs(Planes[i].x));
+			planeAbsY[i] = _mm_set1_ps(std::abs(Planes[i].y));
+			planeAbsZ[i] = _mm_set1_ps(std::abs(Planes[i].z));
+			planeW[i] = _mm_set1_ps(Planes[i].w);
+		}
+
+		const __m128 zero = _mm_setzero_ps();
+		for (uint32_t p = 0; p < packetCount; p++)
+		{
+			const AABBPacket& packet = packets[p];
+			__m128 centerX = _mm_load_ps(packet.CenterX);
+			__m128 centerY = _mm_load_ps(packet.CenterY);
+			__m128 centerZ = _mm_load_ps(packet.CenterZ);
+			__m128 extentX = _mm_load_ps(packet.ExtentX);
+			__m128 extentY = _mm_load_ps(packet.ExtentY);
+			__m128 extentZ = _mm_load_ps(packet.ExtentZ);
+
+			// A box is outside once it is fully behind any plane
+			__m128 outside = zero;
+			for (uint32_t i = 0; i < 6; i++)
+			{
+				__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[i], centerX), _mm_mul_ps(planeY[i], centerY)), _mm_add_ps(_mm_mul_ps(planeZ[i], centerZ), planeW[i]));
+				__m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeAbsX[i], extentX), _mm_mul_ps(planeAbsY[i], extentY)), _mm_mul_ps(planeAbsZ[i], extentZ));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+			}
+
+			int outsideMask = _mm_movemask_ps(outside);
+			const uint32_t laneCount = std::min(4u, aabbCount - p * 4);
+			for (uint32_t lane = 0; lane < laneCount; lane++)
+			{
+				uint8_t isVisible = ((outsideMask >> lane) & 1) == 0;
+				visible[p * 4 + lane] = isVisible;
+				visibleCount += isVisible;
+			}
+		}
+#else
+		for (uint32_t p = 0; p < packetCount; p++)
+		{
+			const AABBPacket& packet = packets[p];
+			const uint32_t laneCount = std::min(4u, aabbCount - p * 4);
+			for (uint32_t lane = 0; lane < laneCount; lane++)
+			{
+				bool outside = false;
+				for (uint32_t i = 0; i < 6 && !outside; i++)
+				{
+					const glm::vec4& plane = Planes[i];
+					float distance = plane.x * packet.CenterX[lane] + plane.y * packet.CenterY[lane] + plane.z * packet.CenterZ[lane] + plane.w;
+					float radius = std::abs(plane.x) * packet.ExtentX[lane] + std::abs(plane.y) * packet.ExtentY[lane] + std::abs(plane.z) * packet.ExtentZ[lane];
+					outside = distance + radius < 0.0f;
+				}
+
+				visible[p * 4 + lane] = !outside;
+				visibleCount += !outside;
+			}
+		}
+#endif
+
+		return visibleCount;
+	}
+
+}
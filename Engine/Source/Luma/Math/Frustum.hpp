@@ -0,0 +1,39 @@
+#pragma once
+
+#include "AABB.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+namespace Luma {
+
+	// Four boxes as centers and half extents in structure-of-arrays layout, so that
+	// a frustum plane is tested against all of them at once
+	struct alignas(16) AABBPacket
+	{
+		float CenterX[4], CenterY[4], CenterZ[4];
+		float ExtentX[4], ExtentY[4], ExtentZ[4];
+
+		// Stores aabb transformed by transform in the given lane, the result encloses the transformed box
+		void Set(uint32_t lane, const AABB& aabb, const glm::mat4& transform);
+	};
+
+	struct Frustum
+	{
+		// Left, right, bottom, top, near, far. xyz is the inward facing normal, w the distance,
+		// so points inside satisfy dot(xyz, p) + w >= 0
+		glm::vec4 Planes[6];
+
+		// Extracts the planes from a view projection matrix with 0..1 depth, as glm builds them with GLM_FORCE_DEPTH_ZERO_TO_ONE
+		static Frustum FromMatrix(const glm::mat4& viewProjection);
+
+		bool Intersects(const AABB& aabb) const;
+
+		// Tests aabbCount boxes stored in ceil(aabbCount / 4) packets, visible[i] is set to 1 for boxes that
+		// intersect the frustum and 0 otherwise. Conservative, boxes near a frustum corner may pass.
+		// Returns the number of visible boxes.
+		uint32_t Cull(const AABBPacket* packets, uint32_t aabbCount, uint8_t* visible) const;
+	};
+
+}
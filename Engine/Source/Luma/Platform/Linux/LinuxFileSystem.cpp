@@ -33,7 +33,7 @@ namespace Luma {
 		}
 	}
 
-	bool FileSystem::WriteBytes(const std::filesystem::path& filepath, const Buffer& buffer)
+	bool FileSystem::WriteBytes(const std::filesystem::path& filepath, BufferView buffer)
 	{
 		std::ofstream stream(filepath, std::ios::binary | std::ios::trunc);
 
@@ -43,13 +43,13 @@ namespace Luma {
 			return false;
 		}
 
-		stream.write((char*)buffer.Data, buffer.Size);
+		stream.write((const char*)buffer.Data, buffer.Size);
 		stream.close();
 
 		return true;
 	}
 
-	Buffer FileSystem::ReadBytes(const std::filesystem::path& filepath)
+	Buffer FileSystem::ReadBytes(const std::filesystem::path& filepath, uint64_t alignment)
 	{
 		Buffer buffer;
 
@@ -61,7 +61,7 @@ namespace Luma {
 		auto size = end - stream.tellg();
 		LM_CORE_ASSERT(size != 0);
 
-		buffer.Allocate((uint32_t)size);
+		buffer.Allocate((uint64_t)size, alignment);
 		stream.read((char*)buffer.Data, buffer.Size);
 		stream.close();
 
@@ -1,6 +1,7 @@
 #include "lmpch.hpp"
 #include "Luma/Core/Platform.hpp"
 
+#include <sched.h>
 #include <unistd.h>
 #include <sys/time.h>
 
@@ -41,4 +42,46 @@ namespace Luma {
 							- g_PlatformData.TimerOffset) / (double)g_PlatformData.TimerFrequency;
 	}
 
-}
\ No newline at end of file
+	static int ReadTopologyValue(int cpu, const char* name)
+	{
+		std::ifstream stream(std::format("/sys/devices/system/cpu/cpu{}/topology/{}", cpu, name));
+		int value = -1;
+		stream >> value;
+		return stream ? value : -1;
+	}
+
+	CPUTopology Platform::GetCPUTopology()
+	{
+		CPUTopology topology;
+		topology.LogicalProcessors = std::max(std::thread::hardware_concurrency(), 1u);
+		topology.PhysicalCores = topology.LogicalProcessors;
+
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+			return topology;
+
+		// SMT siblings share a (package, core) pair
+		std::set<std::pair<int, int>> cores;
+		uint32_t logicalProcessors = 0;
+		for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+		{
+			if (!CPU_ISSET(cpu, &cpuSet))
+				continue;
+
+			logicalProcessors++;
+			int package = ReadTopologyValue(cpu, "physical_package_id");
+			int core = ReadTopologyValue(cpu, "core_id");
+			cores.emplace(package, core < 0 ? cpu : core);
+		}
+
+		if (logicalProcessors > 0)
+		{
+			topology.LogicalProcessors = logicalProcessors;
+			topology.PhysicalCores = (uint32_t)cores.size();
+		}
+
+		return topology;
+	}
+
+}
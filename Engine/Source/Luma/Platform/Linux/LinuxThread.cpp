@@ -12,7 +12,8 @@ namespace Luma {
 
 	void Thread::SetName(const std::string& name)
 	{
-		pthread_setname_np(m_Thread.native_handle(), name.c_str());
+		// Linux limits thread names to 15 characters
+		pthread_setname_np(m_Thread.native_handle(), name.substr(0, 15).c_str());
 	}
 
 	void Thread::Join()
@@ -21,10 +22,64 @@ namespace Luma {
 			m_Thread.join();
 	}
 
-	// TODO: `ThreadSignal`
-
 	std::thread::id Thread::GetID() const
 	{
 		return m_Thread.get_id();
 	}
-}
\ No newline at end of file
+
+	struct LinuxSignal
+	{
+		std::mutex Mutex;
+		std::condition_variable Condition;
+		bool Signaled = false;
+		bool ManualReset = false;
+	};
+
+	ThreadSignal::ThreadSignal(const std::string& name, bool manualReset)
+	{
+		LinuxSignal* signal = new LinuxSignal();
+		signal->ManualReset = manualReset;
+		m_SignalHandle = signal;
+	}
+
+	ThreadSignal::~ThreadSignal()
+	{
+		delete (LinuxSignal*)m_SignalHandle;
+	}
+
+	void ThreadSignal::Wait()
+	{
+		LinuxSignal* signal = (LinuxSignal*)m_SignalHandle;
+
+		std::unique_lock<std::mutex> lock(signal->Mutex);
+		signal->Condition.wait(lock, [signal] { return signal->Signaled; });
+
+		// Auto-reset signals release a single waiter, like Win32 events
+		if (!signal->ManualReset)
+			signal->Signaled = false;
+	}
+
+	void ThreadSignal::Signal()
+	{
+		LinuxSignal* signal = (LinuxSignal*)m_SignalHandle;
+
+		{
+			std::scoped_lock<std::mutex> lock(signal->Mutex);
+			signal->Signaled = true;
+		}
+
+		if (signal->ManualReset)
+			signal->Condition.notify_all();
+		else
+			signal->Condition.notify_one();
+	}
+
+	void ThreadSignal::Reset()
+	{
+		LinuxSignal* signal = (LinuxSignal*)m_SignalHandle;
+
+		std::scoped_lock<std::mutex> lock(signal->Mutex);
+		signal->Signaled = false;
+	}
+
+}
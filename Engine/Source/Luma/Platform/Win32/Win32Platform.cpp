@@ -28,5 +28,41 @@ namespace Luma {
 		return (double)(value - g_PlatformData.TimerOffset) / g_PlatformData.TimerFrequency;
 	}
 
+	CPUTopology Platform::GetCPUTopology()
+	{
+		CPUTopology topology;
+		topology.LogicalProcessors = std::max(std::thread::hardware_concurrency(), 1u);
+		topology.PhysicalCores = topology.LogicalProcessors;
+
+		DWORD length = 0;
+		GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+		if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+			return topology;
+
+		std::vector<uint8_t> buffer(length);
+		auto* info = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)buffer.data();
+		if (!GetLogicalProcessorInformationEx(RelationProcessorCore, info, &length))
+			return topology;
+
+		uint32_t physicalCores = 0;
+		uint32_t logicalProcessors = 0;
+		for (DWORD offset = 0; offset < length; )
+		{
+			auto* core = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)(buffer.data() + offset);
+			physicalCores++;
+			for (WORD group = 0; group < core->Processor.GroupCount; group++)
+				logicalProcessors += (uint32_t)__popcnt64(core->Processor.GroupMask[group].Mask);
+
+			offset += core->Size;
+		}
+
+		if (physicalCores > 0)
+		{
+			topology.PhysicalCores = physicalCores;
+			topology.LogicalProcessors = logicalProcessors;
+		}
+
+		return topology;
+	}
 
-}
\ No newline at end of file
+}
@@ -16,7 +16,6 @@ namespace Luma {
 
 		std::wstring wName(name.begin(), name.end());
 		SetThreadDescription(threadHandle, wName.c_str());
-		SetThreadAffinityMask(threadHandle, 8);
 	}
 
 	void Thread::Join()
@@ -31,6 +30,11 @@ namespace Luma {
 		m_SignalHandle = CreateEventW(NULL, (BOOL)manualReset, FALSE, str.c_str());
 	}
 
+	ThreadSignal::~ThreadSignal()
+	{
+		CloseHandle(m_SignalHandle);
+	}
+
 	void ThreadSignal::Wait()
 	{
 		WaitForSingleObject(m_SignalHandle, INFINITE);
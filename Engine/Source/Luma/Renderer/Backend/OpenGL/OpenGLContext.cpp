@@ -49,4 +49,14 @@ namespace Luma {
 		LM_CORE_INFO_TAG("Renderer", "  Version:  {0}", reinterpret_cast<const char*>(glGetString(GL_VERSION)));
 	}
 
-}
\ No newline at end of file
+	void OpenGLContext::MakeCurrent()
+	{
+		SDL_GL_MakeCurrent(m_Window, m_GLContext);
+	}
+
+	void OpenGLContext::ReleaseCurrent()
+	{
+		SDL_GL_MakeCurrent(m_Window, nullptr);
+	}
+
+}
@@ -16,6 +16,9 @@ namespace Luma {
 
 		virtual void Init() override;
 
+		virtual void MakeCurrent() override;
+		virtual void ReleaseCurrent() override;
+
 		void SetWindow(SDL_Window* window);
 		SDL_GLContext GetNativeContext() const { return m_GLContext; }
 	private:
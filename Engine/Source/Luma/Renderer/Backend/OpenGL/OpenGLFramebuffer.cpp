@@ -1,5 +1,6 @@
 #include "lmpch.hpp"
 #include "OpenGLFramebuffer.hpp"
+#include "OpenGLState.hpp"
 
 #include "Luma/Renderer/Renderer.hpp"
 
@@ -123,6 +124,7 @@ namespace Luma {
 
 		m_Width = width;
 		m_Height = height;
+		m_Version++;
 
 		Ref<OpenGLFramebuffer> instance = this;
 		Renderer::Submit([instance]() mutable
@@ -130,6 +132,8 @@ namespace Luma {
 			if (instance->m_RendererID)
 			{
 				glDeleteFramebuffers(1, &instance->m_RendererID);
+				OpenGLState::OnTexturesDeleted(instance->m_ColorAttachments.data(), (uint32_t)instance->m_ColorAttachments.size());
+				OpenGLState::OnTexturesDeleted(&instance->m_DepthAttachment, 1);
 				glDeleteTextures(instance->m_ColorAttachments.size(), instance->m_ColorAttachments.data());
 				glDeleteTextures(1, &instance->m_DepthAttachment);
 
@@ -304,6 +308,8 @@ namespace Luma {
 			LM_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
 
 			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			// The attachments were set up through the active texture unit
+			OpenGLState::InvalidateTextureUnit(0);
 		});
 	}
 
@@ -327,7 +333,7 @@ namespace Luma {
 	{
 		Ref<const OpenGLFramebuffer> instance = this;
 		Renderer::Submit([instance, attachmentIndex, slot]() {
-			glBindTextureUnit(slot, instance->m_ColorAttachments[attachmentIndex]);
+			OpenGLState::BindTextureUnit(slot, instance->m_ColorAttachments[attachmentIndex]);
 		});
 	}
 }
\ No newline at end of file
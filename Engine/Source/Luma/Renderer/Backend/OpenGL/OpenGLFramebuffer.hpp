@@ -23,6 +23,7 @@ namespace Luma {
 		virtual RendererID GetRendererID() const { return m_RendererID; }
 		virtual RendererID GetColorAttachmentRendererID(int index = 0) const { return m_ColorAttachments[index]; }
 		virtual RendererID GetDepthAttachmentRendererID() const { return m_DepthAttachment; }
+		virtual uint32_t GetVersion() const override { return m_Version; }
 
 		virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
 	private:
@@ -36,6 +37,9 @@ namespace Luma {
 		FramebufferTextureFormat m_DepthAttachmentFormat = FramebufferTextureFormat::None;
 
 		uint32_t m_Width = 0, m_Height = 0;
+		uint32_t m_Version = 0;
 	};
 
+	LM_POOLED_REF(OpenGLFramebuffer);
+
 }
\ No newline at end of file
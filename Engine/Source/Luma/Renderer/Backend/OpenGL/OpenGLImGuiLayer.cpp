@@ -3,6 +3,7 @@
 
 #include "Luma/Core/Application.hpp"
 #include "Luma/Renderer/Renderer.hpp"
+#include "OpenGLState.hpp"
 
 #include <imgui.h>
 #include "Luma/ImGui/ImGuizmo.h"
@@ -74,7 +75,7 @@ namespace Luma {
 
 	void OpenGLImGuiLayer::Begin()
 	{
-		ImGui_ImplOpenGL3_NewFrame();
+		// The OpenGL backend creates its device objects on the first frame, that happens in End's render command
 		ImGui_ImplSDL3_NewFrame();
 		ImGui::NewFrame();
 		ImGuizmo::BeginFrame();
@@ -86,21 +87,33 @@ namespace Luma {
 		Application& app = Application::Get();
 		io.DisplaySize = ImVec2(app.GetWindow()->GetWidth(), app.GetWindow()->GetHeight());
 
-		// Render to swapchain... how do we handle this better?
-		// glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-		// Rendering
+		// The frame is built here, only the draw data goes to the render thread. It stays valid until
+		// the next Begin, which the application only calls once this frame has been rendered.
 		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
-		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+		Renderer::Submit([]()
 		{
-			SDL_Window* backup_current_window = SDL_GL_GetCurrentWindow();
-			SDL_GLContext backup_current_context = SDL_GL_GetCurrentContext();
-			ImGui::UpdatePlatformWindows();
-			ImGui::RenderPlatformWindowsDefault();
-			SDL_GL_MakeCurrent(backup_current_window, backup_current_context);
-		}
+			ImGuiIO& io = ImGui::GetIO();
+
+			// Render to swapchain... how do we handle this better?
+			// glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+			ImGui_ImplOpenGL3_NewFrame();
+			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+			if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+			{
+				SDL_Window* backup_current_window = SDL_GL_GetCurrentWindow();
+				SDL_GLContext backup_current_context = SDL_GL_GetCurrentContext();
+				ImGui::UpdatePlatformWindows();
+				ImGui::RenderPlatformWindowsDefault();
+				SDL_GL_MakeCurrent(backup_current_window, backup_current_context);
+			}
+
+			// The ImGui backend binds its own program, buffers and textures and changes blend, cull, depth,
+			// stencil and polygon state directly
+			OpenGLState::Invalidate();
+		});
 	}
 
 	void OpenGLImGuiLayer::OnImGuiRender()
@@ -1,7 +1,9 @@
 #include "lmpch.hpp"
 #include "OpenGLIndexBuffer.hpp"
+#include "OpenGLState.hpp"
 
 #include "Luma/Renderer/Renderer.hpp"
+#include "Luma/Core/FrameAllocator.hpp"
 
 #include <glad/glad.h>
 
@@ -10,20 +12,18 @@ namespace Luma {
 	OpenGLIndexBuffer::OpenGLIndexBuffer(void* data, uint32_t size)
 		: m_RendererID(0), m_Size(size)
 	{
-		m_LocalData = Buffer::Copy(data, size);
+		Ref<UploadBuffer> uploadBuffer = UploadBuffer::Copy(data, size);
 
 		Ref<OpenGLIndexBuffer> instance = this;
-		Renderer::Submit([instance]() mutable {
+		Renderer::Submit([instance, uploadBuffer]() mutable {
 			glCreateBuffers(1, &instance->m_RendererID);
-			glNamedBufferData(instance->m_RendererID, instance->m_Size, instance->m_LocalData.Data, GL_STATIC_DRAW);
+			glNamedBufferData(instance->m_RendererID, instance->m_Size, uploadBuffer->GetData(), GL_STATIC_DRAW);
 		});
 	}
 
 	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t size)
 		:	m_Size(size)
 	{
-		// m_LocalData = Buffer(size);
-
 		Ref<OpenGLIndexBuffer> instance = this;
 		Renderer::Submit([instance]() mutable {
 			glCreateBuffers(1, &instance->m_RendererID);
@@ -35,17 +35,30 @@ namespace Luma {
 	{
 		GLuint rendererID = m_RendererID;
 		Renderer::Submit([rendererID]() {
+			OpenGLState::OnBufferDeleted(rendererID);
 			glDeleteBuffers(1, &rendererID);
 		});
 	}
 
 	void OpenGLIndexBuffer::SetData(void* data, uint32_t size, uint32_t offset)
 	{
-		m_LocalData = Buffer::Copy(data, size);
+		// Staged in the frame arena, which outlives the render command that uploads it
+		void* stagingData = FrameAllocator::Allocate(size);
+		memcpy(stagingData, data, size);
+		m_Size = size;
+		Ref<OpenGLIndexBuffer> instance = this;
+		Renderer::Submit([instance, stagingData, size, offset]() {
+			glNamedBufferSubData(instance->m_RendererID, offset, size, stagingData);
+		});
+	}
+
+	void OpenGLIndexBuffer::SetData(Ref<UploadBuffer> data, uint32_t size, uint32_t offset)
+	{
+		LM_CORE_ASSERT(size <= data->GetSize(), "Upload buffer is too small!");
 		m_Size = size;
 		Ref<OpenGLIndexBuffer> instance = this;
-		Renderer::Submit([instance, offset]() {
-			glNamedBufferSubData(instance->m_RendererID, offset, instance->m_Size, instance->m_LocalData.Data);
+		Renderer::Submit([instance, data, size, offset]() {
+			glNamedBufferSubData(instance->m_RendererID, offset, size, data->GetData());
 		});
 	}
 
@@ -53,7 +66,7 @@ namespace Luma {
 	{
 		Ref<const OpenGLIndexBuffer> instance = this;
 		Renderer::Submit([instance]() {
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, instance->m_RendererID);
+			OpenGLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, instance->m_RendererID);
 		});
 	}
 
@@ -2,8 +2,6 @@
 
 #include "Luma/Renderer/IndexBuffer.hpp"
 
-#include "Luma/Core/Buffer.hpp"
-
 namespace Luma {
 
 	class OpenGLIndexBuffer : public IndexBuffer
@@ -14,6 +12,7 @@ namespace Luma {
 		virtual ~OpenGLIndexBuffer();
 
 		virtual void SetData(void* data, uint32_t size, uint32_t offset = 0);
+		virtual void SetData(Ref<UploadBuffer> data, uint32_t size, uint32_t offset = 0);
 		virtual void Bind() const;
 
 		virtual uint32_t GetCount() const { return m_Size / sizeof(uint32_t); }
@@ -23,8 +22,8 @@ namespace Luma {
 	private:
 		RendererID m_RendererID = 0;
 		uint32_t m_Size;
-
-		Buffer m_LocalData;
 	};
 
+	LM_POOLED_REF(OpenGLIndexBuffer);
+
 }
\ No newline at end of file
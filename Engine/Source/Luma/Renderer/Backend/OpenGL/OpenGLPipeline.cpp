@@ -1,5 +1,6 @@
 #include "lmpch.hpp"
 #include "OpenGLPipeline.hpp"
+#include "OpenGLState.hpp"
 
 #include "Luma/Renderer/Renderer.hpp"
 
@@ -39,6 +40,7 @@ namespace Luma {
 		GLuint rendererID = m_VertexArrayRendererID;
 		Renderer::Submit([rendererID]()
 		{
+			OpenGLState::OnVertexArrayDeleted(rendererID);
 			glDeleteVertexArrays(1, &rendererID);
 		});
 	}
@@ -53,10 +55,13 @@ namespace Luma {
 			auto& vertexArrayRendererID = instance->m_VertexArrayRendererID;
 
 			if (vertexArrayRendererID)
+			{
+				OpenGLState::OnVertexArrayDeleted(vertexArrayRendererID);
 				glDeleteVertexArrays(1, &vertexArrayRendererID);
+			}
 
 			glGenVertexArrays(1, &vertexArrayRendererID);
-			glBindVertexArray(vertexArrayRendererID);
+			OpenGLState::BindVertexArray(vertexArrayRendererID);
 
 #if 0
 			const auto& layout = instance->m_Specification.Layout;
@@ -85,7 +90,7 @@ namespace Luma {
 				attribIndex++;
 			}
 #endif
-			glBindVertexArray(0);
+			OpenGLState::BindVertexArray(0);
 		});
 	}
 
@@ -94,7 +99,7 @@ namespace Luma {
 		Ref<OpenGLPipeline> instance = this;
 		Renderer::Submit([instance]()
 		{
-			glBindVertexArray(instance->m_VertexArrayRendererID);
+			OpenGLState::BindVertexArray(instance->m_VertexArrayRendererID);
 
 			const auto& layout = instance->m_Specification.Layout;
 			uint32_t attribIndex = 0;
@@ -119,6 +124,7 @@ namespace Luma {
 						layout.GetStride(),
 						(const void*)(intptr_t)element.Offset);
 				}
+				glVertexAttribDivisor(attribIndex, instance->m_Specification.Instanced ? 1 : 0);
 				attribIndex++;
 			}
 		});
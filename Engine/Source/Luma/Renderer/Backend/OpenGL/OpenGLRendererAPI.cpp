@@ -2,6 +2,7 @@
 #include "Luma/Renderer/RendererAPI.hpp"
 
 #include "Luma/Renderer/Shader.hpp"
+#include "OpenGLState.hpp"
 
 #include <glad/glad.h>
 
@@ -35,19 +36,19 @@ namespace Luma {
 
 		uint32_t vao;
 		glGenVertexArrays(1, &vao);
-		glBindVertexArray(vao);
+		OpenGLState::BindVertexArray(vao);
 
-		glEnable(GL_DEPTH_TEST);
-		//glEnable(GL_CULL_FACE);
-		glCullFace(GL_BACK);
+		OpenGLState::SetDepthTest(true);
+		//OpenGLState::SetFaceCulling(true);
+		OpenGLState::SetCullFace(GL_BACK);
 		glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 		glFrontFace(GL_CCW);
 
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		OpenGLState::SetBlend(true);
+		OpenGLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 		glEnable(GL_MULTISAMPLE);
-		glEnable(GL_STENCIL_TEST);
+		OpenGLState::SetStencilTest(true);
 
 		auto& caps = RendererAPI::GetCapabilities();
 
@@ -89,31 +90,46 @@ namespace Luma {
 		glClearColor(r, g, b, a);
 	}
 
-	void RendererAPI::DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest, bool faceCulling)
+	static GLenum LumaToOpenGLPrimitiveType(PrimitiveType type)
 	{
-		if (!depthTest)
-			glDisable(GL_DEPTH_TEST);
-
-		GLenum glPrimitiveType = 0;
 		switch (type)
 		{
-			case PrimitiveType::Triangles:
-				glPrimitiveType = GL_TRIANGLES;
-				break;
-			case PrimitiveType::Lines:
-				glPrimitiveType = GL_LINES;
-				break;
+			case PrimitiveType::Triangles: return GL_TRIANGLES;
+			case PrimitiveType::Lines:     return GL_LINES;
 		}
+		return 0;
+	}
 
-		if (faceCulling)
-			glEnable(GL_CULL_FACE);
+	void RendererAPI::DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest, bool faceCulling, uint32_t baseVertex)
+	{
+		if (!depthTest)
+			OpenGLState::SetDepthTest(false);
+
+		GLenum glPrimitiveType = LumaToOpenGLPrimitiveType(type);
+
+		OpenGLState::SetFaceCulling(faceCulling);
+
+		if (baseVertex)
+			glDrawElementsBaseVertex(glPrimitiveType, count, GL_UNSIGNED_INT, nullptr, baseVertex);
 		else
-			glDisable(GL_CULL_FACE);
+			glDrawElements(glPrimitiveType, count, GL_UNSIGNED_INT, nullptr);
+		OpenGLState::CountDrawCall();
+
+		if (!depthTest)
+			OpenGLState::SetDepthTest(true);
+	}
+
+	void RendererAPI::DrawIndexedInstanced(uint32_t count, uint32_t instanceCount, PrimitiveType type, bool depthTest, bool faceCulling, uint32_t baseInstance)
+	{
+		if (!depthTest)
+			OpenGLState::SetDepthTest(false);
 
-		glDrawElements(glPrimitiveType, count, GL_UNSIGNED_INT, nullptr);
+		OpenGLState::SetFaceCulling(faceCulling);
+		glDrawElementsInstancedBaseInstance(LumaToOpenGLPrimitiveType(type), count, GL_UNSIGNED_INT, nullptr, instanceCount, baseInstance);
+		OpenGLState::CountDrawCall();
 
 		if (!depthTest)
-			glEnable(GL_DEPTH_TEST);
+			OpenGLState::SetDepthTest(true);
 	}
 
 	void RendererAPI::SetLineThickness(float thickness)
@@ -121,4 +137,14 @@ namespace Luma {
 		glLineWidth(thickness);
 	}
 
+	const RenderAPIStats& RendererAPI::GetStats()
+	{
+		return OpenGLState::GetFrameStats();
+	}
+
+	void RendererAPI::EndFrame()
+	{
+		OpenGLState::EndFrame();
+	}
+
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "lmpch.hpp"
 #include "OpenGLShader.hpp"
+#include "OpenGLShaderCache.hpp"
+#include "OpenGLState.hpp"
 
+#include "Luma/Core/Timer.hpp"
 #include "Luma/Renderer/Renderer.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
@@ -51,9 +54,13 @@ namespace Luma {
 		Renderer::Submit([=]()
 		{
 			if (m_RendererID)
+			{
+				OpenGLState::OnProgramDeleted(m_RendererID);
 				glDeleteProgram(m_RendererID);
+			}
 
 			CompileAndUploadShader();
+			InvalidateMaterialUniforms();
 			if (!m_IsCompute)
 			{
 				ResolveUniforms();
@@ -78,7 +85,7 @@ namespace Luma {
 	void OpenGLShader::Bind()
 	{
 		Renderer::Submit([=]() {
-			glUseProgram(m_RendererID);
+			OpenGLState::UseProgram(m_RendererID);
 		});
 	}
 
@@ -259,6 +266,7 @@ namespace Luma {
 		if (type == "sampler1D")		return true;
 		if (type == "sampler2D")		return true;
 		if (type == "sampler2DMS")		return true;
+		if (type == "sampler2DArray")	return true;
 		if (type == "samplerCube")		return true;
 		if (type == "sampler2DShadow")	return true;
 		return false;
@@ -276,6 +284,10 @@ namespace Luma {
 
 	void OpenGLShader::ParseUniform(const std::string& statement, ShaderDomain domain)
 	{
+		// Uniform blocks are backed by a UniformBuffer at their binding, they are not material uniforms
+		if (statement.find('{') != std::string::npos)
+			return;
+
 		std::vector<std::string> tokens = Tokenize(statement);
 		uint32_t index = 0;
 
@@ -386,7 +398,7 @@ namespace Luma {
 
 	void OpenGLShader::ResolveUniforms()
 	{
-		glUseProgram(m_RendererID);
+		OpenGLState::UseProgram(m_RendererID);
 
 		for (size_t i = 0; i < m_VSRendererUniformBuffers.size(); i++)
 		{
@@ -543,6 +555,16 @@ namespace Luma {
 
 	void OpenGLShader::CompileAndUploadShader()
 	{
+		Timer timer;
+
+		const uint64_t cacheKey = OpenGLShaderCache::GetKey(m_ShaderSource);
+		if (GLuint cachedProgram = OpenGLShaderCache::LoadProgram(m_AssetPath, cacheKey))
+		{
+			m_RendererID = cachedProgram;
+			OpenGLShaderCache::OnProgramCreated(true, timer.ElapsedMillis());
+			return;
+		}
+
 		std::vector<GLuint> shaderRendererIDs;
 
 		GLuint program = glCreateProgram();
@@ -580,6 +602,9 @@ namespace Luma {
 			glAttachShader(program, shaderRendererID);
 		}
 
+		if (OpenGLShaderCache::IsEnabled())
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
 		// Link our program
 		glLinkProgram(program);
 
@@ -607,31 +632,56 @@ namespace Luma {
 		for (auto id : shaderRendererIDs)
 			glDetachShader(program, id);
 
+		if (isLinked)
+			OpenGLShaderCache::StoreProgram(m_AssetPath, cacheKey, program);
+
 		m_RendererID = program;
+		OpenGLShaderCache::OnProgramCreated(false, timer.ElapsedMillis());
 	}
 
-	void OpenGLShader::SetVSMaterialUniformBuffer(Buffer buffer)
+	void OpenGLShader::SetVSMaterialUniformBuffer(const MaterialUniformUpdate& update)
 	{
-		Renderer::Submit([this, buffer]() {
-			glUseProgram(m_RendererID);
-			ResolveAndSetUniforms(m_VSMaterialUniformBuffer, buffer);
+		Renderer::Submit([this, update]() {
+			OpenGLState::UseProgram(m_RendererID);
+			ResolveAndSetUniforms(m_VSMaterialUniformBuffer, update, m_VSMaterialUniformVersion);
 		});
 	}
 
-	void OpenGLShader::SetPSMaterialUniformBuffer(Buffer buffer)
+	void OpenGLShader::SetPSMaterialUniformBuffer(const MaterialUniformUpdate& update)
 	{
-		Renderer::Submit([this, buffer]() {
-			glUseProgram(m_RendererID);
-			ResolveAndSetUniforms(m_PSMaterialUniformBuffer, buffer);
+		Renderer::Submit([this, update]() {
+			OpenGLState::UseProgram(m_RendererID);
+			ResolveAndSetUniforms(m_PSMaterialUniformBuffer, update, m_PSMaterialUniformVersion);
 		});
 	}
 
-	void OpenGLShader::ResolveAndSetUniforms(const Ref<OpenGLShaderUniformBufferDeclaration>& decl, Buffer buffer)
+	void OpenGLShader::ResolveAndSetUniforms(const Ref<OpenGLShaderUniformBufferDeclaration>& decl, const MaterialUniformUpdate& update, uint64_t& uploadedVersion)
+	{
+		// Uniforms are program state, so data the program already holds doesn't have to be sent again
+		if (update.Version != 0 && uploadedVersion == update.Version)
+		{
+			OpenGLState::CountMaterialUpload(true);
+			return;
+		}
+
+		if (update.Version != 0 && uploadedVersion == update.PreviousVersion)
+			ResolveAndSetUniforms(decl, update.Data, update.DirtyOffset, update.DirtySize);
+		else
+			ResolveAndSetUniforms(decl, update.Data, 0, (uint32_t)update.Data.Size);
+
+		uploadedVersion = update.Version;
+		OpenGLState::CountMaterialUpload(false);
+	}
+
+	void OpenGLShader::ResolveAndSetUniforms(const Ref<OpenGLShaderUniformBufferDeclaration>& decl, Buffer buffer, uint32_t offset, uint32_t size)
 	{
 		const ShaderUniformList& uniforms = decl->GetUniformDeclarations();
 		for (size_t i = 0; i < uniforms.size(); i++)
 		{
 			OpenGLShaderUniformDeclaration* uniform = (OpenGLShaderUniformDeclaration*)uniforms[i];
+			if (uniform->GetOffset() >= offset + size || uniform->GetOffset() + uniform->GetSize() <= offset)
+				continue;
+
 			if (uniform->IsArray())
 				ResolveAndSetUniformArray(uniform, buffer);
 			else
@@ -844,6 +894,7 @@ namespace Luma {
 
 	void OpenGLShader::SetMat4FromRenderThread(const std::string& name, const glm::mat4& value, bool bind)
 	{
+		InvalidateMaterialUniforms();
 		if (bind)
 		{
 			UploadUniformMat4(name, value);
@@ -922,19 +973,22 @@ namespace Luma {
 
 	void OpenGLShader::UploadUniformInt(const std::string& name, int32_t value)
 	{
+		InvalidateMaterialUniforms();
 		int32_t location = GetUniformLocation(name);
 		glUniform1i(location, value);
 	}
 
 	void OpenGLShader::UploadUniformIntArray(const std::string& name, int32_t* values, uint32_t count)
 	{
+		InvalidateMaterialUniforms();
 		int32_t location = GetUniformLocation(name);
 		glUniform1iv(location, count, values);
 	}
 
 	void OpenGLShader::UploadUniformFloat(const std::string& name, float value)
 	{
-		glUseProgram(m_RendererID);
+		OpenGLState::UseProgram(m_RendererID);
+		InvalidateMaterialUniforms();
 		auto location = glGetUniformLocation(m_RendererID, name.c_str());
 		if (location != -1)
 			glUniform1f(location, value);
@@ -944,7 +998,8 @@ namespace Luma {
 
 	void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& values)
 	{
-		glUseProgram(m_RendererID);
+		OpenGLState::UseProgram(m_RendererID);
+		InvalidateMaterialUniforms();
 		auto location = glGetUniformLocation(m_RendererID, name.c_str());
 		if (location != -1)
 			glUniform2f(location, values.x, values.y);
@@ -955,7 +1010,8 @@ namespace Luma {
 
 	void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& values)
 	{
-		glUseProgram(m_RendererID);
+		OpenGLState::UseProgram(m_RendererID);
+		InvalidateMaterialUniforms();
 		auto location = glGetUniformLocation(m_RendererID, name.c_str());
 		if (location != -1)
 			glUniform3f(location, values.x, values.y, values.z);
@@ -965,7 +1021,8 @@ namespace Luma {
 
 	void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& values)
 	{
-		glUseProgram(m_RendererID);
+		OpenGLState::UseProgram(m_RendererID);
+		InvalidateMaterialUniforms();
 		auto location = glGetUniformLocation(m_RendererID, name.c_str());
 		if (location != -1)
 			glUniform4f(location, values.x, values.y, values.z, values.w);
@@ -975,7 +1032,8 @@ namespace Luma {
 
 	void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& values)
 	{
-		glUseProgram(m_RendererID);
+		OpenGLState::UseProgram(m_RendererID);
+		InvalidateMaterialUniforms();
 		auto location = glGetUniformLocation(m_RendererID, name.c_str());
 		if (location != -1)
 			glUniformMatrix4fv(location, 1, GL_FALSE, (const float*)&values);
@@ -23,8 +23,8 @@ namespace Luma {
 
 		virtual void UploadUniformBuffer(const UniformBufferBase& uniformBuffer) override;
 
-		virtual void SetVSMaterialUniformBuffer(Buffer buffer) override;
-		virtual void SetPSMaterialUniformBuffer(Buffer buffer) override;
+		virtual void SetVSMaterialUniformBuffer(const MaterialUniformUpdate& update) override;
+		virtual void SetPSMaterialUniformBuffer(const MaterialUniformUpdate& update) override;
 
 		virtual void SetInt(const std::string& name, int value) override;
 		virtual void SetBool(const std::string& name, bool value) override;
@@ -54,7 +54,10 @@ namespace Luma {
 		void CompileAndUploadShader();
 		static GLenum ShaderTypeFromString(const std::string& type);
 
-		void ResolveAndSetUniforms(const Ref<OpenGLShaderUniformBufferDeclaration>& decl, Buffer buffer);
+		void ResolveAndSetUniforms(const Ref<OpenGLShaderUniformBufferDeclaration>& decl, const MaterialUniformUpdate& update, uint64_t& uploadedVersion);
+		void ResolveAndSetUniforms(const Ref<OpenGLShaderUniformBufferDeclaration>& decl, Buffer buffer, uint32_t offset, uint32_t size);
+		// Setting a uniform by name may overwrite a material uniform behind the tracked version
+		void InvalidateMaterialUniforms() { m_VSMaterialUniformVersion = m_PSMaterialUniformVersion = 0; }
 		void ResolveAndSetUniform(OpenGLShaderUniformDeclaration* uniform, Buffer buffer);
 		void ResolveAndSetUniformArray(OpenGLShaderUniformDeclaration* uniform, Buffer buffer);
 		void ResolveAndSetUniformField(const OpenGLShaderUniformDeclaration& field, byte* data, int32_t offset);
@@ -102,6 +105,9 @@ namespace Luma {
 		ShaderUniformBufferList m_PSRendererUniformBuffers;
 		Ref<OpenGLShaderUniformBufferDeclaration> m_VSMaterialUniformBuffer;
 		Ref<OpenGLShaderUniformBufferDeclaration> m_PSMaterialUniformBuffer;
+		// Version of the material data the program currently holds, only touched on the render thread
+		uint64_t m_VSMaterialUniformVersion = 0;
+		uint64_t m_PSMaterialUniformVersion = 0;
 		ShaderResourceList m_Resources;
 		ShaderStructList m_Structs;
 
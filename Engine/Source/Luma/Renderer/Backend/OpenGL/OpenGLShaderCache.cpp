@@ -0,0 +1,226 @@
+#include "lmpch.hpp"
+#include "OpenGLShaderCache.hpp"
+
+#include "Luma/Core/Hash.hpp"
+#include "Luma/Renderer/RendererAPI.hpp"
+#include "Luma/Utilities/FileSystem.hpp"
+
+namespace Luma {
+
+	// Bump s_CacheFileVersion whenever the file layout changes
+	static constexpr uint32_t s_CacheFileMagic = 0x43534d4c; // "LMSC"
+	static constexpr uint32_t s_CacheFileVersion = 1;
+
+	// Binaries that haven't been loaded or stored for this long are deleted by SetDirectory
+	static constexpr std::chrono::hours s_MaxUnusedAge = std::chrono::hours(24 * 30);
+
+	struct ProgramBinaryHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint64_t Key;
+		uint32_t BinaryFormat;
+		uint32_t BinarySize;
+	};
+
+	static std::filesystem::path s_Directory;
+
+	static std::mutex s_StatsMutex;
+	static ShaderProgramCacheStats s_Stats;
+
+	// Named after the shader file so a changed shader overwrites its old binary
+	static std::filesystem::path GetProgramPath(const std::string& shaderPath, uint64_t key)
+	{
+		const uint64_t name = shaderPath.empty() ? key : Hash::GenerateFNVHash64(shaderPath);
+		return s_Directory / std::format("{:016x}.bin", name);
+	}
+
+	static void PruneDirectory()
+	{
+		std::vector<std::filesystem::path> unusedFiles;
+		const auto now = std::filesystem::file_time_type::clock::now();
+
+		std::error_code error;
+		for (const auto& entry : std::filesystem::directory_iterator(s_Directory, error))
+		{
+			// Temporary files are left behind by a crash in StoreProgram
+			const std::filesystem::path& path = entry.path();
+			if (path.extension() == ".tmp")
+			{
+				unusedFiles.push_back(path);
+				continue;
+			}
+
+			const auto lastUsed = entry.last_write_time(error);
+			if (path.extension() == ".bin" && !error && now - lastUsed > s_MaxUnusedAge)
+				unusedFiles.push_back(path);
+		}
+
+		for (const auto& path : unusedFiles)
+			FileSystem::DeleteFile(path);
+
+		if (!unusedFiles.empty())
+			LM_CORE_INFO_TAG("Renderer", "Pruned {} unused files from the shader program cache", unusedFiles.size());
+	}
+
+	void OpenGLShaderCache::SetDirectory(const std::filesystem::path& directory)
+	{
+		s_Directory = directory;
+		if (s_Directory.empty())
+			return;
+
+		if (FileSystem::Exists(s_Directory))
+			PruneDirectory();
+		else
+			FileSystem::CreateDirectory(s_Directory);
+	}
+
+	bool OpenGLShaderCache::IsEnabled()
+	{
+		// Drivers without any binary format can't give us something to store
+		static const bool s_Supported = []()
+		{
+			GLint formatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+			return formatCount > 0;
+		}();
+
+		return !s_Directory.empty() && s_Supported;
+	}
+
+	uint64_t OpenGLShaderCache::GetKey(const std::unordered_map<GLenum, std::string>& sources)
+	{
+		// Binaries are only valid for the driver that produced them
+		const RenderAPICapabilities& caps = RendererAPI::GetCapabilities();
+		uint64_t key = Hash::GenerateFNVHash64(caps.Vendor);
+		key = Hash::GenerateFNVHash64(caps.Renderer, key);
+		key = Hash::GenerateFNVHash64(caps.Version, key);
+
+		// Fixed stage order, the map iterates in no particular one
+		for (GLenum stage : { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_COMPUTE_SHADER })
+		{
+			auto it = sources.find(stage);
+			if (it == sources.end())
+				continue;
+
+			key = Hash::GenerateFNVHash64(std::string_view((const char*)&stage, sizeof(stage)), key);
+			key = Hash::GenerateFNVHash64(it->second, key);
+		}
+		return key;
+	}
+
+	GLuint OpenGLShaderCache::LoadProgram(const std::string& shaderPath, uint64_t key)
+	{
+		if (!IsEnabled())
+			return 0;
+
+		const std::filesystem::path path = GetProgramPath(shaderPath, key);
+		std::error_code error;
+		const uint64_t fileSize = std::filesystem::file_size(path, error);
+		if (error)
+			return 0;
+
+		GLuint program = 0;
+		bool outdated = false;
+		if (fileSize > sizeof(ProgramBinaryHeader))
+		{
+			Buffer file = FileSystem::ReadBytes(path);
+			BufferView view = file.GetView();
+
+			const ProgramBinaryHeader& header = view.Read<ProgramBinaryHeader>();
+			if (header.Magic == s_CacheFileMagic && header.Version == s_CacheFileVersion
+				&& header.BinarySize == view.Size - sizeof(ProgramBinaryHeader))
+			{
+				// Left by an older version of the shader or another driver, StoreProgram replaces it
+				outdated = header.Key != key;
+				if (!outdated)
+				{
+					program = glCreateProgram();
+					glProgramBinary(program, header.BinaryFormat, view.As<byte>(sizeof(ProgramBinaryHeader)), header.BinarySize);
+
+					GLint isLinked = 0;
+					glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+					if (isLinked == GL_FALSE)
+					{
+						glDeleteProgram(program);
+						program = 0;
+					}
+				}
+			}
+
+			file.Release();
+		}
+
+		if (outdated)
+			return 0;
+
+		if (!program)
+		{
+			// Driver updates can invalidate binaries without changing the version string
+			LM_CORE_WARN_TAG("Renderer", "Cached shader program {} was rejected, compiling from source", path.string());
+			FileSystem::DeleteFile(path);
+
+			std::scoped_lock<std::mutex> lock(s_StatsMutex);
+			s_Stats.RejectedPrograms++;
+			return 0;
+		}
+
+		// Counts as a use, SetDirectory prunes by the write time
+		std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+		return program;
+	}
+
+	void OpenGLShaderCache::StoreProgram(const std::string& shaderPath, uint64_t key, GLuint program)
+	{
+		if (!IsEnabled())
+			return;
+
+		GLint binarySize = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+		if (binarySize <= 0)
+			return;
+
+		Buffer file;
+		file.Allocate(sizeof(ProgramBinaryHeader) + binarySize);
+
+		GLenum binaryFormat = 0;
+		GLsizei length = 0;
+		glGetProgramBinary(program, binarySize, &length, &binaryFormat, (byte*)file.Data + sizeof(ProgramBinaryHeader));
+
+		if (length > 0)
+		{
+			file.Read<ProgramBinaryHeader>() = { s_CacheFileMagic, s_CacheFileVersion, key, binaryFormat, (uint32_t)length };
+
+			// Written next to the final file and renamed, so a crash can't leave a truncated binary behind
+			const std::filesystem::path path = GetProgramPath(shaderPath, key);
+			std::filesystem::path temporaryPath = path;
+			temporaryPath += ".tmp";
+			if (FileSystem::WriteBytes(temporaryPath, BufferView(file.Data, sizeof(ProgramBinaryHeader) + length)))
+			{
+				std::error_code error;
+				std::filesystem::rename(temporaryPath, path, error);
+				if (error)
+					LM_CORE_WARN_TAG("Renderer", "Could not write shader program cache {}: {}", path.string(), error.message());
+			}
+		}
+
+		file.Release();
+	}
+
+	void OpenGLShaderCache::OnProgramCreated(bool loadedFromCache, float milliseconds)
+	{
+		std::scoped_lock<std::mutex> lock(s_StatsMutex);
+		if (loadedFromCache)
+			s_Stats.LoadedPrograms++;
+		else
+			s_Stats.CompiledPrograms++;
+		s_Stats.ProgramCreationTime += milliseconds;
+	}
+
+	ShaderProgramCacheStats OpenGLShaderCache::GetStats()
+	{
+		std::scoped_lock<std::mutex> lock(s_StatsMutex);
+		return s_Stats;
+	}
+
+}
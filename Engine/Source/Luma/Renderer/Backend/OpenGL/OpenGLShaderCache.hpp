@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Luma/Renderer/Shader.hpp"
+
+#include <glad/glad.h>
+
+#include <filesystem>
+
+namespace Luma {
+
+	// On-disk cache of linked program binaries (glGetProgramBinary). Binaries are keyed by the preprocessed
+	// sources and the driver strings, a driver that still rejects one falls back to compiling from source.
+	// Every shader file keeps a single binary that is replaced when the shader changes, shaders created from
+	// strings get one per source. Binaries that haven't been used for a month are deleted by SetDirectory.
+	class OpenGLShaderCache
+	{
+	public:
+		// An empty directory disables the cache, otherwise unused binaries in it are pruned
+		static void SetDirectory(const std::filesystem::path& directory);
+		static bool IsEnabled();
+
+		static uint64_t GetKey(const std::unordered_map<GLenum, std::string>& sources);
+
+		// Render thread. Returns a linked program or 0 when there is no usable binary for key. shaderPath
+		// is empty for shaders created from strings.
+		static GLuint LoadProgram(const std::string& shaderPath, uint64_t key);
+		// Render thread, program has to be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set
+		static void StoreProgram(const std::string& shaderPath, uint64_t key, GLuint program);
+
+		static void OnProgramCreated(bool loadedFromCache, float milliseconds);
+		static ShaderProgramCacheStats GetStats();
+	};
+
+}
@@ -112,6 +112,7 @@ namespace Luma {
 	{
 		if (type == "sampler2D")    return Type::TEXTURE2D;
 		if (type == "sampler2DMS")  return Type::TEXTURE2D;
+		if (type == "sampler2DArray") return Type::TEXTURE2DARRAY;
 		if (type == "samplerCube")  return Type::TEXTURECUBE;
 
 		return Type::NONE;
@@ -122,6 +123,7 @@ namespace Luma {
 		switch (type)
 		{
 			case Type::TEXTURE2D:	return "sampler2D";
+			case Type::TEXTURE2DARRAY:	return "sampler2DArray";
 			case Type::TEXTURECUBE:	return "samplerCube";
 		}
 		return "Invalid Type";
@@ -9,7 +9,7 @@ namespace Luma {
 	public:
 		enum class Type
 		{
-			NONE, TEXTURE2D, TEXTURECUBE
+			NONE, TEXTURE2D, TEXTURE2DARRAY, TEXTURECUBE
 		};
 	private:
 		friend class OpenGLShader;
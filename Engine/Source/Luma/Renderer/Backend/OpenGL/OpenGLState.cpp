@@ -0,0 +1,297 @@
+#include "lmpch.hpp"
+#include "OpenGLState.hpp"
+
+#include <glad/glad.h>
+
+namespace Luma {
+
+	// Cached values start out unknown so that the first call always goes through
+	static constexpr uint32_t s_Unknown = 0xffffffff;
+
+	enum class Capability : uint32_t
+	{
+		DepthTest = 0, FaceCulling, Blend, StencilTest,
+		Count
+	};
+
+	static constexpr GLenum s_CapabilityEnums[(uint32_t)Capability::Count] = { GL_DEPTH_TEST, GL_CULL_FACE, GL_BLEND, GL_STENCIL_TEST };
+
+	struct CachedState
+	{
+		RendererID Program = s_Unknown;
+		RendererID VertexArray = s_Unknown;
+		RendererID ArrayBuffer = s_Unknown;
+		RendererID ElementArrayBuffer = s_Unknown;
+		RendererID DrawIndirectBuffer = s_Unknown;
+		RendererID TextureUnits[OpenGLState::MaxTrackedTextureUnits];
+		RendererID Samplers[OpenGLState::MaxTrackedTextureUnits];
+
+		uint32_t Capabilities[(uint32_t)Capability::Count];
+		uint32_t CullFace = s_Unknown;
+		uint32_t BlendSource = s_Unknown, BlendDestination = s_Unknown;
+		uint32_t StencilFunc = s_Unknown, StencilReference = s_Unknown, StencilFuncMask = s_Unknown;
+		uint32_t StencilFail = s_Unknown, StencilDepthFail = s_Unknown, StencilDepthPass = s_Unknown;
+		uint32_t StencilMask = s_Unknown;
+		uint32_t PolygonMode = s_Unknown;
+
+		CachedState()
+		{
+			std::fill(std::begin(TextureUnits), std::end(TextureUnits), s_Unknown);
+			std::fill(std::begin(Samplers), std::end(Samplers), s_Unknown);
+			std::fill(std::begin(Capabilities), std::end(Capabilities), s_Unknown);
+		}
+	};
+
+	struct OpenGLStateData
+	{
+		CachedState Cache;
+
+		RenderAPIStats Stats;
+		RenderAPIStats FrameStats;
+	};
+
+	static OpenGLStateData s_State;
+
+	// Returns true if the value changed, otherwise counts the call as redundant
+	static bool Update(uint32_t& cached, uint32_t value, uint32_t& redundantCounter)
+	{
+		if (cached == value)
+		{
+			redundantCounter++;
+			return false;
+		}
+
+		cached = value;
+		return true;
+	}
+
+	static void SetCapability(Capability capability, bool enabled)
+	{
+		if (!Update(s_State.Cache.Capabilities[(uint32_t)capability], enabled, s_State.Stats.RedundantStateChanges))
+			return;
+
+		if (enabled)
+			glEnable(s_CapabilityEnums[(uint32_t)capability]);
+		else
+			glDisable(s_CapabilityEnums[(uint32_t)capability]);
+	}
+
+	void OpenGLState::UseProgram(RendererID program)
+	{
+		if (!Update(s_State.Cache.Program, program, s_State.Stats.RedundantBinds))
+			return;
+
+		s_State.Stats.ProgramSwitches++;
+		glUseProgram(program);
+	}
+
+	void OpenGLState::BindVertexArray(RendererID vertexArray)
+	{
+		if (!Update(s_State.Cache.VertexArray, vertexArray, s_State.Stats.RedundantBinds))
+			return;
+
+		s_State.Stats.VertexArraySwitches++;
+		glBindVertexArray(vertexArray);
+
+		// The element buffer binding is part of the vertex array
+		s_State.Cache.ElementArrayBuffer = s_Unknown;
+	}
+
+	void OpenGLState::BindBuffer(uint32_t target, RendererID buffer)
+	{
+		RendererID* cached = nullptr;
+		switch (target)
+		{
+			case GL_ARRAY_BUFFER:         cached = &s_State.Cache.ArrayBuffer; break;
+			case GL_ELEMENT_ARRAY_BUFFER: cached = &s_State.Cache.ElementArrayBuffer; break;
+			case GL_DRAW_INDIRECT_BUFFER: cached = &s_State.Cache.DrawIndirectBuffer; break;
+		}
+
+		if (cached && !Update(*cached, buffer, s_State.Stats.RedundantBinds))
+			return;
+
+		glBindBuffer(target, buffer);
+	}
+
+	void OpenGLState::BindTextureUnit(uint32_t unit, RendererID texture)
+	{
+		if (unit < MaxTrackedTextureUnits && !Update(s_State.Cache.TextureUnits[unit], texture, s_State.Stats.RedundantBinds))
+			return;
+
+		s_State.Stats.TextureSwitches++;
+		glBindTextureUnit(unit, texture);
+	}
+
+	void OpenGLState::BindSampler(uint32_t unit, RendererID sampler)
+	{
+		if (unit < MaxTrackedTextureUnits && !Update(s_State.Cache.Samplers[unit], sampler, s_State.Stats.RedundantBinds))
+			return;
+
+		glBindSampler(unit, sampler);
+	}
+
+	void OpenGLState::SetDepthTest(bool enabled)
+	{
+		SetCapability(Capability::DepthTest, enabled);
+	}
+
+	void OpenGLState::SetFaceCulling(bool enabled)
+	{
+		SetCapability(Capability::FaceCulling, enabled);
+	}
+
+	void OpenGLState::SetCullFace(uint32_t face)
+	{
+		if (Update(s_State.Cache.CullFace, face, s_State.Stats.RedundantStateChanges))
+			glCullFace(face);
+	}
+
+	void OpenGLState::SetBlend(bool enabled)
+	{
+		SetCapability(Capability::Blend, enabled);
+	}
+
+	void OpenGLState::SetBlendFunc(uint32_t source, uint32_t destination)
+	{
+		if (s_State.Cache.BlendSource == source && s_State.Cache.BlendDestination == destination)
+		{
+			s_State.Stats.RedundantStateChanges++;
+			return;
+		}
+
+		s_State.Cache.BlendSource = source;
+		s_State.Cache.BlendDestination = destination;
+		glBlendFunc(source, destination);
+	}
+
+	void OpenGLState::SetStencilTest(bool enabled)
+	{
+		SetCapability(Capability::StencilTest, enabled);
+	}
+
+	void OpenGLState::SetStencilFunc(uint32_t func, int32_t reference, uint32_t mask)
+	{
+		if (s_State.Cache.StencilFunc == func && s_State.Cache.StencilReference == (uint32_t)reference && s_State.Cache.StencilFuncMask == mask)
+		{
+			s_State.Stats.RedundantStateChanges++;
+			return;
+		}
+
+		s_State.Cache.StencilFunc = func;
+		s_State.Cache.StencilReference = (uint32_t)reference;
+		s_State.Cache.StencilFuncMask = mask;
+		glStencilFunc(func, reference, mask);
+	}
+
+	void OpenGLState::SetStencilOp(uint32_t stencilFail, uint32_t depthFail, uint32_t depthPass)
+	{
+		if (s_State.Cache.StencilFail == stencilFail && s_State.Cache.StencilDepthFail == depthFail && s_State.Cache.StencilDepthPass == depthPass)
+		{
+			s_State.Stats.RedundantStateChanges++;
+			return;
+		}
+
+		s_State.Cache.StencilFail = stencilFail;
+		s_State.Cache.StencilDepthFail = depthFail;
+		s_State.Cache.StencilDepthPass = depthPass;
+		glStencilOp(stencilFail, depthFail, depthPass);
+	}
+
+	void OpenGLState::SetStencilMask(uint32_t mask)
+	{
+		// 0xffffffff is a valid mask, so the unknown value can't be told apart from it here
+		if (s_State.Cache.StencilMask == mask && mask != s_Unknown)
+		{
+			s_State.Stats.RedundantStateChanges++;
+			return;
+		}
+
+		s_State.Cache.StencilMask = mask;
+		glStencilMask(mask);
+	}
+
+	void OpenGLState::SetPolygonMode(uint32_t mode)
+	{
+		if (Update(s_State.Cache.PolygonMode, mode, s_State.Stats.RedundantStateChanges))
+			glPolygonMode(GL_FRONT_AND_BACK, mode);
+	}
+
+	void OpenGLState::Invalidate()
+	{
+		s_State.Cache = CachedState();
+	}
+
+	void OpenGLState::InvalidateTextureUnit(uint32_t unit)
+	{
+		if (unit < MaxTrackedTextureUnits)
+			s_State.Cache.TextureUnits[unit] = s_Unknown;
+	}
+
+	void OpenGLState::OnProgramDeleted(RendererID program)
+	{
+		if (s_State.Cache.Program == program)
+			s_State.Cache.Program = s_Unknown;
+	}
+
+	void OpenGLState::OnVertexArrayDeleted(RendererID vertexArray)
+	{
+		if (s_State.Cache.VertexArray == vertexArray)
+		{
+			s_State.Cache.VertexArray = s_Unknown;
+			s_State.Cache.ElementArrayBuffer = s_Unknown;
+		}
+	}
+
+	void OpenGLState::OnBufferDeleted(RendererID buffer)
+	{
+		if (s_State.Cache.ArrayBuffer == buffer)
+			s_State.Cache.ArrayBuffer = s_Unknown;
+		if (s_State.Cache.ElementArrayBuffer == buffer)
+			s_State.Cache.ElementArrayBuffer = s_Unknown;
+		if (s_State.Cache.DrawIndirectBuffer == buffer)
+			s_State.Cache.DrawIndirectBuffer = s_Unknown;
+	}
+
+	void OpenGLState::OnTexturesDeleted(const RendererID* textures, uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			for (RendererID& unit : s_State.Cache.TextureUnits)
+			{
+				if (unit == textures[i])
+					unit = s_Unknown;
+			}
+		}
+	}
+
+	void OpenGLState::CountMaterialUpload(bool skipped)
+	{
+		if (skipped)
+			s_State.Stats.MaterialUploadsSkipped++;
+		else
+			s_State.Stats.MaterialUploads++;
+	}
+
+	void OpenGLState::CountDrawCall(uint32_t drawCount)
+	{
+		s_State.Stats.DrawCalls++;
+		s_State.Stats.Draws += drawCount;
+	}
+
+	const RenderAPIStats& OpenGLState::GetStats()
+	{
+		return s_State.Stats;
+	}
+
+	const RenderAPIStats& OpenGLState::GetFrameStats()
+	{
+		return s_State.FrameStats;
+	}
+
+	void OpenGLState::EndFrame()
+	{
+		s_State.FrameStats = s_State.Stats;
+		s_State.Stats = {};
+	}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Luma/Renderer/RendererAPI.hpp"
+#include "Luma/Renderer/RendererTypes.hpp"
+
+namespace Luma {
+
+	// Shadow copy of the GL state on the thread executing render commands. Every bind and state change
+	// goes through here, calls that would not change anything never reach the driver and are counted.
+	class OpenGLState
+	{
+	public:
+		static constexpr uint32_t MaxTrackedTextureUnits = 64;
+
+		static void UseProgram(RendererID program);
+		static void BindVertexArray(RendererID vertexArray);
+		// GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER, the element buffer is tracked per bound vertex array
+		static void BindBuffer(uint32_t target, RendererID buffer);
+		static void BindTextureUnit(uint32_t unit, RendererID texture);
+		static void BindSampler(uint32_t unit, RendererID sampler);
+
+		static void SetDepthTest(bool enabled);
+		static void SetFaceCulling(bool enabled);
+		static void SetCullFace(uint32_t face);
+		static void SetBlend(bool enabled);
+		static void SetBlendFunc(uint32_t source, uint32_t destination);
+		static void SetStencilTest(bool enabled);
+		static void SetStencilFunc(uint32_t func, int32_t reference, uint32_t mask);
+		static void SetStencilOp(uint32_t stencilFail, uint32_t depthFail, uint32_t depthPass);
+		static void SetStencilMask(uint32_t mask);
+		static void SetPolygonMode(uint32_t mode);
+
+		// Forgets everything, for code that changes GL state behind our back (ImGui)
+		static void Invalidate();
+		// glBindTexture goes to the active unit (0) and is only used while creating textures
+		static void InvalidateTextureUnit(uint32_t unit);
+		// Names of deleted objects get reused, so they must not stay cached as bound
+		static void OnProgramDeleted(RendererID program);
+		static void OnVertexArrayDeleted(RendererID vertexArray);
+		static void OnBufferDeleted(RendererID buffer);
+		static void OnTexturesDeleted(const RendererID* textures, uint32_t count);
+
+		// Skipped uploads are material uniforms the program already held
+		static void CountMaterialUpload(bool skipped);
+		// drawCount is the number of commands of a multi-draw
+		static void CountDrawCall(uint32_t drawCount = 1);
+
+		// Counts of the frame executing so far
+		static const RenderAPIStats& GetStats();
+		// Counts of the last completed frame
+		static const RenderAPIStats& GetFrameStats();
+		static void EndFrame();
+	};
+
+}
@@ -0,0 +1,209 @@
+#include "lmpch.hpp"
+#include "OpenGLStreamingBuffer.hpp"
+#include "OpenGLState.hpp"
+
+#include "Luma/Renderer/Renderer.hpp"
+#include "Luma/Core/FrameAllocator.hpp"
+
+#include <glad/glad.h>
+
+namespace Luma {
+
+	static constexpr GLbitfield s_StorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	// Never waits, a region the GPU is still reading just stays unavailable to the main thread
+	static bool IsFenceSignaled(GLsync fence)
+	{
+		GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		LM_CORE_ASSERT(result != GL_WAIT_FAILED, "glClientWaitSync failed!");
+		return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+	}
+
+	OpenGLStreamingBuffer::OpenGLStreamingBuffer(uint32_t regionSize, uint32_t maxRegionSize)
+		: m_MaxRegionSize(std::max(regionSize, maxRegionSize))
+	{
+		m_RegionFrames.fill(InvalidFrame);
+
+		// Ready after the first render queue execution, which Renderer::Init runs on the main thread
+		Allocate(regionSize);
+	}
+
+	OpenGLStreamingBuffer::~OpenGLStreamingBuffer()
+	{
+		std::array<RendererID, 2> rendererIDs = { m_Storage.Buffer, m_PendingStorageReady ? m_PendingStorage.Buffer : 0 };
+		std::array<void*, RegionCount> fences = m_Fences;
+		Renderer::Submit([rendererIDs, fences]() {
+			for (void* fence : fences)
+			{
+				if (fence)
+					glDeleteSync((GLsync)fence);
+			}
+
+			for (RendererID rendererID : rendererIDs)
+			{
+				if (!rendererID)
+					continue;
+
+				OpenGLState::OnBufferDeleted(rendererID);
+				glUnmapNamedBuffer(rendererID);
+				glDeleteBuffers(1, &rendererID);
+			}
+		});
+	}
+
+	void OpenGLStreamingBuffer::Allocate(uint32_t regionSize)
+	{
+		m_AllocationPending = true;
+
+		Ref<OpenGLStreamingBuffer> instance = this;
+		Renderer::Submit([instance, regionSize]() mutable
+		{
+			Storage& storage = instance->m_PendingStorage;
+			const GLsizeiptr size = (GLsizeiptr)regionSize * RegionCount;
+
+			storage.RegionSize = regionSize;
+			glCreateBuffers(1, &storage.Buffer);
+			glNamedBufferStorage(storage.Buffer, size, nullptr, s_StorageFlags);
+			storage.Data = (uint8_t*)glMapNamedBufferRange(storage.Buffer, 0, size, s_StorageFlags);
+			LM_CORE_ASSERT(storage.Data, "Failed to map streaming buffer!");
+
+			instance->m_PendingStorageReady.store(true, std::memory_order_release);
+		});
+	}
+
+	void OpenGLStreamingBuffer::BeginFrame(uint64_t frameIndex)
+	{
+		// Grow when the last frame did not fit, the batches that spilled over were uploaded the slow way
+		if (m_FrameOverflowed && !m_AllocationPending && m_Storage.RegionSize < m_MaxRegionSize)
+		{
+			uint64_t regionSize = std::max<uint64_t>(m_Storage.RegionSize * 2ull, m_FrameDemand + m_FrameDemand / 2);
+			Allocate((uint32_t)std::min<uint64_t>(regionSize, m_MaxRegionSize));
+		}
+
+		if (m_PendingStorageReady.load(std::memory_order_acquire))
+		{
+			// Commands submitted before this point still draw from the old storage, the GPU keeps it alive until they are done
+			if (RendererID previous = m_Storage.Buffer)
+			{
+				Renderer::Submit([previous]() {
+					OpenGLState::OnBufferDeleted(previous);
+					glUnmapNamedBuffer(previous);
+					glDeleteBuffers(1, &previous);
+				});
+			}
+
+			m_Storage = m_PendingStorage;
+			m_PendingStorageReady.store(false, std::memory_order_relaxed);
+			m_AllocationPending = false;
+
+			// Nothing has read the new storage yet
+			m_RegionFrames.fill(InvalidFrame);
+		}
+
+		m_FrameIndex = frameIndex;
+		m_Region = (uint32_t)(frameIndex % RegionCount);
+		m_Cursor = 0;
+		m_FrameDemand = 0;
+		m_FrameOverflowed = false;
+
+		// Only frames whose fence the render thread has seen signaled count as retired. While the GPU lags behind
+		// the region stays unavailable and this frame's batches fall back to upload buffers.
+		const uint64_t lastFrame = m_RegionFrames[m_Region];
+		m_RegionAvailable = lastFrame == InvalidFrame || lastFrame < m_RetiredFrameEnd.load(std::memory_order_acquire);
+	}
+
+	void* OpenGLStreamingBuffer::Map(uint32_t size)
+	{
+		LM_CORE_ASSERT(!m_Mapped, "Streaming buffer is already mapped!");
+
+		const uint64_t frameIndex = FrameAllocator::GetFrameIndex();
+		if (frameIndex != m_FrameIndex)
+			BeginFrame(frameIndex);
+
+		if (!m_Storage.Data || !m_RegionAvailable)
+			return nullptr;
+
+		if (m_Cursor + size > m_Storage.RegionSize)
+		{
+			m_FrameDemand += size;
+			m_FrameOverflowed = true;
+			return nullptr;
+		}
+
+		m_RegionFrames[m_Region] = frameIndex;
+		m_Mapped = true;
+		return m_Storage.Data + (size_t)m_Region * m_Storage.RegionSize + m_Cursor;
+	}
+
+	uint32_t OpenGLStreamingBuffer::Unmap(uint32_t size)
+	{
+		LM_CORE_ASSERT(m_Mapped, "Streaming buffer is not mapped!");
+		LM_CORE_ASSERT(m_Cursor + size <= m_Storage.RegionSize, "Streaming buffer overflow!");
+
+		const uint32_t offset = m_Region * m_Storage.RegionSize + m_Cursor;
+		m_Cursor += size;
+		m_FrameDemand += size;
+		m_Mapped = false;
+		return offset;
+	}
+
+	void OpenGLStreamingBuffer::Fence()
+	{
+		const uint64_t frameIndex = FrameAllocator::GetFrameIndex();
+		const uint32_t region = (uint32_t)(frameIndex % RegionCount);
+		const bool written = m_RegionFrames[region] == frameIndex;
+
+		Ref<OpenGLStreamingBuffer> instance = this;
+		Renderer::Submit([instance, frameIndex, region, written]() mutable
+		{
+			if (written)
+			{
+				if (instance->m_Fences[region])
+					glDeleteSync((GLsync)instance->m_Fences[region]);
+
+				instance->m_Fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				instance->m_FenceFrames[region] = frameIndex;
+			}
+
+			instance->RetireFrames(frameIndex);
+		});
+	}
+
+	void OpenGLStreamingBuffer::RetireFrames(uint64_t frameIndex)
+	{
+		if (m_RetiredFrameEnd.load(std::memory_order_relaxed) >= frameIndex)
+			return;
+
+		// Polls instead of waiting, blocking here would stall the render thread on the GPU every frame. Frames
+		// up to the oldest fence that has not signaled yet are retired, their regions are free to be reused.
+		uint64_t retiredFrameEnd = frameIndex;
+		for (uint32_t region = 0; region < RegionCount; region++)
+		{
+			if (!m_Fences[region] || m_FenceFrames[region] >= frameIndex)
+				continue;
+
+			if (IsFenceSignaled((GLsync)m_Fences[region]))
+			{
+				glDeleteSync((GLsync)m_Fences[region]);
+				m_Fences[region] = nullptr;
+			}
+			else
+			{
+				retiredFrameEnd = std::min(retiredFrameEnd, m_FenceFrames[region]);
+			}
+		}
+
+		if (retiredFrameEnd > m_RetiredFrameEnd.load(std::memory_order_relaxed))
+			m_RetiredFrameEnd.store(retiredFrameEnd, std::memory_order_release);
+	}
+
+	void OpenGLStreamingBuffer::Bind() const
+	{
+		// By value, the storage can be replaced before the command executes
+		RendererID rendererID = m_Storage.Buffer;
+		Renderer::Submit([rendererID]() {
+			OpenGLState::BindBuffer(GL_ARRAY_BUFFER, rendererID);
+		});
+	}
+
+}
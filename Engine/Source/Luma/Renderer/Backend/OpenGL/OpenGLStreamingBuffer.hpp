@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Luma/Renderer/StreamingBuffer.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace Luma {
+
+	class OpenGLStreamingBuffer : public StreamingBuffer
+	{
+	public:
+		OpenGLStreamingBuffer(uint32_t regionSize, uint32_t maxRegionSize);
+		virtual ~OpenGLStreamingBuffer();
+
+		virtual void* Map(uint32_t size) override;
+		virtual uint32_t Unmap(uint32_t size) override;
+		virtual void Fence() override;
+		virtual void Bind() const override;
+
+		virtual uint32_t GetRegionSize() const override { return m_Storage.RegionSize; }
+		virtual RendererID GetRendererID() const override { return m_Storage.Buffer; }
+	private:
+		struct Storage
+		{
+			RendererID Buffer = 0;
+			uint32_t RegionSize = 0;
+			uint8_t* Data = nullptr;
+		};
+
+		void BeginFrame(uint64_t frameIndex);
+		// Creates storage with regions of regionSize bytes on the render thread, it replaces the current one
+		// at the start of the first frame after it is ready
+		void Allocate(uint32_t regionSize);
+		// Render thread, polls the fences of the frames before frameIndex without waiting for them
+		void RetireFrames(uint64_t frameIndex);
+	private:
+		static constexpr uint64_t InvalidFrame = ~0ull;
+
+		Storage m_Storage;
+		uint32_t m_MaxRegionSize = 0;
+
+		// Submission side
+		uint64_t m_FrameIndex = InvalidFrame;
+		uint32_t m_Region = 0;
+		uint32_t m_Cursor = 0;
+		bool m_RegionAvailable = false;
+		bool m_Mapped = false;
+		std::array<uint64_t, RegionCount> m_RegionFrames;
+		// Bytes asked for this frame, including what did not fit
+		uint64_t m_FrameDemand = 0;
+		bool m_FrameOverflowed = false;
+		bool m_AllocationPending = false;
+
+		// Written by the render thread, picked up by the submission side once m_PendingStorageReady is set
+		Storage m_PendingStorage;
+		std::atomic<bool> m_PendingStorageReady = false;
+
+		// Render thread, GLsync per region and the frame that fenced it
+		std::array<void*, RegionCount> m_Fences{};
+		std::array<uint64_t, RegionCount> m_FenceFrames{};
+		// Every frame before this one has been read completely by the GPU
+		std::atomic<uint64_t> m_RetiredFrameEnd = 0;
+	};
+
+}
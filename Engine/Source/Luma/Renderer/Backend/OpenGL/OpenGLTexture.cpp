@@ -1,5 +1,6 @@
 #include "lmpch.hpp"
 #include "OpenGLTexture.hpp"
+#include "OpenGLState.hpp"
 
 #include "Luma/Renderer/RendererAPI.hpp"
 #include "Luma/Renderer/Renderer.hpp"
@@ -21,6 +22,19 @@ namespace Luma {
 		return 0;
 	}
 
+	// The sized format the driver picks for the unsized formats above
+	static GLenum LumaToOpenGLStorageFormat(TextureFormat format)
+	{
+		switch (format)
+		{
+			case Luma::TextureFormat::RGB:     return GL_RGB8;
+			case Luma::TextureFormat::RGBA:    return GL_RGBA8;
+			case Luma::TextureFormat::Float16: return GL_RGBA16F;
+		}
+		LM_CORE_ASSERT(false, "Unknown texture format!");
+		return 0;
+	}
+
 	//////////////////////////////////////////////////////////////////////////////////
 	// Texture2D
 	//////////////////////////////////////////////////////////////////////////////////
@@ -28,6 +42,8 @@ namespace Luma {
 	OpenGLTexture2D::OpenGLTexture2D(TextureFormat format, uint32_t width, uint32_t height, TextureWrap wrap)
 		: m_Format(format), m_Width(width), m_Height(height), m_Wrap(wrap)
 	{
+		m_StorageFormat = LumaToOpenGLStorageFormat(format);
+
 		Ref<OpenGLTexture2D> instance = this;
 		Renderer::Submit([instance]() mutable
 		{
@@ -44,6 +60,7 @@ namespace Luma {
 			glTexImage2D(GL_TEXTURE_2D, 0, LumaToOpenGLTextureFormat(instance->m_Format), instance->m_Width, instance->m_Height, 0, LumaToOpenGLTextureFormat(instance->m_Format), GL_UNSIGNED_BYTE, nullptr);
 
 			glBindTexture(GL_TEXTURE_2D, 0);
+			OpenGLState::InvalidateTextureUnit(0);
 		});
 
 		m_ImageData.Allocate(width * height * Texture::GetBPP(m_Format));
@@ -75,6 +92,9 @@ namespace Luma {
 
 		m_Width = width;
 		m_Height = height;
+		m_StorageFormat = srgb ? GL_SRGB8 : LumaToOpenGLStorageFormat(m_Format);
+		m_Filtered = true;
+		m_Wrap = srgb ? TextureWrap::Repeat : TextureWrap::Clamp;
 
 		Ref<OpenGLTexture2D> instance = this;
 		Renderer::Submit([instance, srgb]() mutable
@@ -109,6 +129,7 @@ namespace Luma {
 				glGenerateMipmap(GL_TEXTURE_2D);
 
 				glBindTexture(GL_TEXTURE_2D, 0);
+				OpenGLState::InvalidateTextureUnit(0);
 			}
 			stbi_image_free(instance->m_ImageData.Data);
 		});
@@ -118,6 +139,7 @@ namespace Luma {
 	{
 		GLuint rendererID = m_RendererID;
 		Renderer::Submit([rendererID]() {
+			OpenGLState::OnTexturesDeleted(&rendererID, 1);
 			glDeleteTextures(1, &rendererID);
 		});
 	}
@@ -126,7 +148,7 @@ namespace Luma {
 	{
 		Ref<const OpenGLTexture2D> instance = this;
 		Renderer::Submit([instance, slot]() {
-			glBindTextureUnit(slot, instance->m_RendererID);
+			OpenGLState::BindTextureUnit(slot, instance->m_RendererID);
 		});
 	}
 
@@ -138,12 +160,23 @@ namespace Luma {
 	void OpenGLTexture2D::Unlock()
 	{
 		m_Locked = false;
+		m_DataVersion++;
 		Ref<OpenGLTexture2D> instance = this;
 		Renderer::Submit([instance]() {
 			glTextureSubImage2D(instance->m_RendererID, 0, 0, 0, instance->m_Width, instance->m_Height, LumaToOpenGLTextureFormat(instance->m_Format), GL_UNSIGNED_BYTE, instance->m_ImageData.Data);
 		});
 	}
 
+	void OpenGLTexture2D::SetData(Ref<UploadBuffer> data)
+	{
+		LM_CORE_ASSERT(data->GetSize() >= (uint64_t)m_Width * m_Height * Texture::GetBPP(m_Format), "Upload buffer is too small!");
+		m_DataVersion++;
+		Ref<OpenGLTexture2D> instance = this;
+		Renderer::Submit([instance, data]() {
+			glTextureSubImage2D(instance->m_RendererID, 0, 0, 0, instance->m_Width, instance->m_Height, LumaToOpenGLTextureFormat(instance->m_Format), GL_UNSIGNED_BYTE, data->GetData());
+		});
+	}
+
 	void OpenGLTexture2D::Resize(uint32_t width, uint32_t height)
 	{
 		LM_CORE_ASSERT(m_Locked, "Texture must be locked!");
@@ -165,6 +198,126 @@ namespace Luma {
 		return Texture::CalculateMipMapCount(m_Width, m_Height);
 	}
 
+	//////////////////////////////////////////////////////////////////////////////////
+	// Texture2DArray
+	//////////////////////////////////////////////////////////////////////////////////
+
+	OpenGLTexture2DArray::OpenGLTexture2DArray(const Ref<OpenGLTexture2D>& layout, uint32_t layerCount)
+		: m_Format(layout->GetFormat()), m_LayoutKey(GetLayoutKey(layout)), m_StorageFormat(layout->GetStorageFormat()),
+		m_Width(layout->GetWidth()), m_Height(layout->GetHeight()), m_LayerCount(layerCount), m_Filtered(layout->IsFiltered()), m_Wrap(layout->GetWrap())
+	{
+		LM_CORE_ASSERT(m_LayoutKey, "Texture can't be used as the layout of an array!");
+		m_MipLevelCount = m_Filtered ? Texture::CalculateMipMapCount(m_Width, m_Height) : 1;
+
+		Ref<OpenGLTexture2DArray> instance = this;
+		Renderer::Submit([instance, layerCount]() mutable
+		{
+			instance->m_RendererID = instance->CreateStorage(layerCount);
+		});
+	}
+
+	OpenGLTexture2DArray::~OpenGLTexture2DArray()
+	{
+		GLuint rendererID = m_RendererID;
+		Renderer::Submit([rendererID]() {
+			OpenGLState::OnTexturesDeleted(&rendererID, 1);
+			glDeleteTextures(1, &rendererID);
+		});
+	}
+
+	RendererID OpenGLTexture2DArray::CreateStorage(uint32_t layerCount) const
+	{
+		GLuint rendererID;
+		glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &rendererID);
+		glTextureStorage3D(rendererID, m_MipLevelCount, m_StorageFormat, m_Width, m_Height, layerCount);
+
+		// Same sampling as the textures that are copied in
+		if (m_Filtered)
+		{
+			glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, m_MipLevelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+			glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		}
+		else
+		{
+			glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		}
+		GLenum wrap = m_Wrap == TextureWrap::Repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+		glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, wrap);
+		glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, wrap);
+		return rendererID;
+	}
+
+	void OpenGLTexture2DArray::Bind(uint32_t slot) const
+	{
+		Ref<const OpenGLTexture2DArray> instance = this;
+		Renderer::Submit([instance, slot]() {
+			if (instance->m_MipsDirty)
+			{
+				glGenerateTextureMipmap(instance->m_RendererID);
+				instance->m_MipsDirty = false;
+			}
+			OpenGLState::BindTextureUnit(slot, instance->m_RendererID);
+		});
+	}
+
+	void OpenGLTexture2DArray::Resize(uint32_t layerCount)
+	{
+		if (layerCount == m_LayerCount)
+			return;
+
+		const uint32_t copyCount = std::min(layerCount, m_LayerCount);
+		m_LayerCount = layerCount;
+
+		Ref<OpenGLTexture2DArray> instance = this;
+		Renderer::Submit([instance, layerCount, copyCount]() mutable
+		{
+			GLuint previous = instance->m_RendererID;
+			instance->m_RendererID = instance->CreateStorage(layerCount);
+
+			for (uint32_t level = 0; level < instance->m_MipLevelCount && copyCount; level++)
+			{
+				uint32_t width = std::max(instance->m_Width >> level, 1u);
+				uint32_t height = std::max(instance->m_Height >> level, 1u);
+				glCopyImageSubData(previous, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+					instance->m_RendererID, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0, width, height, copyCount);
+			}
+
+			OpenGLState::OnTexturesDeleted(&previous, 1);
+			glDeleteTextures(1, &previous);
+		});
+	}
+
+	void OpenGLTexture2DArray::CopyLayer(uint32_t layer, const Ref<Texture2D>& source)
+	{
+		LM_CORE_ASSERT(layer < m_LayerCount, "Layer out of range!");
+		LM_CORE_ASSERT(GetLayoutKey(source.As<OpenGLTexture2D>()) == m_LayoutKey, "Texture doesn't match the layout of the array!");
+
+		Ref<OpenGLTexture2DArray> instance = this;
+		Ref<Texture2D> texture = source;
+		Renderer::Submit([instance, layer, texture]() {
+			glCopyImageSubData(texture->GetRendererID(), GL_TEXTURE_2D, 0, 0, 0, 0,
+				instance->m_RendererID, GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, instance->m_Width, instance->m_Height, 1);
+			instance->m_MipsDirty = instance->m_MipLevelCount > 1;
+		});
+	}
+
+	uint64_t OpenGLTexture2DArray::GetLayoutKey(const Ref<OpenGLTexture2D>& texture)
+	{
+		// Textures that failed to load have no storage to copy from
+		if (!texture || !texture->GetStorageFormat() || !texture->GetWidth() || !texture->GetHeight())
+			return 0;
+		if (texture->GetWidth() > 0xffff || texture->GetHeight() > 0xffff)
+			return 0;
+
+		// GL enums fit into 16 bits
+		return (uint64_t)texture->GetWidth()
+			| (uint64_t)texture->GetHeight() << 16
+			| (uint64_t)(texture->GetStorageFormat() & 0xffff) << 32
+			| (uint64_t)texture->IsFiltered() << 48
+			| (uint64_t)(texture->GetWrap() == TextureWrap::Repeat) << 49;
+	}
+
 	//////////////////////////////////////////////////////////////////////////////////
 	// TextureCube
 	//////////////////////////////////////////////////////////////////////////////////
@@ -276,6 +429,7 @@ namespace Luma {
 			glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
 			glBindTexture(GL_TEXTURE_2D, 0);
+			OpenGLState::InvalidateTextureUnit(0);
 
 			for (size_t i = 0; i < faces.size(); i++)
 				delete[] faces[i];
@@ -288,6 +442,7 @@ namespace Luma {
 	{
 		GLuint rendererID = m_RendererID;
 		Renderer::Submit([rendererID]() {
+			OpenGLState::OnTexturesDeleted(&rendererID, 1);
 			glDeleteTextures(1, &rendererID);
 		});
 	}
@@ -296,7 +451,7 @@ namespace Luma {
 	{
 		Ref<const OpenGLTextureCube> instance = this;
 		Renderer::Submit([instance, slot]() {
-			glBindTextureUnit(slot, instance->m_RendererID);
+			OpenGLState::BindTextureUnit(slot, instance->m_RendererID);
 		});
 	}
 
@@ -27,12 +27,21 @@ namespace Luma {
 		virtual void Resize(uint32_t width, uint32_t height) override;
 		virtual Buffer GetWriteableBuffer() override;
 
+		virtual void SetData(Ref<UploadBuffer> data) override;
+
 		virtual const std::string& GetPath() const override { return m_FilePath; }
 
 		virtual bool Loaded() const override { return m_Loaded; }
+		virtual uint32_t GetDataVersion() const override { return m_DataVersion; }
 
 		virtual RendererID GetRendererID() const override { return m_RendererID; }
 
+		// Sized internal format of the texture storage
+		uint32_t GetStorageFormat() const { return m_StorageFormat; }
+		// Linear filtering with mips, otherwise nearest filtering without mips
+		bool IsFiltered() const { return m_Filtered; }
+		TextureWrap GetWrap() const { return m_Wrap; }
+
 		virtual bool operator==(const Texture& other) const override
 		{
 			return m_RendererID == ((OpenGLTexture2D&)other).m_RendererID;
@@ -41,7 +50,10 @@ namespace Luma {
 		RendererID m_RendererID;
 		TextureFormat m_Format;
 		TextureWrap m_Wrap = TextureWrap::Clamp;
-		uint32_t m_Width, m_Height;
+		uint32_t m_Width = 0, m_Height = 0;
+		uint32_t m_StorageFormat = 0;
+		bool m_Filtered = false;
+		uint32_t m_DataVersion = 0;
 
 		Buffer m_ImageData;
 		bool m_IsHDR = false;
@@ -85,4 +97,51 @@ namespace Luma {
 
 		std::string m_FilePath;
 	};
+
+	class OpenGLTexture2DArray : public Texture2DArray
+	{
+	public:
+		OpenGLTexture2DArray(const Ref<OpenGLTexture2D>& layout, uint32_t layerCount);
+		virtual ~OpenGLTexture2DArray();
+
+		virtual void Bind(uint32_t slot = 0) const override;
+
+		virtual TextureFormat GetFormat() const override { return m_Format; }
+		virtual uint32_t GetWidth() const override { return m_Width; }
+		virtual uint32_t GetHeight() const override { return m_Height; }
+		virtual uint32_t GetMipLevelCount() const override { return m_MipLevelCount; }
+		virtual uint32_t GetLayerCount() const override { return m_LayerCount; }
+
+		virtual void Resize(uint32_t layerCount) override;
+		virtual void CopyLayer(uint32_t layer, const Ref<Texture2D>& source) override;
+
+		virtual RendererID GetRendererID() const override { return m_RendererID; }
+
+		virtual bool operator==(const Texture& other) const override
+		{
+			return m_RendererID == ((OpenGLTexture2DArray&)other).m_RendererID;
+		}
+
+		// Size, storage format and sampling packed into 64 bits, see Texture2DArray::GetLayoutKey
+		static uint64_t GetLayoutKey(const Ref<OpenGLTexture2D>& texture);
+	private:
+		// Render thread only
+		RendererID CreateStorage(uint32_t layerCount) const;
+	private:
+		RendererID m_RendererID = 0;
+		TextureFormat m_Format;
+		uint64_t m_LayoutKey;
+		uint32_t m_StorageFormat;
+		uint32_t m_Width, m_Height;
+		uint32_t m_MipLevelCount;
+		uint32_t m_LayerCount;
+		bool m_Filtered;
+		TextureWrap m_Wrap;
+
+		// Copies only write the top level, the mips are regenerated on the next bind. Render thread only
+		mutable bool m_MipsDirty = false;
+	};
+
+	LM_POOLED_REF(OpenGLTexture2D);
+
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "lmpch.hpp"
+#include "OpenGLUniformBuffer.hpp"
+#include "OpenGLState.hpp"
+
+#include "Luma/Renderer/Renderer.hpp"
+#include "Luma/Core/FrameAllocator.hpp"
+
+#include <glad/glad.h>
+
+namespace Luma {
+
+	OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size, uint32_t binding)
+		: m_Size(size), m_Binding(binding)
+	{
+		Ref<OpenGLUniformBuffer> instance = this;
+		Renderer::Submit([instance]() mutable
+		{
+			glCreateBuffers(1, &instance->m_RendererID);
+			glNamedBufferData(instance->m_RendererID, instance->m_Size, nullptr, GL_DYNAMIC_DRAW);
+			glBindBufferBase(GL_UNIFORM_BUFFER, instance->m_Binding, instance->m_RendererID);
+		});
+	}
+
+	OpenGLUniformBuffer::~OpenGLUniformBuffer()
+	{
+		GLuint rendererID = m_RendererID;
+		Renderer::Submit([rendererID]() {
+			OpenGLState::OnBufferDeleted(rendererID);
+			glDeleteBuffers(1, &rendererID);
+		});
+	}
+
+	void OpenGLUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		LM_CORE_ASSERT(offset + size <= m_Size, "Uniform buffer overflow!");
+
+		// Staged in the frame arena, which outlives the render command that uploads it
+		void* stagingData = FrameAllocator::Allocate(size);
+		memcpy(stagingData, data, size);
+		Ref<OpenGLUniformBuffer> instance = this;
+		Renderer::Submit([instance, stagingData, size, offset]() {
+			glNamedBufferSubData(instance->m_RendererID, offset, size, stagingData);
+		});
+	}
+
+	void OpenGLUniformBuffer::Bind() const
+	{
+		Ref<const OpenGLUniformBuffer> instance = this;
+		Renderer::Submit([instance]() {
+			glBindBufferBase(GL_UNIFORM_BUFFER, instance->m_Binding, instance->m_RendererID);
+		});
+	}
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Luma/Renderer/UniformBuffer.hpp"
+
+namespace Luma {
+
+	class OpenGLUniformBuffer : public UniformBuffer
+	{
+	public:
+		OpenGLUniformBuffer(uint32_t size, uint32_t binding);
+		virtual ~OpenGLUniformBuffer();
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+		virtual void Bind() const override;
+
+		virtual uint32_t GetSize() const override { return m_Size; }
+		virtual uint32_t GetBinding() const override { return m_Binding; }
+		virtual RendererID GetRendererID() const override { return m_RendererID; }
+	private:
+		RendererID m_RendererID = 0;
+		uint32_t m_Size;
+		uint32_t m_Binding;
+	};
+
+}
@@ -1,7 +1,9 @@
 #include "lmpch.hpp"
 #include "OpenGLVertexBuffer.hpp"
+#include "OpenGLState.hpp"
 
 #include "Luma/Renderer/Renderer.hpp"
+#include "Luma/Core/FrameAllocator.hpp"
 
 #include <glad/glad.h>
 
@@ -21,13 +23,13 @@ namespace Luma {
 	OpenGLVertexBuffer::OpenGLVertexBuffer(void* data, uint32_t size, VertexBufferUsage usage)
 		: m_Size(size), m_Usage(usage)
 	{
-		m_LocalData = Buffer::Copy(data, size);
+		Ref<UploadBuffer> uploadBuffer = UploadBuffer::Copy(data, size);
 
 		Ref<OpenGLVertexBuffer> instance = this;
-		Renderer::Submit([instance]() mutable
+		Renderer::Submit([instance, uploadBuffer]() mutable
 		{
 			glCreateBuffers(1, &instance->m_RendererID);
-			glNamedBufferData(instance->m_RendererID, instance->m_Size, instance->m_LocalData.Data, OpenGLUsage(instance->m_Usage));
+			glNamedBufferData(instance->m_RendererID, instance->m_Size, uploadBuffer->GetData(), OpenGLUsage(instance->m_Usage));
 		});
 	}
 
@@ -46,17 +48,30 @@ namespace Luma {
 	{
 		GLuint rendererID = m_RendererID;
 		Renderer::Submit([rendererID]() {
+			OpenGLState::OnBufferDeleted(rendererID);
 			glDeleteBuffers(1, &rendererID);
 		});
 	}
 
 	void OpenGLVertexBuffer::SetData(void* data, uint32_t size, uint32_t offset)
 	{
-		m_LocalData = Buffer::Copy(data, size);
+		// Staged in the frame arena, which outlives the render command that uploads it
+		void* stagingData = FrameAllocator::Allocate(size);
+		memcpy(stagingData, data, size);
+		m_Size = size;
+		Ref<OpenGLVertexBuffer> instance = this;
+		Renderer::Submit([instance, stagingData, size, offset]() {
+			glNamedBufferSubData(instance->m_RendererID, offset, size, stagingData);
+		});
+	}
+
+	void OpenGLVertexBuffer::SetData(Ref<UploadBuffer> data, uint32_t size, uint32_t offset)
+	{
+		LM_CORE_ASSERT(size <= data->GetSize(), "Upload buffer is too small!");
 		m_Size = size;
 		Ref<OpenGLVertexBuffer> instance = this;
-		Renderer::Submit([instance, offset]() {
-			glNamedBufferSubData(instance->m_RendererID, offset, instance->m_LocalData.Size, instance->m_LocalData.Data);
+		Renderer::Submit([instance, data, size, offset]() {
+			glNamedBufferSubData(instance->m_RendererID, offset, size, data->GetData());
 		});
 	}
 
@@ -64,7 +79,7 @@ namespace Luma {
 	{
 		Ref<const OpenGLVertexBuffer> instance = this;
 		Renderer::Submit([instance]() {
-			glBindBuffer(GL_ARRAY_BUFFER, instance->m_RendererID);
+			OpenGLState::BindBuffer(GL_ARRAY_BUFFER, instance->m_RendererID);
 		});
 	}
 
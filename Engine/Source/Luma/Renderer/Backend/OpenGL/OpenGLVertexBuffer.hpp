@@ -2,8 +2,6 @@
 
 #include "Luma/Renderer/VertexBuffer.hpp"
 
-#include "Luma/Core/Buffer.hpp"
-
 namespace Luma {
 
 	class OpenGLVertexBuffer : public VertexBuffer
@@ -14,6 +12,7 @@ namespace Luma {
 		virtual ~OpenGLVertexBuffer();
 
 		virtual void SetData(void* data, uint32_t size, uint32_t offset = 0);
+		virtual void SetData(Ref<UploadBuffer> data, uint32_t size, uint32_t offset = 0);
 		virtual void Bind() const;
 
 		virtual const VertexBufferLayout& GetLayout() const override { return m_Layout; }
@@ -26,8 +25,8 @@ namespace Luma {
 		uint32_t m_Size;
 		VertexBufferUsage m_Usage;
 		VertexBufferLayout m_Layout;
-
-		Buffer m_LocalData;
 	};
 
+	LM_POOLED_REF(OpenGLVertexBuffer);
+
 }
\ No newline at end of file
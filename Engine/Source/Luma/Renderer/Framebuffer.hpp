@@ -74,6 +74,8 @@ namespace Luma {
 		virtual RendererID GetRendererID() const = 0;
 		virtual RendererID GetColorAttachmentRendererID(int index = 0) const = 0;
 		virtual RendererID GetDepthAttachmentRendererID() const = 0;
+		// Changes whenever the attachments are recreated, which discards their contents
+		virtual uint32_t GetVersion() const = 0;
 
 		virtual const FramebufferSpecification& GetSpecification() const = 0;
 
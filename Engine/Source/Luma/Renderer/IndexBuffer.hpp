@@ -3,6 +3,7 @@
 #include "Luma/Core/Ref.hpp"
 
 #include "RendererTypes.hpp"
+#include "UploadBuffer.hpp"
 
 namespace Luma {
 
@@ -12,6 +13,8 @@ namespace Luma {
 		virtual ~IndexBuffer() {}
 
 		virtual void SetData(void* buffer, uint32_t size, uint32_t offset = 0) = 0;
+		// Uploads the first size bytes of data without copying them
+		virtual void SetData(Ref<UploadBuffer> data, uint32_t size, uint32_t offset = 0) = 0;
 		virtual void Bind() const = 0;
 
 		virtual uint32_t GetCount() const = 0;
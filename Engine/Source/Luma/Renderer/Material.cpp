@@ -1,8 +1,21 @@
 #include "lmpch.hpp"
 #include "Material.hpp"
 
+#include "Luma/Core/FrameAllocator.hpp"
+
 namespace Luma {
 
+	static std::atomic<uint64_t> s_NextUniformVersion = 1;
+
+	// Set* calls for the next frame can overwrite the storage while the render thread uploads this one,
+	// so uploads read a copy that lives until the frame has rendered
+	static Buffer SnapshotUniformStorage(const Buffer& storage)
+	{
+		Buffer snapshot(FrameAllocator::Allocate(storage.Size), storage.Size);
+		memcpy(snapshot.Data, storage.Data, storage.Size);
+		return snapshot;
+	}
+
 	//////////////////////////////////////////////////////////////////////////////////
 	// Material
 	//////////////////////////////////////////////////////////////////////////////////
@@ -41,39 +54,71 @@ namespace Luma {
 			m_PSUniformStorageBuffer.Allocate(psBuffer.GetSize());
 			m_PSUniformStorageBuffer.ZeroInitialize();
 		}
+
+		BuildParameterTables();
+	}
+
+	void Material::BuildParameterTables()
+	{
+		m_Uniforms.clear();
+		m_UniformIndices.clear();
+		m_Resources.clear();
+
+		auto addUniforms = [this](const ShaderUniformBufferDeclaration& buffer)
+		{
+			for (ShaderUniformDeclaration* uniform : buffer.GetUniformDeclarations())
+			{
+				// A uniform declared in both stages resolves to the vertex stage one, same as the old name lookup
+				auto [it, inserted] = m_UniformIndices.try_emplace(Identifier(uniform->GetName()), (uint32_t)m_Uniforms.size());
+				LM_CORE_ASSERT(inserted || m_Uniforms[it->second].Declaration->GetName() == uniform->GetName(), "Material uniform name hash collision!");
+				if (inserted)
+					m_Uniforms.push_back({ uniform->GetDomain(), uniform->GetOffset(), uniform->GetSize(), uniform });
+			}
+		};
+
+		if (m_VSUniformStorageBuffer)
+			addUniforms(m_Shader->GetVSMaterialUniformBuffer());
+		if (m_PSUniformStorageBuffer)
+			addUniforms(m_Shader->GetPSMaterialUniformBuffer());
+
+		for (ShaderResourceDeclaration* resource : m_Shader->GetResources())
+		{
+			auto [it, inserted] = m_Resources.try_emplace(Identifier(resource->GetName()), resource);
+			LM_CORE_ASSERT(inserted || it->second->GetName() == resource->GetName(), "Material resource name hash collision!");
+		}
 	}
 
 	void Material::OnShaderReloaded()
 	{
+		// The declarations belong to the shader, so the lookup tables have to follow it even while
+		// storage reallocation below is disabled
+		BuildParameterTables();
+		for (auto mi : m_MaterialInstances)
+			mi->m_OverriddenValues.resize(m_Uniforms.size());
 		return;
+
 		AllocateStorage();
 
 		for (auto mi : m_MaterialInstances)
 			mi->OnShaderReloaded();
 	}
 
-	ShaderUniformDeclaration* Material::FindUniformDeclaration(const std::string& name)
+	MaterialUniformHandle Material::GetUniformHandle(Identifier name) const
 	{
-		if (m_VSUniformStorageBuffer)
-		{
-			auto& declarations = m_Shader->GetVSMaterialUniformBuffer().GetUniformDeclarations();
-			for (ShaderUniformDeclaration* uniform : declarations)
-			{
-				if (uniform->GetName() == name)
-					return uniform;
-			}
-		}
+		auto it = m_UniformIndices.find(name);
+		if (it == m_UniformIndices.end())
+			return {};
 
-		if (m_PSUniformStorageBuffer)
-		{
-			auto& declarations = m_Shader->GetPSMaterialUniformBuffer().GetUniformDeclarations();
-			for (ShaderUniformDeclaration* uniform : declarations)
-			{
-				if (uniform->GetName() == name)
-					return uniform;
-			}
-		}
-		return nullptr;
+		return { it->second };
+	}
+
+	MaterialResourceHandle Material::GetResourceHandle(Identifier name) const
+	{
+		auto it = m_Resources.find(name);
+		if (it == m_Resources.end())
+			return {};
+
+		return { it->second->GetRegister() };
 	}
 
 	ShaderResourceDeclaration* Material::FindResourceDeclaration(const std::string& name)
@@ -87,9 +132,9 @@ namespace Luma {
 		return nullptr;
 	}
 
-	Buffer& Material::GetUniformBufferTarget(ShaderUniformDeclaration* uniformDeclaration)
+	Buffer& Material::GetUniformBufferTarget(ShaderDomain domain)
 	{
-		switch (uniformDeclaration->GetDomain())
+		switch (domain)
 		{
 			case ShaderDomain::Vertex:    return m_VSUniformStorageBuffer;
 			case ShaderDomain::Pixel:     return m_PSUniformStorageBuffer;
@@ -103,11 +148,12 @@ namespace Luma {
 	{
 		m_Shader->Bind();
 
+		// Materials aren't versioned, their data is always uploaded in full
 		if (m_VSUniformStorageBuffer)
-			m_Shader->SetVSMaterialUniformBuffer(m_VSUniformStorageBuffer);
+			m_Shader->SetVSMaterialUniformBuffer({ SnapshotUniformStorage(m_VSUniformStorageBuffer) });
 
 		if (m_PSUniformStorageBuffer)
-			m_Shader->SetPSMaterialUniformBuffer(m_PSUniformStorageBuffer);
+			m_Shader->SetPSMaterialUniformBuffer({ SnapshotUniformStorage(m_PSUniformStorageBuffer) });
 
 		BindTextures();
 	}
@@ -146,7 +192,6 @@ namespace Luma {
 	void MaterialInstance::OnShaderReloaded()
 	{
 		AllocateStorage();
-		m_OverriddenValues.clear();
 	}
 
 	void MaterialInstance::AllocateStorage()
@@ -164,6 +209,40 @@ namespace Luma {
 			m_PSUniformStorageBuffer.Allocate(psBuffer.GetSize());
 			memcpy(m_PSUniformStorageBuffer.Data, m_Material->m_PSUniformStorageBuffer.Data, psBuffer.GetSize());
 		}
+
+		m_OverriddenValues.assign(m_Material->m_Uniforms.size(), false);
+
+		MarkDirty(ShaderDomain::Vertex, 0, (uint32_t)m_VSUniformStorageBuffer.Size);
+		MarkDirty(ShaderDomain::Pixel, 0, (uint32_t)m_PSUniformStorageBuffer.Size);
+	}
+
+	void MaterialInstance::MarkDirty(ShaderDomain domain, uint32_t offset, uint32_t size)
+	{
+		DirtyRange& range = domain == ShaderDomain::Vertex ? m_VSDirtyRange : m_PSDirtyRange;
+		if (range.Begin == range.End)
+		{
+			range = { offset, offset + size };
+		}
+		else
+		{
+			range.Begin = std::min(range.Begin, offset);
+			range.End = std::max(range.End, offset + size);
+		}
+
+		m_UniformVersion = s_NextUniformVersion.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	MaterialUniformUpdate MaterialInstance::TakeUniformUpdate(const Buffer& buffer, DirtyRange& dirtyRange)
+	{
+		// A different instance may have used the program in between, so the whole block is needed, not just the dirty range
+		MaterialUniformUpdate update;
+		update.Data = SnapshotUniformStorage(buffer);
+		update.Version = m_UniformVersion;
+		update.PreviousVersion = m_BoundUniformVersion;
+		update.DirtyOffset = dirtyRange.Begin;
+		update.DirtySize = dirtyRange.End - dirtyRange.Begin;
+		dirtyRange = {};
+		return update;
 	}
 
 	void MaterialInstance::SetFlag(MaterialFlag flag, bool value)
@@ -178,19 +257,21 @@ namespace Luma {
 		}
 	}
 
-	void MaterialInstance::OnMaterialValueUpdated(ShaderUniformDeclaration* decl)
+	void MaterialInstance::OnMaterialValueUpdated(MaterialUniformHandle handle)
 	{
-		if (m_OverriddenValues.find(decl->GetName()) == m_OverriddenValues.end())
-		{
-			auto& buffer = GetUniformBufferTarget(decl);
-			auto& materialBuffer = m_Material->GetUniformBufferTarget(decl);
-			buffer.Write((byte*)materialBuffer.Data + decl->GetOffset(), decl->GetSize(), decl->GetOffset());
-		}
+		if (m_OverriddenValues[handle.Index])
+			return;
+
+		const Material::MaterialUniform& uniform = m_Material->m_Uniforms[handle.Index];
+		auto& buffer = GetUniformBufferTarget(uniform.Domain);
+		auto& materialBuffer = m_Material->GetUniformBufferTarget(uniform.Domain);
+		buffer.Write((byte*)materialBuffer.Data + uniform.Offset, uniform.Size, uniform.Offset);
+		MarkDirty(uniform.Domain, uniform.Offset, uniform.Size);
 	}
 
-	Buffer& MaterialInstance::GetUniformBufferTarget(ShaderUniformDeclaration* uniformDeclaration)
+	Buffer& MaterialInstance::GetUniformBufferTarget(ShaderDomain domain)
 	{
-		switch (uniformDeclaration->GetDomain())
+		switch (domain)
 		{
 			case ShaderDomain::Vertex:    return m_VSUniformStorageBuffer;
 			case ShaderDomain::Pixel:     return m_PSUniformStorageBuffer;
@@ -204,11 +285,18 @@ namespace Luma {
 	{
 		m_Material->m_Shader->Bind();
 
-		if (m_VSUniformStorageBuffer)
-			m_Material->m_Shader->SetVSMaterialUniformBuffer(m_VSUniformStorageBuffer);
+		{
+			// The shader skips the upload if it still holds this version and only uploads the
+			// dirty ranges if it holds the version of the previous bind
+			std::scoped_lock<std::mutex> lock(m_BindMutex);
+			if (m_VSUniformStorageBuffer)
+				m_Material->m_Shader->SetVSMaterialUniformBuffer(TakeUniformUpdate(m_VSUniformStorageBuffer, m_VSDirtyRange));
 
-		if (m_PSUniformStorageBuffer)
-			m_Material->m_Shader->SetPSMaterialUniformBuffer(m_PSUniformStorageBuffer);
+			if (m_PSUniformStorageBuffer)
+				m_Material->m_Shader->SetPSMaterialUniformBuffer(TakeUniformUpdate(m_PSUniformStorageBuffer, m_PSDirtyRange));
+
+			m_BoundUniformVersion = m_UniformVersion;
+		}
 
 		m_Material->BindTextures();
 		for (size_t i = 0; i < m_Textures.size(); i++)
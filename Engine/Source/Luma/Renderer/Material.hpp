@@ -1,10 +1,13 @@
 #pragma once
 
 #include "Luma/Core/Base.hpp"
+#include "Luma/Core/Identifier.hpp"
 
 #include "Luma/Renderer/Shader.hpp"
 #include "Luma/Renderer/Texture.hpp"
 
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace Luma {
@@ -17,6 +20,24 @@ namespace Luma {
 		TwoSided   = Bit(3)
 	};
 
+	// Handles are resolved once from a name and stay valid for the material they came from and all of its
+	// instances, until the shader is reloaded. Setting through a handle skips the name lookup entirely.
+	struct MaterialUniformHandle
+	{
+		static constexpr uint32_t Invalid = 0xffffffff;
+		uint32_t Index = Invalid;
+
+		bool IsValid() const { return Index != Invalid; }
+	};
+
+	struct MaterialResourceHandle
+	{
+		static constexpr uint32_t Invalid = 0xffffffff;
+		uint32_t Slot = Invalid;
+
+		bool IsValid() const { return Slot != Invalid; }
+	};
+
 	class MaterialInstance;
 
 	class Material : public RefCounted
@@ -33,16 +54,35 @@ namespace Luma {
 
 		Ref<Shader> GetShader() { return m_Shader; }
 
+		MaterialUniformHandle GetUniformHandle(Identifier name) const;
+		MaterialUniformHandle GetUniformHandle(std::string_view name) const { return GetUniformHandle(Identifier(name)); }
+		MaterialResourceHandle GetResourceHandle(Identifier name) const;
+		MaterialResourceHandle GetResourceHandle(std::string_view name) const { return GetResourceHandle(Identifier(name)); }
+
 		template <typename T>
-		void Set(const std::string& name, const T& value);
+		void Set(MaterialUniformHandle handle, const T& value);
+
+		template <typename T>
+		void Set(const std::string& name, const T& value)
+		{
+			auto handle = GetUniformHandle(name);
+			LM_CORE_ASSERT(handle.IsValid(), "Could not find uniform with name 'x'");
+			Set(handle, value);
+		}
+
+		void Set(MaterialResourceHandle handle, const Ref<Texture>& texture)
+		{
+			LM_CORE_ASSERT(handle.IsValid(), "Invalid material resource handle!");
+			if (m_Textures.size() <= handle.Slot)
+				m_Textures.resize((size_t)handle.Slot + 1);
+			m_Textures[handle.Slot] = texture;
+		}
 
 		void Set(const std::string& name, const Ref<Texture>& texture)
 		{
-			auto decl = FindResourceDeclaration(name);
-			uint32_t slot = decl->GetRegister();
-			if (m_Textures.size() <= slot)
-				m_Textures.resize((size_t)slot + 1);
-			m_Textures[slot] = texture;
+			auto handle = GetResourceHandle(name);
+			LM_CORE_ASSERT(handle.IsValid(), "Could not find resource with name 'x'");
+			Set(handle, texture);
 		}
 
 		void Set(const std::string& name, const Ref<Texture2D>& texture)
@@ -55,38 +95,58 @@ namespace Luma {
 			Set(name, (const Ref<Texture>&)texture);
 		}
 
+		template<typename T>
+		T& Get(MaterialUniformHandle handle)
+		{
+			LM_CORE_ASSERT(handle.IsValid(), "Invalid material uniform handle!");
+			const MaterialUniform& uniform = m_Uniforms[handle.Index];
+			return GetUniformBufferTarget(uniform.Domain).Read<T>(uniform.Offset);
+		}
+
 		template<typename T>
 		T& Get(const std::string& name)
 		{
-			auto decl = FindUniformDeclaration(name);
-			LM_CORE_ASSERT(decl, "Could not find uniform with name 'x'");
-			auto& buffer = GetUniformBufferTarget(decl);
-			return buffer.Read<T>(decl->GetOffset());
+			auto handle = GetUniformHandle(name);
+			LM_CORE_ASSERT(handle.IsValid(), "Could not find uniform with name 'x'");
+			return Get<T>(handle);
 		}
 
 		template<typename T>
 		Ref<T> GetResource(const std::string& name)
 		{
-			auto decl = FindResourceDeclaration(name);
-			uint32_t slot = decl->GetRegister();
-			LM_CORE_ASSERT(slot < m_Textures.size(), "Texture slot is invalid!");
-			return m_Textures[slot];
+			auto handle = GetResourceHandle(name);
+			LM_CORE_ASSERT(handle.Slot < m_Textures.size(), "Texture slot is invalid!");
+			return m_Textures[handle.Slot];
 		}
 
 		ShaderResourceDeclaration* FindResourceDeclaration(const std::string& name);
 	public:
 		static Ref<Material> Create(const Ref<Shader>& shader);
 	private:
+		// Where a material uniform lives, resolved from its declaration
+		struct MaterialUniform
+		{
+			ShaderDomain Domain;
+			uint32_t Offset;
+			uint32_t Size;
+			ShaderUniformDeclaration* Declaration;
+		};
+
 		void AllocateStorage();
+		void BuildParameterTables();
 		void OnShaderReloaded();
 		void BindTextures();
 
-		ShaderUniformDeclaration* FindUniformDeclaration(const std::string& name);
-		Buffer& GetUniformBufferTarget(ShaderUniformDeclaration* uniformDeclaration);
+		Buffer& GetUniformBufferTarget(ShaderDomain domain);
 	private:
 		Ref<Shader> m_Shader;
 		std::unordered_set<MaterialInstance*> m_MaterialInstances;
 
+		// Vertex stage uniforms first, then pixel stage. A handle is an index into m_Uniforms.
+		std::vector<MaterialUniform> m_Uniforms;
+		std::unordered_map<Identifier, uint32_t> m_UniformIndices;
+		std::unordered_map<Identifier, ShaderResourceDeclaration*> m_Resources;
+
 		Buffer m_VSUniformStorageBuffer;
 		Buffer m_PSUniformStorageBuffer;
 		std::vector<Ref<Texture>> m_Textures;
@@ -101,32 +161,53 @@ namespace Luma {
 		MaterialInstance(const Ref<Material>& material, const std::string& name = "");
 		virtual ~MaterialInstance();
 
+		MaterialUniformHandle GetUniformHandle(Identifier name) const { return m_Material->GetUniformHandle(name); }
+		MaterialUniformHandle GetUniformHandle(std::string_view name) const { return m_Material->GetUniformHandle(name); }
+		MaterialResourceHandle GetResourceHandle(Identifier name) const { return m_Material->GetResourceHandle(name); }
+		MaterialResourceHandle GetResourceHandle(std::string_view name) const { return m_Material->GetResourceHandle(name); }
+
+		template <typename T>
+		void Set(MaterialUniformHandle handle, const T& value)
+		{
+			LM_CORE_ASSERT(handle.IsValid(), "Invalid material uniform handle!");
+			const Material::MaterialUniform& uniform = m_Material->m_Uniforms[handle.Index];
+			Buffer& buffer = GetUniformBufferTarget(uniform.Domain);
+			if (memcmp((byte*)buffer.Data + uniform.Offset, &value, uniform.Size) != 0)
+			{
+				buffer.Write((byte*)&value, uniform.Size, uniform.Offset);
+				MarkDirty(uniform.Domain, uniform.Offset, uniform.Size);
+			}
+
+			m_OverriddenValues[handle.Index] = true;
+		}
+
 		template <typename T>
 		void Set(const std::string& name, const T& value)
 		{
-			auto decl = m_Material->FindUniformDeclaration(name);
-			if (!decl)
+			auto handle = m_Material->GetUniformHandle(name);
+			if (!handle.IsValid())
 				return;
-			// LM_CORE_ASSERT(decl, "Could not find uniform with name '{0}'", name);
-			LM_CORE_ASSERT(decl, "Could not find uniform with name 'x'");
-			auto& buffer = GetUniformBufferTarget(decl);
-			buffer.Write((byte*)& value, decl->GetSize(), decl->GetOffset());
 
-			m_OverriddenValues.insert(name);
+			Set(handle, value);
+		}
+
+		void Set(MaterialResourceHandle handle, const Ref<Texture>& texture)
+		{
+			LM_CORE_ASSERT(handle.IsValid(), "Invalid material resource handle!");
+			if (m_Textures.size() <= handle.Slot)
+				m_Textures.resize((size_t)handle.Slot + 1);
+			m_Textures[handle.Slot] = texture;
 		}
 
 		void Set(const std::string& name, const Ref<Texture>& texture)
 		{
-			auto decl = m_Material->FindResourceDeclaration(name);
-			if (!decl)
+			auto handle = m_Material->GetResourceHandle(name);
+			if (!handle.IsValid())
 			{
 				LM_CORE_WARN_TAG("Renderer", "Cannot find material property: ", name);
 				return;
 			}
-			uint32_t slot = decl->GetRegister();
-			if (m_Textures.size() <= slot)
-				m_Textures.resize((size_t)slot + 1);
-			m_Textures[slot] = texture;
+			Set(handle, texture);
 		}
 
 		void Set(const std::string& name, const Ref<Texture2D>& texture)
@@ -139,37 +220,41 @@ namespace Luma {
 			Set(name, (const Ref<Texture>&)texture);
 		}
 
+		template<typename T>
+		T& Get(MaterialUniformHandle handle)
+		{
+			LM_CORE_ASSERT(handle.IsValid(), "Invalid material uniform handle!");
+			const Material::MaterialUniform& uniform = m_Material->m_Uniforms[handle.Index];
+			// The value may be written through the returned reference
+			MarkDirty(uniform.Domain, uniform.Offset, uniform.Size);
+			return GetUniformBufferTarget(uniform.Domain).Read<T>(uniform.Offset);
+		}
+
 		template<typename T>
 		T& Get(const std::string& name)
 		{
-			auto decl = m_Material->FindUniformDeclaration(name);
-			LM_CORE_ASSERT(decl, "Could not find uniform with name 'x'");
-			auto& buffer = GetUniformBufferTarget(decl);
-			return buffer.Read<T>(decl->GetOffset());
+			auto handle = m_Material->GetUniformHandle(name);
+			LM_CORE_ASSERT(handle.IsValid(), "Could not find uniform with name 'x'");
+			return Get<T>(handle);
 		}
 
 		template<typename T>
 		Ref<T> GetResource(const std::string& name)
 		{
-			auto decl = m_Material->FindResourceDeclaration(name);
-			LM_CORE_ASSERT(decl, "Could not find uniform with name 'x'");
-			uint32_t slot = decl->GetRegister();
-			LM_CORE_ASSERT(slot < m_Textures.size(), "Texture slot is invalid!");
-			return Ref<T>(m_Textures[slot]);
+			auto handle = m_Material->GetResourceHandle(name);
+			LM_CORE_ASSERT(handle.IsValid(), "Could not find uniform with name 'x'");
+			LM_CORE_ASSERT(handle.Slot < m_Textures.size(), "Texture slot is invalid!");
+			return Ref<T>(m_Textures[handle.Slot]);
 		}
 
 		template<typename T>
 		Ref<T> TryGetResource(const std::string& name)
 		{
-			auto decl = m_Material->FindResourceDeclaration(name);
-			if (!decl)
+			auto handle = m_Material->GetResourceHandle(name);
+			if (!handle.IsValid() || handle.Slot >= m_Textures.size())
 				return nullptr;
 
-			uint32_t slot = decl->GetRegister();
-			if (slot >= m_Textures.size())
-				return nullptr;
-
-			return Ref<T>(m_Textures[slot]);
+			return Ref<T>(m_Textures[handle.Slot]);
 		}
 
 		void Bind();
@@ -186,8 +271,18 @@ namespace Luma {
 	private:
 		void AllocateStorage();
 		void OnShaderReloaded();
-		Buffer& GetUniformBufferTarget(ShaderUniformDeclaration* uniformDeclaration);
-		void OnMaterialValueUpdated(ShaderUniformDeclaration* decl);
+		Buffer& GetUniformBufferTarget(ShaderDomain domain);
+		void OnMaterialValueUpdated(MaterialUniformHandle handle);
+
+		// Byte range of a storage buffer written since the last Bind, empty when Begin == End
+		struct DirtyRange
+		{
+			uint32_t Begin = 0;
+			uint32_t End = 0;
+		};
+
+		void MarkDirty(ShaderDomain domain, uint32_t offset, uint32_t size);
+		MaterialUniformUpdate TakeUniformUpdate(const Buffer& buffer, DirtyRange& dirtyRange);
 	private:
 		Ref<Material> m_Material;
 		std::string m_Name;
@@ -196,20 +291,31 @@ namespace Luma {
 		Buffer m_PSUniformStorageBuffer;
 		std::vector<Ref<Texture>> m_Textures;
 
-		// TODO: This is temporary; come up with a proper system to track overrides
-		std::unordered_set<std::string> m_OverriddenValues;
+		// One bit per material uniform, indexed like MaterialUniformHandle. Overridden values are no
+		// longer updated from the material.
+		std::vector<bool> m_OverriddenValues;
+
+		DirtyRange m_VSDirtyRange;
+		DirtyRange m_PSDirtyRange;
+		// Changes with every write and is unique across instances, so a shader can tell whose data it holds
+		uint64_t m_UniformVersion = 0;
+		uint64_t m_BoundUniformVersion = 0;
+		// Bind is called while recording draw commands in parallel
+		std::mutex m_BindMutex;
 	};
 
+	LM_POOLED_REF(Material);
+	LM_POOLED_REF(MaterialInstance);
+
 	template <typename T>
-	void Material::Set(const std::string& name, const T& value)
+	void Material::Set(MaterialUniformHandle handle, const T& value)
 	{
-		auto decl = FindUniformDeclaration(name);
-		LM_CORE_ASSERT(decl, "Could not find uniform with name 'x'");
-		auto& buffer = GetUniformBufferTarget(decl);
-		buffer.Write((byte*)&value, decl->GetSize(), decl->GetOffset());
+		LM_CORE_ASSERT(handle.IsValid(), "Invalid material uniform handle!");
+		const MaterialUniform& uniform = m_Uniforms[handle.Index];
+		GetUniformBufferTarget(uniform.Domain).Write((byte*)&value, uniform.Size, uniform.Offset);
 
 		for (auto mi : m_MaterialInstances)
-			mi->OnMaterialValueUpdated(decl);
+			mi->OnMaterialValueUpdated(handle);
 	}
 
 }
\ No newline at end of file
@@ -451,11 +451,13 @@ namespace Luma {
 			LM_MESH_LOG("------------------------");
 		}
 
-		VertexBufferLayout vertexLayout;
 		if (m_IsAnimated)
 		{
 			m_VertexBuffer = VertexBuffer::Create(m_AnimatedVertices.data(), m_AnimatedVertices.size() * sizeof(AnimatedVertex));
-			vertexLayout = {
+			m_IndexBuffer = IndexBuffer::Create(m_Indices.data(), m_Indices.size() * sizeof(Index));
+
+			PipelineSpecification pipelineSpecification;
+			pipelineSpecification.Layout = {
 				{ ShaderDataType::Float3, "a_Position" },
 				{ ShaderDataType::Float3, "a_Normal" },
 				{ ShaderDataType::Float3, "a_Tangent" },
@@ -464,28 +466,18 @@ namespace Luma {
 				{ ShaderDataType::Int4, "a_BoneIDs" },
 				{ ShaderDataType::Float4, "a_BoneWeights" },
 			};
+			m_Pipeline = Pipeline::Create(pipelineSpecification);
 		}
 		else
 		{
-			m_VertexBuffer = VertexBuffer::Create(m_StaticVertices.data(), m_StaticVertices.size() * sizeof(Vertex));
-			vertexLayout = {
-				{ ShaderDataType::Float3, "a_Position" },
-				{ ShaderDataType::Float3, "a_Normal" },
-				{ ShaderDataType::Float3, "a_Tangent" },
-				{ ShaderDataType::Float3, "a_Binormal" },
-				{ ShaderDataType::Float2, "a_TexCoord" },
-			};
+			// Static geometry only lives in the pool, every static draw goes through its buffers
+			m_StaticMeshAllocation = StaticMeshPool::Allocate(m_StaticVertices.data(), (uint32_t)m_StaticVertices.size(), (const uint32_t*)m_Indices.data(), (uint32_t)m_Indices.size() * 3);
 		}
-
-		m_IndexBuffer = IndexBuffer::Create(m_Indices.data(), m_Indices.size() * sizeof(Index));
-
-		PipelineSpecification pipelineSpecification;
-		pipelineSpecification.Layout = vertexLayout;
-		m_Pipeline = Pipeline::Create(pipelineSpecification);
 	}
 
 	Mesh::~Mesh()
 	{
+		StaticMeshPool::Free(m_StaticMeshAllocation);
 	}
 
 	void Mesh::OnUpdate(Timestep ts)
@@ -1,12 +1,14 @@
 #pragma once
 
 #include "Luma/Core/TimeStep.hpp"
+#include "Luma/Core/UUID.hpp"
 
 #include "Luma/Renderer/Pipeline.hpp"
 #include "Luma/Renderer/IndexBuffer.hpp"
 #include "Luma/Renderer/VertexBuffer.hpp"
 #include "Luma/Renderer/Shader.hpp"
 #include "Luma/Renderer/Material.hpp"
+#include "Luma/Renderer/StaticMeshPool.hpp"
 
 #include "Luma/Math/AABB.hpp"
 
@@ -128,6 +130,8 @@ namespace Luma {
 		std::string NodeName, MeshName;
 	};
 
+	struct BonePalette;
+
 	class Mesh : public RefCounted
 	{
 	public:
@@ -142,11 +146,15 @@ namespace Luma {
 
 		Ref<Shader> GetMeshShader() { return m_MeshShader; }
 		Ref<Material> GetMaterial() { return m_BaseMaterial; }
-		std::vector<Ref<MaterialInstance>> GetMaterials() { return m_Materials; }
+		const std::vector<Ref<MaterialInstance>>& GetMaterials() const { return m_Materials; }
 		const std::vector<Ref<Texture2D>>& GetTextures() const { return m_Textures; }
 		const std::string& GetFilePath() const { return m_FilePath; }
+		// Unlike the address of a destroyed mesh, never reused by another one
+		UUID GetID() const { return m_ID; }
 
 		bool IsAnimated() const { return m_IsAnimated; }
+		// Valid for static meshes, they have no buffers of their own and are drawn out of the StaticMeshPool
+		const StaticMeshAllocation& GetStaticMeshAllocation() const { return m_StaticMeshAllocation; }
 
 		const std::vector<Triangle> GetTriangleCache(uint32_t index) const { return m_TriangleCache.at(index); }
 	private:
@@ -171,9 +179,11 @@ namespace Luma {
 		uint32_t m_BoneCount = 0;
 		std::vector<BoneInfo> m_BoneInfo;
 
+		// Animated meshes only
 		Ref<Pipeline> m_Pipeline;
 		Ref<VertexBuffer> m_VertexBuffer;
 		Ref<IndexBuffer> m_IndexBuffer;
+		StaticMeshAllocation m_StaticMeshAllocation;
 
 		std::vector<Vertex> m_StaticVertices;
 		std::vector<AnimatedVertex> m_AnimatedVertices;
@@ -182,6 +192,10 @@ namespace Luma {
 		std::vector<glm::mat4> m_BoneTransforms;
 		const aiScene* m_Scene;
 
+		// Bone transforms as submitted in frame m_BonePaletteFrame, shared by every pass that draws the mesh
+		BonePalette* m_BonePalette = nullptr;
+		uint64_t m_BonePaletteFrame = 0;
+
 		// Materials
 		Ref<Shader> m_MeshShader;
 		Ref<Material> m_BaseMaterial;
@@ -199,6 +213,7 @@ namespace Luma {
 		bool m_AnimationPlaying = true;
 
 		std::string m_FilePath;
+		UUID m_ID;
 
 		friend class Renderer;
 		friend class SceneHierarchyPanel;
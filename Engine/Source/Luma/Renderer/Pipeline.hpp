@@ -11,6 +11,8 @@ namespace Luma {
 	{
 		Ref<Luma::Shader> Shader;
 		VertexBufferLayout Layout;
+		// The layout describes per-instance data, which advances once per instance instead of once per vertex
+		bool Instanced = false;
 	};
 
 	class Pipeline : public RefCounted
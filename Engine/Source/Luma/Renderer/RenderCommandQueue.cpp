@@ -5,53 +5,132 @@
 
 namespace Luma {
 
-	RenderCommandQueue::RenderCommandQueue()
+	static constexpr uint64_t s_CommandAlignment = alignof(RenderCommandQueue::RenderCommandFn);
+	// Function pointer followed by the payload size, padded so the payload stays aligned
+	static constexpr uint64_t s_CommandHeaderSize = 2 * sizeof(RenderCommandQueue::RenderCommandFn);
+
+	RenderCommandQueue::RenderCommandQueue(uint64_t chunkSize)
+		: m_ChunkSize(chunkSize)
 	{
-		m_CommandBuffer = lnew uint8_t[10 * 1024 * 1024]; // 10mb buffer
-		m_CommandBufferPtr = m_CommandBuffer;
-		memset(m_CommandBuffer, 0, 10 * 1024 * 1024);
+		m_Head = AllocateChunk(m_ChunkSize);
+		m_Current = m_Head;
 	}
 
 	RenderCommandQueue::~RenderCommandQueue()
 	{
-		delete[] m_CommandBuffer;
+		Chunk* chunk = m_Head;
+		while (chunk)
+		{
+			Chunk* next = chunk->Next;
+			Allocator::Free(chunk);
+			chunk = next;
+		}
+	}
+
+	RenderCommandQueue::Chunk* RenderCommandQueue::AllocateChunk(uint64_t capacity)
+	{
+		Chunk* chunk = new (Allocator::Allocate(sizeof(Chunk) + capacity, "RenderCommandQueue")) Chunk();
+		chunk->Capacity = capacity;
+
+		m_Stats.ReservedSize += capacity;
+		m_Stats.ChunkCount++;
+		return chunk;
 	}
 
 	void* RenderCommandQueue::Allocate(RenderCommandFn fn, uint32_t size)
 	{
-		*(RenderCommandFn*)m_CommandBufferPtr = fn;
-		m_CommandBufferPtr += alignof(RenderCommandFn);
+		const uint64_t commandSize = s_CommandHeaderSize + RoundUp<uint64_t>(size, s_CommandAlignment);
+
+		if (m_Current->Used + commandSize > m_Current->Capacity)
+		{
+			// Reuse the next chunk if the command fits, otherwise insert a new one in front of it
+			Chunk* next = m_Current->Next;
+			if (!next || next->Capacity < commandSize)
+			{
+				Chunk* chunk = AllocateChunk(std::max(m_ChunkSize, commandSize));
+				chunk->Next = next;
+				m_Current->Next = chunk;
+				next = chunk;
+			}
 
-		*(uint32_t*)m_CommandBufferPtr = size;
-		m_CommandBufferPtr += RoundUp(sizeof(uint32_t), alignof(RenderCommandFn));
+			m_Current = next;
+			m_UsedChunkCount++;
+		}
+
+		uint8_t* buffer = m_Current->GetData() + m_Current->Used;
+		m_Current->Used += commandSize;
 
-		void* memory = m_CommandBufferPtr;
-		m_CommandBufferPtr += RoundUp<size_t>(size, alignof(RenderCommandFn));
+		*(RenderCommandFn*)buffer = fn;
+		*(uint32_t*)(buffer + sizeof(RenderCommandFn)) = size;
 
+		m_Size += commandSize;
 		m_CommandCount++;
-		return memory;
+		return buffer + s_CommandHeaderSize;
 	}
 
 	void RenderCommandQueue::Execute()
 	{
-		//LM_RENDER_TRACE("RenderCommandQueue::Execute -- {0} commands, {1} bytes", m_CommandCount, (m_CommandBufferPtr - m_CommandBuffer));
-
-		byte* buffer = m_CommandBuffer;
+		//LM_RENDER_TRACE("RenderCommandQueue::Execute -- {0} commands, {1} bytes", m_CommandCount, m_Size);
 
-		for (uint32_t i = 0; i < m_CommandCount; i++)
+		// Re-reads Used and m_Current on every step, commands may record more commands
+		Chunk* chunk = m_Head;
+		while (true)
 		{
-			RenderCommandFn function = *(RenderCommandFn*)buffer;
-			buffer += sizeof(RenderCommandFn);
+			uint64_t offset = 0;
+			while (offset < chunk->Used)
+			{
+				uint8_t* buffer = chunk->GetData() + offset;
 
-			uint32_t size = *(uint32_t*)buffer;
-			buffer += RoundUp(sizeof(uint32_t), alignof(RenderCommandFn));
+				RenderCommandFn function = *(RenderCommandFn*)buffer;
+				uint32_t size = *(uint32_t*)(buffer + sizeof(RenderCommandFn));
 
-			function(buffer);
-			buffer += RoundUp<size_t>(size, alignof(RenderCommandFn));
+				function(buffer + s_CommandHeaderSize);
+				offset += s_CommandHeaderSize + RoundUp<uint64_t>(size, s_CommandAlignment);
+			}
+
+			if (chunk == m_Current)
+				break;
+			chunk = chunk->Next;
 		}
 
-		m_CommandBufferPtr = m_CommandBuffer;
+		for (chunk = m_Head; chunk != m_Current->Next; chunk = chunk->Next)
+			chunk->Used = 0;
+
+		m_Stats.Size = m_Size;
+		m_Stats.CommandCount = m_CommandCount;
+		m_Stats.PeakSize = std::max(m_Stats.PeakSize, m_Size);
+		m_Stats.PeakCommandCount = std::max(m_Stats.PeakCommandCount, m_CommandCount);
+
+		m_PeakUsedChunkCount = std::max(m_PeakUsedChunkCount, m_UsedChunkCount);
+		if (++m_ExecuteCountSinceTrim >= TrimExecuteCount)
+			Trim();
+
+		m_Current = m_Head;
+		m_Size = 0;
 		m_CommandCount = 0;
+		m_UsedChunkCount = 1;
+	}
+
+	void RenderCommandQueue::Trim()
+	{
+		// Keep as many chunks as the busiest execution since the last trim needed
+		Chunk* last = m_Head;
+		for (uint32_t i = 1; i < m_PeakUsedChunkCount; i++)
+			last = last->Next;
+
+		Chunk* chunk = last->Next;
+		last->Next = nullptr;
+		while (chunk)
+		{
+			Chunk* next = chunk->Next;
+			m_Stats.ReservedSize -= chunk->Capacity;
+			m_Stats.ChunkCount--;
+			Allocator::Free(chunk);
+			chunk = next;
+		}
+
+		m_PeakUsedChunkCount = 1;
+		m_ExecuteCountSinceTrim = 0;
 	}
 
-}
\ No newline at end of file
+}
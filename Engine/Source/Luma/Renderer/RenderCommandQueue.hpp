@@ -1,24 +1,68 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 namespace Luma {
 
+	struct RenderCommandQueueStats
+	{
+		// Last execution
+		uint64_t Size = 0;
+		uint32_t CommandCount = 0;
+
+		// High-water marks since the queue was created
+		uint64_t PeakSize = 0;
+		uint32_t PeakCommandCount = 0;
+
+		uint64_t ReservedSize = 0;
+		uint32_t ChunkCount = 0;
+	};
+
+	// Commands are recorded into a linked list of chunks that grows on demand. Chunks are reused
+	// between executions, the ones that went unused for TrimExecuteCount executions are freed.
 	class RenderCommandQueue
 	{
 	public:
 		typedef void(*RenderCommandFn)(void*);
 
-		RenderCommandQueue();
+		static constexpr uint64_t ChunkSize = 256 * 1024;
+		static constexpr uint32_t TrimExecuteCount = 120;
+
+		RenderCommandQueue(uint64_t chunkSize = ChunkSize);
 		~RenderCommandQueue();
 
 		void* Allocate(RenderCommandFn func, uint32_t size);
 
+		// Commands allocated while executing are executed in the same call
 		void Execute();
+
+		const RenderCommandQueueStats& GetStats() const { return m_Stats; }
+	private:
+		struct alignas(std::max_align_t) Chunk
+		{
+			Chunk* Next = nullptr;
+			uint64_t Capacity = 0;
+			uint64_t Used = 0;
+
+			uint8_t* GetData() { return (uint8_t*)(this + 1); }
+		};
+
+		Chunk* AllocateChunk(uint64_t capacity);
+		void Trim();
 	private:
-		uint8_t* m_CommandBuffer;
-		uint8_t* m_CommandBufferPtr;
+		uint64_t m_ChunkSize;
+		Chunk* m_Head = nullptr;
+		Chunk* m_Current = nullptr;
+
+		uint64_t m_Size = 0;
 		uint32_t m_CommandCount = 0;
-	};
+		uint32_t m_UsedChunkCount = 1;
 
+		uint32_t m_PeakUsedChunkCount = 1;
+		uint32_t m_ExecuteCountSinceTrim = 0;
 
+		RenderCommandQueueStats m_Stats;
+	};
 
-}
\ No newline at end of file
+}
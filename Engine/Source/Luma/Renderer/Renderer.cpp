@@ -6,6 +6,10 @@
 #include "RendererAPI.hpp"
 #include "SceneRenderer.hpp"
 #include "Renderer2D.hpp"
+#include "StaticMeshPool.hpp"
+
+#include "Luma/Core/FrameAllocator.hpp"
+#include "Luma/Renderer/Backend/OpenGL/OpenGLState.hpp"
 
 #include <glad/glad.h>
 
@@ -16,20 +20,115 @@ namespace Luma {
 	struct RendererData
 	{
 		Ref<RenderPass> m_ActiveRenderPass;
-		RenderCommandQueue m_CommandQueue;
+		// Commands are recorded into one queue while the render thread executes the other
+		RenderCommandQueue m_CommandQueues[2];
+		std::atomic<uint32_t> m_SubmissionQueueIndex = 0;
+		const RenderCommandQueue* m_LastExecutedQueue = nullptr;
+
+		// Secondary command buffers per frame queue, the first CommandBuffersUsed are in use
+		std::mutex m_CommandBufferMutex;
+		std::vector<Scope<RenderCommandQueue>> m_CommandBuffers[2];
+		uint32_t m_CommandBuffersUsed[2] = { 0, 0 };
 		Ref<ShaderLibrary> m_ShaderLibrary;
 
 		Ref<VertexBuffer> m_FullscreenQuadVertexBuffer;
 		Ref<IndexBuffer> m_FullscreenQuadIndexBuffer;
 		Ref<Pipeline> m_FullscreenQuadPipeline;
+
+		// Per-instance transforms of static mesh draws, read as instanced vertex attributes.
+		// Only touched on the render thread, the cursor restarts (and orphans the storage) every frame.
+		RendererID m_InstanceBuffer = 0;
+		uint32_t m_InstanceBufferCapacity = 0;
+		uint32_t m_InstanceBufferCursor = 0;
+
+		// Commands of multi-draws out of the static mesh pool, streamed the same way as the instance buffer
+		RendererID m_IndirectBuffer = 0;
+		uint32_t m_IndirectBufferCapacity = 0;
+		uint32_t m_IndirectBufferCursor = 0;
+
+		// Bone palettes of animated meshes, read by the skinned shaders as a storage buffer. Render thread only,
+		// the cursor restarts every frame and a new generation starts whenever the storage gets orphaned.
+		RendererID m_BoneBuffer = 0;
+		uint32_t m_BoneBufferCapacity = 0;
+		uint32_t m_BoneBufferCursor = 0;
+		uint32_t m_BoneBufferGeneration = 1;
+		uint32_t m_BoneBufferAlignment = 0;
+
+		// Guards Mesh::m_BonePalette, meshes can be submitted from several recording threads
+		std::mutex m_BonePaletteMutex;
+	};
+
+	// Bone transforms of one animated mesh for one frame, lives in the frame arena. The render thread
+	// uploads it the first time it is drawn, the following passes only bind the range again.
+	struct BonePalette
+	{
+		const glm::mat4* Transforms = nullptr;
+		uint32_t BoneCount = 0;
+
+		// Render thread, the offset is only valid while the generation matches the bone buffer's
+		uint32_t BufferOffset = 0;
+		uint32_t BufferGeneration = 0;
 	};
 
 	static RendererData s_Data;
 
+	static constexpr uint64_t s_CommandBufferChunkSize = 64 * 1024;
+
+	// a_Transform of the static mesh shaders, a mat4 takes up locations 5 to 8
+	static constexpr uint32_t s_InstanceTransformAttribute = 5;
+	static constexpr uint32_t s_InitialInstanceCapacity = 16 * 1024;
+	static constexpr uint32_t s_InitialIndirectCapacity = 4 * 1024;
+	// BoneTransforms storage block of the skinned shaders
+	static constexpr uint32_t s_BoneTransformsBinding = 1;
+	static constexpr uint32_t s_InitialBoneBufferCapacity = 256 * 1024;
+
+	// Set while a queue executes, commands submitted from inside a command are appended to it
+	static thread_local RenderCommandQueue* s_ExecutingQueue = nullptr;
+	// Secondary command buffer the calling thread records into
+	static thread_local RenderCommandQueue* s_RecordingQueue = nullptr;
+
+	static void ExecuteQueue(RenderCommandQueue& queue)
+	{
+		RenderCommandQueue* previous = s_ExecutingQueue;
+		s_ExecutingQueue = &queue;
+		queue.Execute();
+		s_ExecutingQueue = previous;
+	}
+
+	static void ExecuteFrameQueue(uint32_t index)
+	{
+		ExecuteQueue(s_Data.m_CommandQueues[index]);
+		s_Data.m_LastExecutedQueue = &s_Data.m_CommandQueues[index];
+		s_Data.m_InstanceBufferCursor = 0;
+		s_Data.m_IndirectBufferCursor = 0;
+		s_Data.m_BoneBufferCursor = 0;
+		RendererAPI::EndFrame();
+
+		// Every secondary buffer recorded for this queue has executed with it
+		std::scoped_lock<std::mutex> lock(s_Data.m_CommandBufferMutex);
+		s_Data.m_CommandBuffersUsed[index] = 0;
+	}
+
 	void Renderer::Init()
 	{
 		s_Data.m_ShaderLibrary = Ref<ShaderLibrary>::Create();
 		Renderer::Submit([](){ RendererAPI::Init(); });
+		Renderer::Submit([]()
+		{
+			glCreateBuffers(1, &s_Data.m_InstanceBuffer);
+			s_Data.m_InstanceBufferCapacity = s_InitialInstanceCapacity;
+
+			glCreateBuffers(1, &s_Data.m_IndirectBuffer);
+			s_Data.m_IndirectBufferCapacity = s_InitialIndirectCapacity;
+
+			GLint alignment = 0;
+			glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+			glCreateBuffers(1, &s_Data.m_BoneBuffer);
+			s_Data.m_BoneBufferCapacity = s_InitialBoneBufferCapacity;
+			s_Data.m_BoneBufferAlignment = (uint32_t)std::max(alignment, 1);
+		});
+
+		StaticMeshPool::Init();
 
 		Renderer::GetShaderLibrary()->Load("Resources/Shaders/PBR_StaticMesh.glsl");
 		Renderer::GetShaderLibrary()->Load("Resources/Shaders/PBR_AnimMesh.glsl");
@@ -74,6 +173,23 @@ namespace Luma {
 		Renderer2D::Init();
 	}
 
+	void Renderer::Shutdown()
+	{
+		Renderer2D::Shutdown();
+
+		Renderer::Submit([]()
+		{
+			RendererID buffers[] = { s_Data.m_InstanceBuffer, s_Data.m_IndirectBuffer, s_Data.m_BoneBuffer };
+			for (RendererID buffer : buffers)
+				OpenGLState::OnBufferDeleted(buffer);
+			glDeleteBuffers(3, buffers);
+
+			s_Data.m_InstanceBuffer = 0;
+			s_Data.m_IndirectBuffer = 0;
+			s_Data.m_BoneBuffer = 0;
+		});
+	}
+
 	Ref<ShaderLibrary> Renderer::GetShaderLibrary()
 	{
 		return s_Data.m_ShaderLibrary;
@@ -102,10 +218,17 @@ namespace Luma {
 	{
 	}
 
-	void Renderer::DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest, bool faceCulling)
+	void Renderer::DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest, bool faceCulling, uint32_t baseVertex)
 	{
 		Submit([=]() {
-			RendererAPI::DrawIndexed(count, type, depthTest, faceCulling);
+			RendererAPI::DrawIndexed(count, type, depthTest, faceCulling, baseVertex);
+		});
+	}
+
+	void Renderer::DrawIndexedInstanced(uint32_t count, uint32_t instanceCount, PrimitiveType type, bool depthTest, bool faceCulling, uint32_t baseInstance)
+	{
+		Submit([=]() {
+			RendererAPI::DrawIndexedInstanced(count, instanceCount, type, depthTest, faceCulling, baseInstance);
 		});
 	}
 
@@ -118,7 +241,81 @@ namespace Luma {
 
 	void Renderer::WaitAndRender()
 	{
-		s_Data.m_CommandQueue.Execute();
+		ExecuteFrameQueue(GetRenderQueueSubmissionIndex());
+	}
+
+	void Renderer::SwapQueues()
+	{
+		s_Data.m_SubmissionQueueIndex = (s_Data.m_SubmissionQueueIndex + 1) % 2;
+	}
+
+	void Renderer::ExecuteRenderQueue()
+	{
+		ExecuteFrameQueue(GetRenderQueueIndex());
+	}
+
+	uint32_t Renderer::GetRenderQueueIndex()
+	{
+		return (s_Data.m_SubmissionQueueIndex + 1) % 2;
+	}
+
+	uint32_t Renderer::GetRenderQueueSubmissionIndex()
+	{
+		return s_Data.m_SubmissionQueueIndex;
+	}
+
+	RenderCommandQueue* Renderer::AllocateCommandBuffer()
+	{
+		const uint32_t index = GetRenderQueueSubmissionIndex();
+
+		std::scoped_lock<std::mutex> lock(s_Data.m_CommandBufferMutex);
+		auto& commandBuffers = s_Data.m_CommandBuffers[index];
+		uint32_t& used = s_Data.m_CommandBuffersUsed[index];
+		if (used == commandBuffers.size())
+			commandBuffers.push_back(CreateScope<RenderCommandQueue>(s_CommandBufferChunkSize));
+
+		return commandBuffers[used++].get();
+	}
+
+	RenderCommandQueue* Renderer::SetCommandBuffer(RenderCommandQueue* commandBuffer)
+	{
+		RenderCommandQueue* previous = s_RecordingQueue;
+		s_RecordingQueue = commandBuffer;
+		return previous;
+	}
+
+	void Renderer::ExecuteCommandBuffer(RenderCommandQueue* commandBuffer)
+	{
+		Submit([commandBuffer]()
+		{
+			ExecuteQueue(*commandBuffer);
+		});
+	}
+
+	bool Renderer::CanRecordInParallel()
+	{
+		// Commands recorded while executing are appended to the executing queue right away
+		return JobSystem::IsInitialized() && !s_ExecutingQueue;
+	}
+
+	RenderCommandQueueStats Renderer::GetRenderCommandQueueStats()
+	{
+		RenderCommandQueueStats stats;
+		for (const RenderCommandQueue& queue : s_Data.m_CommandQueues)
+		{
+			const RenderCommandQueueStats& queueStats = queue.GetStats();
+			stats.PeakSize = std::max(stats.PeakSize, queueStats.PeakSize);
+			stats.PeakCommandCount = std::max(stats.PeakCommandCount, queueStats.PeakCommandCount);
+			stats.ReservedSize += queueStats.ReservedSize;
+			stats.ChunkCount += queueStats.ChunkCount;
+		}
+
+		if (s_Data.m_LastExecutedQueue)
+		{
+			stats.Size = s_Data.m_LastExecutedQueue->GetStats().Size;
+			stats.CommandCount = s_Data.m_LastExecutedQueue->GetStats().CommandCount;
+		}
+		return stats;
 	}
 
 	void Renderer::BeginRenderPass(Ref<RenderPass> renderPass, bool clear)
@@ -183,16 +380,227 @@ namespace Luma {
 		DrawIndexed(6, PrimitiveType::Triangles, depthTest, cullFace);
 	}
 
+	// The palette is copied into the frame arena on the first submission of the mesh in a frame,
+	// every other pass and submesh only submits a pointer to it
+	BonePalette* Renderer::GetBonePalette(Mesh* mesh)
+	{
+		const uint64_t frameIndex = FrameAllocator::GetFrameIndex();
+
+		std::scoped_lock<std::mutex> lock(s_Data.m_BonePaletteMutex);
+		if (mesh->m_BonePalette && mesh->m_BonePaletteFrame == frameIndex)
+			return mesh->m_BonePalette;
+
+		const std::vector<glm::mat4>& boneTransforms = mesh->m_BoneTransforms;
+		glm::mat4* frameBoneTransforms = FrameAllocator::Allocate<glm::mat4>(boneTransforms.size());
+		std::copy(boneTransforms.begin(), boneTransforms.end(), frameBoneTransforms);
+
+		BonePalette* palette = new (FrameAllocator::Allocate<BonePalette>(1)) BonePalette();
+		palette->Transforms = frameBoneTransforms;
+		palette->BoneCount = (uint32_t)boneTransforms.size();
+
+		mesh->m_BonePalette = palette;
+		mesh->m_BonePaletteFrame = frameIndex;
+		return palette;
+	}
+
+	// Render thread: uploads the palette if it isn't in the bone buffer yet and binds its range
+	static void BindBonePalette(BonePalette* palette)
+	{
+		const uint32_t size = palette->BoneCount * sizeof(glm::mat4);
+		if (size == 0)
+			return;
+
+		if (palette->BufferGeneration != s_Data.m_BoneBufferGeneration)
+		{
+			uint32_t& cursor = s_Data.m_BoneBufferCursor;
+			uint32_t& capacity = s_Data.m_BoneBufferCapacity;
+			if (cursor + size > capacity)
+			{
+				capacity = std::max(capacity * 2, size);
+				cursor = 0;
+			}
+
+			// Orphan the storage instead of waiting for the draws that still read it. Palettes uploaded
+			// into the old storage are from an older generation and get uploaded again when drawn.
+			if (cursor == 0)
+			{
+				glNamedBufferData(s_Data.m_BoneBuffer, capacity, nullptr, GL_STREAM_DRAW);
+				s_Data.m_BoneBufferGeneration++;
+			}
+			glNamedBufferSubData(s_Data.m_BoneBuffer, cursor, size, palette->Transforms);
+
+			palette->BufferOffset = cursor;
+			palette->BufferGeneration = s_Data.m_BoneBufferGeneration;
+
+			const uint32_t alignment = s_Data.m_BoneBufferAlignment;
+			cursor = (cursor + size + alignment - 1) / alignment * alignment;
+		}
+
+		glBindBufferRange(GL_SHADER_STORAGE_BUFFER, s_BoneTransformsBinding, s_Data.m_BoneBuffer, palette->BufferOffset, size);
+	}
+
+	static void SetBonePalette(BonePalette* palette)
+	{
+		Renderer::Submit([palette]() {
+			BindBonePalette(palette);
+		});
+	}
+
+	// Render thread: depth test and face culling as requested by the material flags
+	static void ApplyMaterialFlags(const Ref<MaterialInstance>& material)
+	{
+		OpenGLState::SetDepthTest(material->GetFlag(MaterialFlag::DepthTest));
+		OpenGLState::SetFaceCulling(!material->GetFlag(MaterialFlag::TwoSided));
+	}
+
+	static void SubmitSubmeshDraw(const Submesh& submesh, const Ref<MaterialInstance>& material)
+	{
+		Renderer::Submit([submesh, material]() {
+			ApplyMaterialFlags(material);
+			glDrawElementsBaseVertex(GL_TRIANGLES, submesh.IndexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * submesh.BaseIndex), submesh.BaseVertex);
+			OpenGLState::CountDrawCall();
+		});
+	}
+
+	static const glm::mat4* CopyTransformToFrame(const glm::mat4& transform)
+	{
+		glm::mat4* frameTransform = FrameAllocator::Allocate<glm::mat4>(1);
+		*frameTransform = transform;
+		return frameTransform;
+	}
+
+	// Render thread: appends transforms to the instance buffer and points the instance attributes of the
+	// bound vertex array at it. Returns the index of the first instance.
+	static uint32_t UploadInstanceTransforms(const glm::mat4* transforms, uint32_t count)
+	{
+		uint32_t& cursor = s_Data.m_InstanceBufferCursor;
+		uint32_t& capacity = s_Data.m_InstanceBufferCapacity;
+		if (cursor + count > capacity)
+		{
+			capacity = std::max(capacity * 2, count);
+			cursor = 0;
+		}
+
+		// Orphan the storage instead of waiting for the draws that still read it
+		if (cursor == 0)
+			glNamedBufferData(s_Data.m_InstanceBuffer, capacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+		glNamedBufferSubData(s_Data.m_InstanceBuffer, cursor * sizeof(glm::mat4), count * sizeof(glm::mat4), transforms);
+
+		OpenGLState::BindBuffer(GL_ARRAY_BUFFER, s_Data.m_InstanceBuffer);
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			const uint32_t attribIndex = s_InstanceTransformAttribute + i;
+			glEnableVertexAttribArray(attribIndex);
+			glVertexAttribPointer(attribIndex, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (const void*)(sizeof(glm::vec4) * i));
+			glVertexAttribDivisor(attribIndex, 1);
+		}
+
+		const uint32_t baseInstance = cursor;
+		cursor += count;
+		return baseInstance;
+	}
+
+	// Static meshes always draw through the instance buffer, a single entity is one instance.
+	// Without a material the draw uses whatever shader and state are currently bound.
+	// The static mesh pool has to be bound.
+	static void SubmitSubmeshDrawInstanced(const Mesh* mesh, const Submesh& submesh, const Ref<MaterialInstance>& material, const glm::mat4* transforms, uint32_t instanceCount)
+	{
+		const StaticMeshAllocation& allocation = mesh->GetStaticMeshAllocation();
+		if (!allocation.IsValid())
+			return;
+
+		const uint32_t baseIndex = allocation.BaseIndex + submesh.BaseIndex;
+		const uint32_t baseVertex = allocation.BaseVertex + submesh.BaseVertex;
+		Renderer::Submit([material, transforms, instanceCount, indexCount = submesh.IndexCount, baseIndex, baseVertex]() {
+			if (material)
+				ApplyMaterialFlags(material);
+
+			const uint32_t baseInstance = UploadInstanceTransforms(transforms, instanceCount);
+			glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * baseIndex), instanceCount, baseVertex, baseInstance);
+			OpenGLState::CountDrawCall();
+		});
+	}
+
+	// What glMultiDrawElementsIndirect reads per draw
+	struct DrawElementsIndirectCommand
+	{
+		uint32_t Count;
+		uint32_t InstanceCount;
+		uint32_t FirstIndex;
+		int32_t BaseVertex;
+		uint32_t BaseInstance;
+	};
+
+	// BaseInstance is relative to the first transform of the multi-draw until the transforms are uploaded
+	static DrawElementsIndirectCommand* BuildIndirectCommands(const MultiDrawSubmesh* draws, uint32_t drawCount, uint32_t& instanceCount)
+	{
+		auto* commands = FrameAllocator::Allocate<DrawElementsIndirectCommand>(drawCount);
+		instanceCount = 0;
+		for (uint32_t i = 0; i < drawCount; i++)
+		{
+			const MultiDrawSubmesh& draw = draws[i];
+			const StaticMeshAllocation& allocation = draw.Mesh->GetStaticMeshAllocation();
+			LM_CORE_ASSERT(allocation.IsValid(), "Mesh is not in the static mesh pool!");
+
+			const Submesh& submesh = draw.Mesh->GetSubmeshes()[draw.SubmeshIndex];
+			commands[i].Count = submesh.IndexCount;
+			commands[i].InstanceCount = draw.InstanceCount;
+			commands[i].FirstIndex = allocation.BaseIndex + submesh.BaseIndex;
+			commands[i].BaseVertex = (int32_t)(allocation.BaseVertex + submesh.BaseVertex);
+			commands[i].BaseInstance = instanceCount;
+			instanceCount += draw.InstanceCount;
+		}
+		return commands;
+	}
+
+	// Render thread: uploads the instance transforms and the commands and issues the multi-draw.
+	// The static mesh pool has to be bound.
+	static void DrawMultiIndirect(DrawElementsIndirectCommand* commands, uint32_t drawCount, const glm::mat4* transforms, uint32_t instanceCount)
+	{
+		const uint32_t baseInstance = UploadInstanceTransforms(transforms, instanceCount);
+		for (uint32_t i = 0; i < drawCount; i++)
+			commands[i].BaseInstance += baseInstance;
+
+		uint32_t& cursor = s_Data.m_IndirectBufferCursor;
+		uint32_t& capacity = s_Data.m_IndirectBufferCapacity;
+		if (cursor + drawCount > capacity)
+		{
+			capacity = std::max(capacity * 2, drawCount);
+			cursor = 0;
+		}
+
+		if (cursor == 0)
+			glNamedBufferData(s_Data.m_IndirectBuffer, capacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_STREAM_DRAW);
+		glNamedBufferSubData(s_Data.m_IndirectBuffer, cursor * sizeof(DrawElementsIndirectCommand), drawCount * sizeof(DrawElementsIndirectCommand), commands);
+
+		OpenGLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, s_Data.m_IndirectBuffer);
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const void*)(uintptr_t)(cursor * sizeof(DrawElementsIndirectCommand)), drawCount, 0);
+		OpenGLState::CountDrawCall(drawCount);
+		cursor += drawCount;
+	}
+
+	void Renderer::BindMeshBuffers(Mesh* mesh)
+	{
+		if (!mesh->m_IsAnimated)
+		{
+			StaticMeshPool::Bind();
+			return;
+		}
+
+		mesh->m_VertexBuffer->Bind();
+		mesh->m_Pipeline->Bind();
+		mesh->m_IndexBuffer->Bind();
+	}
+
 	void Renderer::SubmitMesh(Ref<Mesh> mesh, const glm::mat4& transform, Ref<MaterialInstance> overrideMaterial)
 	{
 		// auto material = overrideMaterial ? overrideMaterial : mesh->GetMaterialInstance();
 		// auto shader = material->GetShader();
 		// TODO: Sort this out
-		mesh->m_VertexBuffer->Bind();
-		mesh->m_Pipeline->Bind();
-		mesh->m_IndexBuffer->Bind();
+		BindMeshBuffers(mesh.Raw());
 
-		auto materials = mesh->GetMaterials();
+		const auto& materials = mesh->GetMaterials();
+		BonePalette* bonePalette = mesh->m_IsAnimated ? GetBonePalette(mesh.Raw()) : nullptr;
 		for (Submesh& submesh : mesh->m_Submeshes)
 		{
 			// Material
@@ -200,56 +608,138 @@ namespace Luma {
 			auto shader = material->GetShader();
 			material->Bind();
 
-			if (mesh->m_IsAnimated)
+			if (!mesh->m_IsAnimated)
 			{
-				for (size_t i = 0; i < mesh->m_BoneTransforms.size(); i++)
-				{
-					std::string uniformName = std::string("u_BoneTransforms[") + std::to_string(i) + std::string("]");
-					shader->SetMat4(uniformName, mesh->m_BoneTransforms[i]);
-				}
+				SubmitSubmeshDrawInstanced(mesh.Raw(), submesh, material, CopyTransformToFrame(transform * submesh.Transform), 1);
+				continue;
 			}
-			shader->SetMat4("u_Transform", transform * submesh.Transform);
-
-			Submit([submesh, material]() {
-				if (material->GetFlag(MaterialFlag::DepthTest))
-					glEnable(GL_DEPTH_TEST);
-				else
-					glDisable(GL_DEPTH_TEST);
 
-				if (!material->GetFlag(MaterialFlag::TwoSided))
-					glEnable(GL_CULL_FACE);
-				else
-					glDisable(GL_CULL_FACE);
+			SetBonePalette(bonePalette);
+			shader->SetMat4("u_Transform", transform * submesh.Transform);
 
-				glDrawElementsBaseVertex(GL_TRIANGLES, submesh.IndexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * submesh.BaseIndex), submesh.BaseVertex);
-			});
+			SubmitSubmeshDraw(submesh, material);
 		}
 	}
 
-	void Renderer::SubmitMeshWithShader(Ref<Mesh> mesh, const glm::mat4& transform, Ref<Shader> shader)
+	void Renderer::SubmitSubmesh(Ref<Mesh> mesh, uint32_t submeshIndex, const glm::mat4& transform, Ref<MaterialInstance> overrideMaterial)
 	{
+		if (!mesh->m_IsAnimated)
+		{
+			SubmitSubmeshInstanced(mesh, submeshIndex, CopyTransformToFrame(transform * mesh->m_Submeshes[submeshIndex].Transform), 1, overrideMaterial);
+			return;
+		}
+
 		mesh->m_VertexBuffer->Bind();
 		mesh->m_Pipeline->Bind();
 		mesh->m_IndexBuffer->Bind();
 
+		const Submesh& submesh = mesh->m_Submeshes[submeshIndex];
+		auto material = overrideMaterial ? overrideMaterial : mesh->GetMaterials()[submesh.MaterialIndex];
+		auto shader = material->GetShader();
+		material->Bind();
+
+		SetBonePalette(GetBonePalette(mesh.Raw()));
+		shader->SetMat4("u_Transform", transform * submesh.Transform);
+
+		SubmitSubmeshDraw(submesh, material);
+	}
+
+	void Renderer::SubmitMeshWithShader(Ref<Mesh> mesh, const glm::mat4& transform, Ref<Shader> shader)
+	{
+		BindMeshBuffers(mesh.Raw());
+
+		if (!mesh->m_IsAnimated)
+			shader->Bind();
+
+		BonePalette* bonePalette = mesh->m_IsAnimated ? GetBonePalette(mesh.Raw()) : nullptr;
 		for (Submesh& submesh : mesh->m_Submeshes)
 		{
-			if (mesh->m_IsAnimated)
+			if (!mesh->m_IsAnimated)
 			{
-				for (size_t i = 0; i < mesh->m_BoneTransforms.size(); i++)
-				{
-					std::string uniformName = std::string("u_BoneTransforms[") + std::to_string(i) + std::string("]");
-					shader->SetMat4(uniformName, mesh->m_BoneTransforms[i]);
-				}
+				SubmitSubmeshDrawInstanced(mesh.Raw(), submesh, nullptr, CopyTransformToFrame(transform * submesh.Transform), 1);
+				continue;
 			}
+
+			SetBonePalette(bonePalette);
 			shader->SetMat4("u_Transform", transform * submesh.Transform);
 
 			Submit([submesh]() {
 				glDrawElementsBaseVertex(GL_TRIANGLES, submesh.IndexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * submesh.BaseIndex), submesh.BaseVertex);
+				OpenGLState::CountDrawCall();
 			});
 		}
 	}
 
+	void Renderer::SubmitSubmeshWithShader(Ref<Mesh> mesh, uint32_t submeshIndex, const glm::mat4& transform, Ref<Shader> shader)
+	{
+		if (!mesh->m_IsAnimated)
+		{
+			SubmitSubmeshInstancedWithShader(mesh, submeshIndex, CopyTransformToFrame(transform * mesh->m_Submeshes[submeshIndex].Transform), 1, shader);
+			return;
+		}
+
+		mesh->m_VertexBuffer->Bind();
+		mesh->m_Pipeline->Bind();
+		mesh->m_IndexBuffer->Bind();
+
+		const Submesh& submesh = mesh->m_Submeshes[submeshIndex];
+		SetBonePalette(GetBonePalette(mesh.Raw()));
+		shader->SetMat4("u_Transform", transform * submesh.Transform);
+
+		Submit([indexCount = submesh.IndexCount, baseIndex = submesh.BaseIndex, baseVertex = submesh.BaseVertex]() {
+			glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * baseIndex), baseVertex);
+			OpenGLState::CountDrawCall();
+		});
+	}
+
+	void Renderer::SubmitSubmeshInstanced(Ref<Mesh> mesh, uint32_t submeshIndex, const glm::mat4* transforms, uint32_t instanceCount, Ref<MaterialInstance> overrideMaterial)
+	{
+		LM_CORE_ASSERT(!mesh->m_IsAnimated, "Animated meshes can't be instanced!");
+
+		StaticMeshPool::Bind();
+
+		const Submesh& submesh = mesh->m_Submeshes[submeshIndex];
+		auto material = overrideMaterial ? overrideMaterial : mesh->GetMaterials()[submesh.MaterialIndex];
+		material->Bind();
+
+		SubmitSubmeshDrawInstanced(mesh.Raw(), submesh, material, transforms, instanceCount);
+	}
+
+	void Renderer::SubmitSubmeshInstancedWithShader(Ref<Mesh> mesh, uint32_t submeshIndex, const glm::mat4* transforms, uint32_t instanceCount, Ref<Shader> shader)
+	{
+		LM_CORE_ASSERT(!mesh->m_IsAnimated, "Animated meshes can't be instanced!");
+
+		StaticMeshPool::Bind();
+		shader->Bind();
+
+		SubmitSubmeshDrawInstanced(mesh.Raw(), mesh->m_Submeshes[submeshIndex], nullptr, transforms, instanceCount);
+	}
+
+	void Renderer::SubmitMultiDrawIndirect(const MultiDrawSubmesh* draws, uint32_t drawCount, const glm::mat4* transforms, Ref<MaterialInstance> material)
+	{
+		StaticMeshPool::Bind();
+		material->Bind();
+
+		uint32_t instanceCount = 0;
+		DrawElementsIndirectCommand* commands = BuildIndirectCommands(draws, drawCount, instanceCount);
+		Submit([material, commands, drawCount, transforms, instanceCount]() {
+			ApplyMaterialFlags(material);
+			DrawMultiIndirect(commands, drawCount, transforms, instanceCount);
+		});
+	}
+
+	void Renderer::SubmitMultiDrawIndirectWithShader(const MultiDrawSubmesh* draws, uint32_t drawCount, const glm::mat4* transforms, Ref<Shader> shader)
+	{
+		StaticMeshPool::Bind();
+		shader->Bind();
+
+		uint32_t instanceCount = 0;
+		DrawElementsIndirectCommand* commands = BuildIndirectCommands(draws, drawCount, instanceCount);
+		Submit([commands, drawCount, transforms, instanceCount]() {
+			DrawMultiIndirect(commands, drawCount, transforms, instanceCount);
+		});
+	}
+
 	void Renderer::DrawAABB(Ref<Mesh> mesh, const glm::mat4& transform, const glm::vec4& color)
 	{
 		for (Submesh& submesh : mesh->m_Submeshes)
@@ -290,7 +780,13 @@ namespace Luma {
 
 	RenderCommandQueue& Renderer::GetRenderCommandQueue()
 	{
-		return s_Data.m_CommandQueue;
+		if (s_RecordingQueue)
+			return *s_RecordingQueue;
+
+		if (s_ExecutingQueue)
+			return *s_ExecutingQueue;
+
+		return s_Data.m_CommandQueues[GetRenderQueueSubmissionIndex()];
 	}
 
 }
\ No newline at end of file
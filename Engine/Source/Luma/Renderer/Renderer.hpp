@@ -6,6 +6,7 @@
 #include "Mesh.hpp"
 
 #include "Luma/Core/Application.hpp"
+#include "Luma/Core/JobSystem.hpp"
 
 #include "RendererCapabilities.hpp"
 
@@ -15,6 +16,15 @@
 namespace Luma {
 
 	class ShaderLibrary;
+	struct BonePalette;
+
+	// Instances of one static submesh in a multi-draw, see Renderer::SubmitMultiDrawIndirect
+	struct MultiDrawSubmesh
+	{
+		const Luma::Mesh* Mesh;
+		uint32_t SubmeshIndex;
+		uint32_t InstanceCount;
+	};
 
 	class Renderer
 	{
@@ -27,6 +37,7 @@ namespace Luma {
 		}
 
 		static void Init();
+		// Submits the deletion of the renderer's own resources, runs once the render thread has terminated
 		static void Shutdown();
 
 		// static RendererCapabilities& GetCapabilities();
@@ -38,7 +49,9 @@ namespace Luma {
 		static void Clear(float r, float g, float b, float a = 1.0f);
 		static void SetClearColor(float r, float g, float b, float a);
 
-		static void DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest = true, bool faceCulling = true);
+		static void DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest = true, bool faceCulling = true, uint32_t baseVertex = 0);
+		// Per-instance attributes start at baseInstance, see PipelineSpecification::Instanced
+		static void DrawIndexedInstanced(uint32_t count, uint32_t instanceCount, PrimitiveType type, bool depthTest = true, bool faceCulling = true, uint32_t baseInstance = 0);
 
 		// For OpenGL
 		static void SetLineThickness(float thickness);
@@ -60,8 +73,57 @@ namespace Luma {
 			new (storageBuffer) FuncT(std::forward<FuncT>(func));
 		}
 
+		// Executes the submitted commands on the calling thread, used when there is no render thread
 		static void WaitAndRender();
 
+		// Calls func(index) for every index in [0, count) on the job system. Each batch of batchSize indices
+		// records into its own secondary command buffer and the buffers are executed in index order,
+		// so the commands end up in the same order as a serial loop regardless of the thread count.
+		template<typename FuncT>
+		static void RecordParallel(uint32_t count, uint32_t batchSize, FuncT&& func)
+		{
+			const uint32_t batchCount = (count + batchSize - 1) / batchSize;
+			if (batchCount <= 1 || !CanRecordInParallel())
+			{
+				for (uint32_t i = 0; i < count; i++)
+					func(i);
+				return;
+			}
+
+			std::vector<RenderCommandQueue*> commandBuffers(batchCount);
+			for (RenderCommandQueue*& commandBuffer : commandBuffers)
+				commandBuffer = AllocateCommandBuffer();
+
+			JobSystem::ParallelFor(batchCount, 1, [&](uint32_t batch)
+			{
+				RenderCommandQueue* previous = SetCommandBuffer(commandBuffers[batch]);
+				const uint32_t end = std::min(count, (batch + 1) * batchSize);
+				for (uint32_t i = batch * batchSize; i < end; i++)
+					func(i);
+				SetCommandBuffer(previous);
+			});
+
+			for (RenderCommandQueue* commandBuffer : commandBuffers)
+				ExecuteCommandBuffer(commandBuffer);
+		}
+
+		// Secondary command buffers are recycled once the frame they were recorded in has executed
+		static RenderCommandQueue* AllocateCommandBuffer();
+		// Routes Submit on the calling thread into commandBuffer, nullptr goes back to the frame queue.
+		// Returns the previous target.
+		static RenderCommandQueue* SetCommandBuffer(RenderCommandQueue* commandBuffer);
+		// Executes commandBuffer at this point of the current queue
+		static void ExecuteCommandBuffer(RenderCommandQueue* commandBuffer);
+
+		// Render thread handshake, see RenderThread
+		static void SwapQueues();
+		static void ExecuteRenderQueue();
+		static uint32_t GetRenderQueueIndex();
+		static uint32_t GetRenderQueueSubmissionIndex();
+
+		// Peaks and reserved memory across both queues, Size and CommandCount of the last executed frame
+		static RenderCommandQueueStats GetRenderCommandQueueStats();
+
 		// ~Actual~ Renderer here... TODO: remove confusion later
 		static void BeginRenderPass(Ref<RenderPass> renderPass, bool clear = true);
 		static void EndRenderPass();
@@ -69,12 +131,27 @@ namespace Luma {
 		static void SubmitQuad(Ref<MaterialInstance> material, const glm::mat4& transform = glm::mat4(1.0f));
 		static void SubmitFullscreenQuad(Ref<MaterialInstance> material);
 		static void SubmitMesh(Ref<Mesh> mesh, const glm::mat4& transform, Ref<MaterialInstance> overrideMaterial = nullptr);
+		static void SubmitSubmesh(Ref<Mesh> mesh, uint32_t submeshIndex, const glm::mat4& transform, Ref<MaterialInstance> overrideMaterial = nullptr);
 		static void SubmitMeshWithShader(Ref<Mesh> mesh, const glm::mat4& transform, Ref<Shader> shader);
+		static void SubmitSubmeshWithShader(Ref<Mesh> mesh, uint32_t submeshIndex, const glm::mat4& transform, Ref<Shader> shader);
+		// Draws instanceCount copies of a static submesh in one draw call. transforms are the final world transforms
+		// (submesh transform included) and have to stay valid until the frame has rendered, e.g. frame allocator memory.
+		static void SubmitSubmeshInstanced(Ref<Mesh> mesh, uint32_t submeshIndex, const glm::mat4* transforms, uint32_t instanceCount, Ref<MaterialInstance> overrideMaterial = nullptr);
+		static void SubmitSubmeshInstancedWithShader(Ref<Mesh> mesh, uint32_t submeshIndex, const glm::mat4* transforms, uint32_t instanceCount, Ref<Shader> shader);
+		// Draws static submeshes out of the StaticMeshPool with one multi-draw indirect call. transforms holds the
+		// instance transforms of every draw back to back. Both arrays have to stay valid until the frame has rendered,
+		// and the meshes alive until the call has been recorded.
+		static void SubmitMultiDrawIndirect(const MultiDrawSubmesh* draws, uint32_t drawCount, const glm::mat4* transforms, Ref<MaterialInstance> material);
+		static void SubmitMultiDrawIndirectWithShader(const MultiDrawSubmesh* draws, uint32_t drawCount, const glm::mat4* transforms, Ref<Shader> shader);
 
 		static void DrawAABB(const AABB& aabb, const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f));
 		static void DrawAABB(Ref<Mesh> mesh, const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f));
 	private:
 		static RenderCommandQueue& GetRenderCommandQueue();
+		static bool CanRecordInParallel();
+		static BonePalette* GetBonePalette(Mesh* mesh);
+		// Static meshes bind the StaticMeshPool, animated ones their own buffers
+		static void BindMeshBuffers(Mesh* mesh);
 	};
 
 }
\ No newline at end of file
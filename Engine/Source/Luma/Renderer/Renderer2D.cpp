@@ -4,17 +4,25 @@
 #include "Luma/Renderer/Pipeline.hpp"
 #include "Luma/Renderer/Shader.hpp"
 #include "Luma/Renderer/Renderer.hpp"
+#include "Luma/Renderer/StreamingBuffer.hpp"
+#include "Luma/Renderer/UploadBuffer.hpp"
+#include "Luma/Core/FrameAllocator.hpp"
 
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace Luma {
 
-	struct QuadVertex
+	// One per quad, the vertex shader expands it to the corners Origin + (x - 0.5) * AxisX + (y - 0.5) * AxisY
+	// with x and y in [0, 1]. TexRect holds the texture coordinates of the corners (0, 0) and (1, 1).
+	struct QuadInstance
 	{
-		glm::vec3 Position;
+		glm::vec3 Origin;
+		glm::vec3 AxisX;
+		glm::vec3 AxisY;
 		glm::vec4 Color;
-		glm::vec2 TexCoord;
+		glm::vec4 TexRect;
 		float TexIndex;
+		float TexLayer;
 		float TilingFactor;
 	};
 
@@ -32,27 +40,62 @@ namespace Luma {
 		glm::vec4 Color;
 	};
 
+	// Quads sample textures out of texture arrays. Every texture drawn gets a layer in an array shared with the
+	// textures of the same size, format and sampling, so batches only run out of slots after MaxTextureSlots layouts.
+	struct TextureAtlasArray
+	{
+		uint64_t LayoutKey;
+		Ref<Texture2DArray> Array;
+		uint32_t UsedLayerCount = 0;
+		std::vector<uint32_t> FreeLayers;
+	};
+
+	// Keyed by Texture2D::GetID, the entry goes away with the texture or when it hasn't been drawn for a while
+	struct TextureAtlasEntry
+	{
+		TextureAtlasArray* Array;
+		uint32_t Layer;
+		uint32_t DataVersion;
+		uint64_t LastUsedFrame;
+	};
+
 	struct Renderer2DData
 	{
+		// Per batch, a full batch is drawn and the next one continues where it left off
 		static const uint32_t MaxQuads = 20000;
 		static const uint32_t MaxVertices = MaxQuads * 4;
 		static const uint32_t MaxIndices = MaxQuads * 6;
 		static const uint32_t MaxTextureSlots = 32; // TODO: RenderCaps
 
+		// Arrays start small and double until they reach the layer or texel limit, then another array is started
+		static const uint32_t InitialAtlasLayers = 4;
+		static const uint32_t MaxAtlasLayers = 256;
+		static const uint32_t MaxAtlasTexels = 64 * 1024 * 1024;
+		// Textures that haven't been drawn for this many frames give their layer back
+		static const uint32_t AtlasEvictionFrames = 600;
+
 		static const uint32_t MaxLines = 10000;
 		static const uint32_t MaxLineVertices = MaxLines * 2;
-		static const uint32_t MaxLineIndices = MaxLines * 6;
+		static const uint32_t MaxLineIndices = MaxLines * 2;
+
+		// Streaming regions grow with the vertices of a frame up to this size, beyond it batches are uploaded
+		static const uint32_t MaxStreamingRegionSize = 32 * 1024 * 1024;
 
 		Ref<Pipeline> QuadPipeline;
-		Ref<VertexBuffer> QuadVertexBuffer;
+		Ref<VertexBuffer> QuadInstanceBuffer;
 		Ref<IndexBuffer> QuadIndexBuffer;
 
 		Ref<Shader> TextureShader;
 		Ref<Texture2D> WhiteTexture;
 
-		uint32_t QuadIndexCount = 0;
-		QuadVertex* QuadVertexBufferBase = nullptr;
-		QuadVertex* QuadVertexBufferPtr = nullptr;
+		// Vertices and quad instances are written straight into the mapped streaming buffers. While the region of the current frame
+		// is unavailable or full they go into upload buffers instead, which are handed to the vertex buffers.
+		Ref<StreamingBuffer> QuadStreamingBuffer, LineStreamingBuffer, CircleStreamingBuffer;
+		Ref<UploadBuffer> QuadUploadBuffer, LineUploadBuffer, CircleUploadBuffer;
+
+		uint32_t QuadInstanceCount = 0;
+		QuadInstance* QuadInstanceBufferBase = nullptr;
+		QuadInstance* QuadInstanceBufferPtr = nullptr;
 
 		Ref<Shader> CircleShader;
 		Ref<Pipeline> CirclePipeline;
@@ -61,8 +104,13 @@ namespace Luma {
 		CircleVertex* CircleVertexBufferBase = nullptr;
 		CircleVertex* CircleVertexBufferPtr = nullptr;
 
-		std::array<Ref<Texture2D>, MaxTextureSlots> TextureSlots;
-		uint32_t TextureSlotIndex = 1; // 0 = white texture
+		std::array<Ref<Texture2DArray>, MaxTextureSlots> TextureSlots;
+		uint32_t TextureSlotIndex = 1; // 0 = array of the white texture
+		float WhiteTextureLayer = 0.0f;
+
+		std::vector<std::unique_ptr<TextureAtlasArray>> AtlasArrays;
+		std::unordered_map<uint64_t, TextureAtlasEntry> AtlasEntries;
+		uint64_t AtlasEvictionFrame = 0;
 
 		glm::vec4 QuadVertexPositions[4];
 
@@ -83,23 +131,35 @@ namespace Luma {
 		Renderer2D::Statistics Stats;
 	};
 
+	// Textures can be destroyed on any thread, their IDs wait here until the next scene frees their layers.
+	// Defined before s_Data, textures destroyed along with it still find the list.
+	static std::mutex s_DestroyedTexturesMutex;
+	static std::vector<uint64_t> s_DestroyedTextures;
+	static std::atomic<bool> s_TrackDestroyedTextures = false;
+
 	static Renderer2DData s_Data;
 
 	void Renderer2D::Init()
 	{
+		s_TrackDestroyedTextures = true;
+
 		{
 			PipelineSpecification pipelineSpecification;
 			pipelineSpecification.Layout = {
-				{ ShaderDataType::Float3, "a_Position" },
+				{ ShaderDataType::Float3, "a_Origin" },
+				{ ShaderDataType::Float3, "a_AxisX" },
+				{ ShaderDataType::Float3, "a_AxisY" },
 				{ ShaderDataType::Float4, "a_Color" },
-				{ ShaderDataType::Float2, "a_TexCoord" },
+				{ ShaderDataType::Float4, "a_TexRect" },
 				{ ShaderDataType::Float, "a_TexIndex" },
+				{ ShaderDataType::Float, "a_TexLayer" },
 				{ ShaderDataType::Float, "a_TilingFactor" }
 			};
+			pipelineSpecification.Instanced = true;
 			s_Data.QuadPipeline = Pipeline::Create(pipelineSpecification);
 
-			s_Data.QuadVertexBuffer = VertexBuffer::Create(s_Data.MaxVertices * sizeof(QuadVertex));
-			s_Data.QuadVertexBufferBase = new QuadVertex[s_Data.MaxVertices];
+			s_Data.QuadInstanceBuffer = VertexBuffer::Create(s_Data.MaxQuads * sizeof(QuadInstance));
+			s_Data.QuadStreamingBuffer = StreamingBuffer::Create(s_Data.MaxQuads * sizeof(QuadInstance), s_Data.MaxStreamingRegionSize);
 
 			uint32_t* quadIndices = new uint32_t[s_Data.MaxIndices];
 
@@ -117,7 +177,7 @@ namespace Luma {
 				offset += 4;
 			}
 
-			s_Data.QuadIndexBuffer = IndexBuffer::Create(quadIndices, s_Data.MaxIndices);
+			s_Data.QuadIndexBuffer = IndexBuffer::Create(quadIndices, s_Data.MaxIndices * sizeof(uint32_t));
 			delete[] quadIndices;
 		}
 
@@ -129,9 +189,6 @@ namespace Luma {
 
 		s_Data.TextureShader = Shader::Create("Resources/Shaders/Renderer2D.glsl");
 
-		// Set all texture slots to 0
-		s_Data.TextureSlots[0] = s_Data.WhiteTexture;
-
 		s_Data.QuadVertexPositions[0] = { -0.5f, -0.5f, 0.0f, 1.0f };
 		s_Data.QuadVertexPositions[1] = {  0.5f, -0.5f, 0.0f, 1.0f };
 		s_Data.QuadVertexPositions[2] = {  0.5f,  0.5f, 0.0f, 1.0f };
@@ -149,13 +206,13 @@ namespace Luma {
 			s_Data.LinePipeline = Pipeline::Create(pipelineSpecification);
 
 			s_Data.LineVertexBuffer = VertexBuffer::Create(s_Data.MaxLineVertices * sizeof(LineVertex));
-			s_Data.LineVertexBufferBase = new LineVertex[s_Data.MaxLineVertices];
+			s_Data.LineStreamingBuffer = StreamingBuffer::Create(s_Data.MaxLineVertices * sizeof(LineVertex), s_Data.MaxStreamingRegionSize);
 
 			uint32_t* lineIndices = new uint32_t[s_Data.MaxLineIndices];
 			for (uint32_t i = 0; i < s_Data.MaxLineIndices; i++)
 				lineIndices[i] = i;
 
-			s_Data.LineIndexBuffer = IndexBuffer::Create(lineIndices, s_Data.MaxLineIndices);
+			s_Data.LineIndexBuffer = IndexBuffer::Create(lineIndices, s_Data.MaxLineIndices * sizeof(uint32_t));
 			delete[] lineIndices;
 		}
 
@@ -172,234 +229,384 @@ namespace Luma {
 			};
 			s_Data.CirclePipeline = Pipeline::Create(pipelineSpecification);
 
-			s_Data.CircleVertexBuffer = VertexBuffer::Create(s_Data.MaxVertices * sizeof(QuadVertex));
-			s_Data.CircleVertexBufferBase = new CircleVertex[s_Data.MaxVertices];
+			s_Data.CircleVertexBuffer = VertexBuffer::Create(s_Data.MaxVertices * sizeof(CircleVertex));
+			s_Data.CircleStreamingBuffer = StreamingBuffer::Create(s_Data.MaxVertices * sizeof(CircleVertex), s_Data.MaxStreamingRegionSize);
 		}
 	}
 
 	void Renderer2D::Shutdown()
 	{
+		s_Data.QuadUploadBuffer = nullptr;
+		s_Data.LineUploadBuffer = nullptr;
+		s_Data.CircleUploadBuffer = nullptr;
+
+		s_Data.QuadStreamingBuffer = nullptr;
+		s_Data.LineStreamingBuffer = nullptr;
+		s_Data.CircleStreamingBuffer = nullptr;
+
+		s_Data.TextureSlots = {};
+		s_Data.AtlasEntries.clear();
+		s_Data.AtlasArrays.clear();
+
+		s_TrackDestroyedTextures = false;
+		std::scoped_lock<std::mutex> lock(s_DestroyedTexturesMutex);
+		s_DestroyedTextures.clear();
 	}
 
-	void Renderer2D::BeginScene(const glm::mat4& viewProj, bool depthTest)
+	void Renderer2D::OnTextureDestroyed(uint64_t textureID)
 	{
-		s_Data.CameraViewProj = viewProj;
-		s_Data.DepthTest = depthTest;
+		if (!s_TrackDestroyedTextures)
+			return;
 
-		s_Data.TextureShader->Bind();
-		s_Data.TextureShader->SetMat4("u_ViewProjection", viewProj);
+		std::scoped_lock<std::mutex> lock(s_DestroyedTexturesMutex);
+		s_DestroyedTextures.push_back(textureID);
+	}
 
-		s_Data.QuadIndexCount = 0;
-		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
+	template<typename VertexT>
+	static VertexT* BeginVertices(Ref<StreamingBuffer>& streamingBuffer, Ref<UploadBuffer>& uploadBuffer, uint32_t maxVertices)
+	{
+		if (void* data = streamingBuffer->Map(maxVertices * sizeof(VertexT)))
+			return (VertexT*)data;
 
-		s_Data.LineIndexCount = 0;
-		s_Data.LineVertexBufferPtr = s_Data.LineVertexBufferBase;
+		uploadBuffer = UploadBuffer::Create(maxVertices * sizeof(VertexT));
+		return (VertexT*)uploadBuffer->GetWriteableData();
+	}
 
-		s_Data.CircleIndexCount = 0;
-		s_Data.CircleVertexBufferPtr = s_Data.CircleVertexBufferBase;
+	// Ends writing a batch and binds the buffer holding its vertices, returns the base vertex to draw with
+	template<typename VertexT>
+	static uint32_t EndVertices(Ref<StreamingBuffer>& streamingBuffer, Ref<UploadBuffer>& uploadBuffer, Ref<VertexBuffer>& vertexBuffer, uint32_t dataSize)
+	{
+		if (uploadBuffer)
+		{
+			if (dataSize)
+			{
+				vertexBuffer->SetData(uploadBuffer, dataSize);
+				vertexBuffer->Bind();
+			}
 
-		s_Data.TextureSlotIndex = 1;
+			// The render commands keep the submitted upload buffer alive until they have executed
+			uploadBuffer = nullptr;
+			return 0;
+		}
+
+		const uint32_t offset = streamingBuffer->Unmap(dataSize);
+		if (dataSize)
+			streamingBuffer->Bind();
+		return offset / sizeof(VertexT);
 	}
 
-	void Renderer2D::EndScene()
+	static void AllocateAtlasLayer(const Ref<Texture2D>& texture, uint64_t layoutKey, TextureAtlasEntry& entry)
 	{
-		uint32_t dataSize = (uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase;
-		if (dataSize)
+		const uint32_t texelCount = texture->GetWidth() * texture->GetHeight();
+		const uint32_t maxLayers = std::clamp(Renderer2DData::MaxAtlasTexels / texelCount, 1u, Renderer2DData::MaxAtlasLayers);
+
+		for (auto& atlasArray : s_Data.AtlasArrays)
 		{
-			s_Data.QuadVertexBuffer->SetData(s_Data.QuadVertexBufferBase, dataSize);
+			if (atlasArray->LayoutKey != layoutKey)
+				continue;
 
-			s_Data.TextureShader->Bind();
-			s_Data.TextureShader->SetMat4("u_ViewProjection", s_Data.CameraViewProj);
+			if (!atlasArray->FreeLayers.empty())
+			{
+				entry.Array = atlasArray.get();
+				entry.Layer = atlasArray->FreeLayers.back();
+				atlasArray->FreeLayers.pop_back();
+				return;
+			}
 
-			for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
-				s_Data.TextureSlots[i]->Bind(i);
+			if (atlasArray->UsedLayerCount < maxLayers)
+			{
+				const uint32_t layerCount = atlasArray->Array->GetLayerCount();
+				if (atlasArray->UsedLayerCount == layerCount)
+					atlasArray->Array->Resize(std::min(layerCount * 2, maxLayers));
 
-			s_Data.QuadVertexBuffer->Bind();
-			s_Data.QuadPipeline->Bind();
-			s_Data.QuadIndexBuffer->Bind();
-			Renderer::DrawIndexed(s_Data.QuadIndexCount, PrimitiveType::Triangles, s_Data.DepthTest, false);
-			s_Data.Stats.DrawCalls++;
+				entry.Array = atlasArray.get();
+				entry.Layer = atlasArray->UsedLayerCount++;
+				return;
+			}
 		}
 
-		dataSize = (uint8_t*)s_Data.LineVertexBufferPtr - (uint8_t*)s_Data.LineVertexBufferBase;
-		if (dataSize)
-		{
-			s_Data.LineVertexBuffer->SetData(s_Data.LineVertexBufferBase, dataSize);
+		TextureAtlasArray* atlasArray = s_Data.AtlasArrays.emplace_back(std::make_unique<TextureAtlasArray>()).get();
+		atlasArray->LayoutKey = layoutKey;
+		atlasArray->Array = Texture2DArray::Create(texture, std::min(Renderer2DData::InitialAtlasLayers, maxLayers));
+		atlasArray->UsedLayerCount = 1;
 
-			s_Data.LineShader->Bind();
-			s_Data.LineShader->SetMat4("u_ViewProjection", s_Data.CameraViewProj);
+		entry.Array = atlasArray;
+		entry.Layer = 0;
+	}
 
-			s_Data.LineVertexBuffer->Bind();
-			s_Data.LinePipeline->Bind();
-			s_Data.LineIndexBuffer->Bind();
-			Renderer::SetLineThickness(2.0f);
-			Renderer::DrawIndexed(s_Data.LineIndexCount, PrimitiveType::Lines, false, false);
-			s_Data.Stats.DrawCalls++;
+	// Layer of texture, copied in on first use and again whenever the texture data changes
+	static const TextureAtlasEntry& GetAtlasEntry(const Ref<Texture2D>& texture)
+	{
+		auto it = s_Data.AtlasEntries.find(texture->GetID());
+		if (it == s_Data.AtlasEntries.end())
+		{
+			// Textures that failed to load have nothing to copy and are drawn white
+			const uint64_t layoutKey = Texture2DArray::GetLayoutKey(texture);
+			if (!layoutKey)
+				return GetAtlasEntry(s_Data.WhiteTexture);
+
+			TextureAtlasEntry entry;
+			AllocateAtlasLayer(texture, layoutKey, entry);
+			entry.DataVersion = texture->GetDataVersion();
+			entry.Array->Array->CopyLayer(entry.Layer, texture);
+			it = s_Data.AtlasEntries.emplace(texture->GetID(), entry).first;
+		}
+		else if (it->second.DataVersion != texture->GetDataVersion())
+		{
+			it->second.DataVersion = texture->GetDataVersion();
+			it->second.Array->Array->CopyLayer(it->second.Layer, texture);
 		}
 
-		dataSize = (uint8_t*)s_Data.CircleVertexBufferPtr - (uint8_t*)s_Data.CircleVertexBufferBase;
-		if (dataSize)
+		it->second.LastUsedFrame = FrameAllocator::GetFrameIndex();
+		return it->second;
+	}
+
+	// Draws that still sample a freed layer have been submitted before any copy that reuses it
+	static void EvictAtlasEntries()
+	{
 		{
-			s_Data.CircleVertexBuffer->SetData(s_Data.CircleVertexBufferBase, dataSize);
+			std::scoped_lock<std::mutex> lock(s_DestroyedTexturesMutex);
+			for (uint64_t textureID : s_DestroyedTextures)
+			{
+				auto it = s_Data.AtlasEntries.find(textureID);
+				if (it == s_Data.AtlasEntries.end())
+					continue;
+
+				it->second.Array->FreeLayers.push_back(it->second.Layer);
+				s_Data.AtlasEntries.erase(it);
+			}
+			s_DestroyedTextures.clear();
+		}
 
-			s_Data.CircleShader->Bind();
-			s_Data.CircleShader->SetMat4("u_ViewProjection", s_Data.CameraViewProj);
+		const uint64_t frameIndex = FrameAllocator::GetFrameIndex();
+		if (frameIndex < s_Data.AtlasEvictionFrame + Renderer2DData::AtlasEvictionFrames)
+			return;
+		s_Data.AtlasEvictionFrame = frameIndex;
 
-			s_Data.CircleVertexBuffer->Bind();
-			s_Data.CirclePipeline->Bind();
-			s_Data.QuadIndexBuffer->Bind();
-			Renderer::DrawIndexed(s_Data.CircleIndexCount, PrimitiveType::Triangles, false, false);
-			s_Data.Stats.DrawCalls++;
+		for (auto it = s_Data.AtlasEntries.begin(); it != s_Data.AtlasEntries.end();)
+		{
+			if (frameIndex - it->second.LastUsedFrame >= Renderer2DData::AtlasEvictionFrames)
+			{
+				it->second.Array->FreeLayers.push_back(it->second.Layer);
+				it = s_Data.AtlasEntries.erase(it);
+			}
+			else
+			{
+				++it;
+			}
 		}
+	}
 
-#if OLD
-		Flush();
-#endif
+	static void StartQuadBatch()
+	{
+		s_Data.QuadInstanceCount = 0;
+		s_Data.QuadInstanceBufferBase = BeginVertices<QuadInstance>(s_Data.QuadStreamingBuffer, s_Data.QuadUploadBuffer, s_Data.MaxQuads);
+		s_Data.QuadInstanceBufferPtr = s_Data.QuadInstanceBufferBase;
+
+		const TextureAtlasEntry& whiteTexture = GetAtlasEntry(s_Data.WhiteTexture);
+		s_Data.TextureSlots[0] = whiteTexture.Array->Array;
+		s_Data.WhiteTextureLayer = (float)whiteTexture.Layer;
+		s_Data.TextureSlotIndex = 1;
 	}
 
-	void Renderer2D::Flush()
+	static void StartLineBatch()
+	{
+		s_Data.LineIndexCount = 0;
+		s_Data.LineVertexBufferBase = BeginVertices<LineVertex>(s_Data.LineStreamingBuffer, s_Data.LineUploadBuffer, s_Data.MaxLineVertices);
+		s_Data.LineVertexBufferPtr = s_Data.LineVertexBufferBase;
+	}
+
+	static void StartCircleBatch()
+	{
+		s_Data.CircleIndexCount = 0;
+		s_Data.CircleVertexBufferBase = BeginVertices<CircleVertex>(s_Data.CircleStreamingBuffer, s_Data.CircleUploadBuffer, s_Data.MaxVertices);
+		s_Data.CircleVertexBufferPtr = s_Data.CircleVertexBufferBase;
+	}
+
+	static void FlushQuads()
 	{
-#if OLD
-		// Bind textures
+		uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.QuadInstanceBufferPtr - (uint8_t*)s_Data.QuadInstanceBufferBase);
+		uint32_t baseInstance = EndVertices<QuadInstance>(s_Data.QuadStreamingBuffer, s_Data.QuadUploadBuffer, s_Data.QuadInstanceBuffer, dataSize);
+		if (!dataSize)
+			return;
+
+		s_Data.TextureShader->Bind();
+		s_Data.TextureShader->SetMat4("u_ViewProjection", s_Data.CameraViewProj);
+
 		for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
 			s_Data.TextureSlots[i]->Bind(i);
 
-		s_Data.QuadVertexArray->Bind();
-		Renderer::DrawIndexed(s_Data.QuadIndexCount, false);
+		s_Data.QuadPipeline->Bind();
+		s_Data.QuadIndexBuffer->Bind();
+		// The first six indices of the quad index buffer are the corners 0-3, which the shader expands every instance to
+		Renderer::DrawIndexedInstanced(6, s_Data.QuadInstanceCount, PrimitiveType::Triangles, s_Data.DepthTest, false, baseInstance);
 		s_Data.Stats.DrawCalls++;
-#endif
 	}
 
-	void Renderer2D::FlushAndReset()
+	static void FlushLines()
 	{
-		EndScene();
+		uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.LineVertexBufferPtr - (uint8_t*)s_Data.LineVertexBufferBase);
+		uint32_t baseVertex = EndVertices<LineVertex>(s_Data.LineStreamingBuffer, s_Data.LineUploadBuffer, s_Data.LineVertexBuffer, dataSize);
+		if (!dataSize)
+			return;
+
+		s_Data.LineShader->Bind();
+		s_Data.LineShader->SetMat4("u_ViewProjection", s_Data.CameraViewProj);
+
+		s_Data.LinePipeline->Bind();
+		s_Data.LineIndexBuffer->Bind();
+		Renderer::SetLineThickness(2.0f);
+		Renderer::DrawIndexed(s_Data.LineIndexCount, PrimitiveType::Lines, false, false, baseVertex);
+		s_Data.Stats.DrawCalls++;
+	}
+
+	static void FlushCircles()
+	{
+		uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.CircleVertexBufferPtr - (uint8_t*)s_Data.CircleVertexBufferBase);
+		uint32_t baseVertex = EndVertices<CircleVertex>(s_Data.CircleStreamingBuffer, s_Data.CircleUploadBuffer, s_Data.CircleVertexBuffer, dataSize);
+		if (!dataSize)
+			return;
 
-		s_Data.QuadIndexCount = 0;
-		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
+		s_Data.CircleShader->Bind();
+		s_Data.CircleShader->SetMat4("u_ViewProjection", s_Data.CameraViewProj);
 
-		s_Data.TextureSlotIndex = 1;
+		s_Data.CirclePipeline->Bind();
+		s_Data.QuadIndexBuffer->Bind();
+		Renderer::DrawIndexed(s_Data.CircleIndexCount, PrimitiveType::Triangles, false, false, baseVertex);
+		s_Data.Stats.DrawCalls++;
 	}
 
-	void Renderer2D::FlushAndResetLines()
+	// A full batch only flushes its own primitive type, the others keep batching
+	static void NextQuadBatch()
 	{
+		FlushQuads();
+		StartQuadBatch();
 	}
 
-	void Renderer2D::DrawQuad(const glm::mat4& transform, const glm::vec4& color)
+	static void NextLineBatch()
 	{
-		constexpr size_t quadVertexCount = 4;
-		const float textureIndex = 0.0f; // White Texture
-		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-		const float tilingFactor = 1.0f;
+		FlushLines();
+		StartLineBatch();
+	}
+
+	static void NextCircleBatch()
+	{
+		FlushCircles();
+		StartCircleBatch();
+	}
 
-		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
-			FlushAndReset();
+	// Slot of the array holding texture in the current quad batch and the layer of texture in it,
+	// starts a new batch once all slots are taken
+	static float GetTextureIndex(const Ref<Texture2D>& texture, float& textureLayer)
+	{
+		const TextureAtlasEntry& entry = GetAtlasEntry(texture);
+		textureLayer = (float)entry.Layer;
 
-		for (size_t i = 0; i < quadVertexCount; i++)
+		const Texture2DArray* textureArray = entry.Array->Array.Raw();
+		for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
 		{
-			s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[i];
-			s_Data.QuadVertexBufferPtr->Color = color;
-			s_Data.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-			s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-			s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-			s_Data.QuadVertexBufferPtr++;
+			if (s_Data.TextureSlots[i].Raw() == textureArray)
+				return (float)i;
 		}
 
-		s_Data.QuadIndexCount += 6;
+		if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
+			NextQuadBatch();
 
-		s_Data.Stats.QuadCount++;
+		float textureIndex = (float)s_Data.TextureSlotIndex;
+		s_Data.TextureSlots[s_Data.TextureSlotIndex] = entry.Array->Array;
+		s_Data.TextureSlotIndex++;
+		return textureIndex;
 	}
 
-	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
+	void Renderer2D::BeginScene(const glm::mat4& viewProj, bool depthTest)
 	{
-		constexpr size_t quadVertexCount = 4;
-		constexpr glm::vec4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
-		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+		s_Data.CameraViewProj = viewProj;
+		s_Data.DepthTest = depthTest;
 
-		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
-			FlushAndReset();
+		EvictAtlasEntries();
 
-		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-		{
-			if (*s_Data.TextureSlots[i].Raw() == *texture.Raw())
-			{
-				textureIndex = (float)i;
-				break;
-			}
-		}
+		StartQuadBatch();
+		StartLineBatch();
+		StartCircleBatch();
+	}
 
-		if (textureIndex == 0.0f)
-		{
-			if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
-				FlushAndReset();
+	void Renderer2D::EndScene()
+	{
+		FlushQuads();
+		FlushLines();
+		FlushCircles();
 
-			textureIndex = (float)s_Data.TextureSlotIndex;
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-			s_Data.TextureSlotIndex++;
-		}
+		s_Data.QuadStreamingBuffer->Fence();
+		s_Data.LineStreamingBuffer->Fence();
+		s_Data.CircleStreamingBuffer->Fence();
+	}
 
-		for (size_t i = 0; i < quadVertexCount; i++)
-		{
-			s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[i];
-			s_Data.QuadVertexBufferPtr->Color = color;
-			s_Data.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-			s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-			s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-			s_Data.QuadVertexBufferPtr++;
-		}
+	void Renderer2D::Flush()
+	{
+		NextQuadBatch();
+		NextLineBatch();
+		NextCircleBatch();
+	}
 
-		s_Data.QuadIndexCount += 6;
+	// Makes room for a quad, texture slots have to be looked up afterwards as a new batch resets them
+	static void ReserveQuad()
+	{
+		if (s_Data.QuadInstanceCount >= Renderer2DData::MaxQuads)
+			NextQuadBatch();
+	}
 
+	static void WriteQuad(const glm::vec3& origin, const glm::vec3& axisX, const glm::vec3& axisY, const glm::vec4& color, float textureIndex, float textureLayer, float tilingFactor)
+	{
+		QuadInstance* instance = s_Data.QuadInstanceBufferPtr++;
+		instance->Origin = origin;
+		instance->AxisX = axisX;
+		instance->AxisY = axisY;
+		instance->Color = color;
+		instance->TexRect = { 0.0f, 0.0f, 1.0f, 1.0f };
+		instance->TexIndex = textureIndex;
+		instance->TexLayer = textureLayer;
+		instance->TilingFactor = tilingFactor;
+
+		s_Data.QuadInstanceCount++;
 		s_Data.Stats.QuadCount++;
 	}
 
-	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
+	// The unit quad lies in the xy plane, so an affine transform is fully described by its first, second and last column
+	static void WriteQuad(const glm::mat4& transform, const glm::vec4& color, float textureIndex, float textureLayer, float tilingFactor)
 	{
-		DrawQuad({ position.x, position.y, 0.0f }, size, color);
+		WriteQuad(glm::vec3(transform[3]), glm::vec3(transform[0]), glm::vec3(transform[1]), color, textureIndex, textureLayer, tilingFactor);
 	}
 
-	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
+	static void WriteRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color, float textureIndex, float textureLayer, float tilingFactor)
 	{
-		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
-			FlushAndReset();
+		const float c = glm::cos(rotation);
+		const float s = glm::sin(rotation);
+		WriteQuad(position, { c * size.x, s * size.x, 0.0f }, { -s * size.y, c * size.y, 0.0f }, color, textureIndex, textureLayer, tilingFactor);
+	}
 
-		const float textureIndex = 0.0f; // White Texture
-		const float tilingFactor = 1.0f;
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const glm::vec4& color)
+	{
+		ReserveQuad();
+		WriteQuad(transform, color, 0.0f, s_Data.WhiteTextureLayer, 1.0f);
+	}
 
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
-			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
+	{
+		ReserveQuad();
+		float textureLayer;
+		const float textureIndex = GetTextureIndex(texture, textureLayer);
+		WriteQuad(transform, tintColor, textureIndex, textureLayer, tilingFactor);
+	}
 
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[0];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 0.0f, 0.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[1];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 1.0f, 0.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[2];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 1.0f, 1.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[3];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 0.0f, 1.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadIndexCount += 6;
+	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
+	{
+		DrawQuad({ position.x, position.y, 0.0f }, size, color);
+	}
 
-		s_Data.Stats.QuadCount++;
+	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
+	{
+		ReserveQuad();
+		WriteQuad(position, { size.x, 0.0f, 0.0f }, { 0.0f, size.y, 0.0f }, color, 0.0f, s_Data.WhiteTextureLayer, 1.0f);
 	}
 
 	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
@@ -409,62 +616,10 @@ namespace Luma {
 
 	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
 	{
-		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
-			FlushAndReset();
-
-		constexpr glm::vec4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-		{
-			if (*s_Data.TextureSlots[i].Raw() == *texture.Raw())
-			{
-				textureIndex = (float)i;
-				break;
-			}
-		}
-
-		if (textureIndex == 0.0f)
-		{
-			textureIndex = (float)s_Data.TextureSlotIndex;
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-			s_Data.TextureSlotIndex++;
-		}
-
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
-			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[0];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 0.0f, 0.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[1];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 1.0f, 0.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[2];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 1.0f, 1.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[3];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 0.0f, 1.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadIndexCount += 6;
-
-		s_Data.Stats.QuadCount++;
+		ReserveQuad();
+		float textureLayer;
+		const float textureIndex = GetTextureIndex(texture, textureLayer);
+		WriteQuad(position, { size.x, 0.0f, 0.0f }, { 0.0f, size.y, 0.0f }, tintColor, textureIndex, textureLayer, tilingFactor);
 	}
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color)
@@ -474,47 +629,8 @@ namespace Luma {
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color)
 	{
-		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
-			FlushAndReset();
-
-		const float textureIndex = 0.0f; // White Texture
-		const float tilingFactor = 1.0f;
-
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
-			* glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
-			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[0];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 0.0f, 0.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[1];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 1.0f, 0.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[2];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 1.0f, 1.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[3];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 0.0f, 1.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadIndexCount += 6;
-
-		s_Data.Stats.QuadCount++;
+		ReserveQuad();
+		WriteRotatedQuad(position, size, rotation, color, 0.0f, s_Data.WhiteTextureLayer, 1.0f);
 	}
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
@@ -524,63 +640,10 @@ namespace Luma {
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
 	{
-		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
-			FlushAndReset();
-
-		constexpr glm::vec4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-		{
-			if (*s_Data.TextureSlots[i].Raw() == *texture.Raw())
-			{
-				textureIndex = (float)i;
-				break;
-			}
-		}
-
-		if (textureIndex == 0.0f)
-		{
-			textureIndex = (float)s_Data.TextureSlotIndex;
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-			s_Data.TextureSlotIndex++;
-		}
-
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
-			* glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
-			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[0];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 0.0f, 0.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[1];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 1.0f, 0.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[2];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 1.0f, 1.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[3];
-		s_Data.QuadVertexBufferPtr->Color = color;
-		s_Data.QuadVertexBufferPtr->TexCoord = { 0.0f, 1.0f };
-		s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-		s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-		s_Data.QuadVertexBufferPtr++;
-
-		s_Data.QuadIndexCount += 6;
-
-		s_Data.Stats.QuadCount++;
+		ReserveQuad();
+		float textureLayer;
+		const float textureIndex = GetTextureIndex(texture, textureLayer);
+		WriteRotatedQuad(position, size, rotation, tintColor, textureIndex, textureLayer, tilingFactor);
 	}
 
 	void Renderer2D::DrawRotatedRect(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color)
@@ -590,9 +653,6 @@ namespace Luma {
 
 	void Renderer2D::DrawRotatedRect(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color)
 	{
-		if (s_Data.LineIndexCount >= Renderer2DData::MaxLineIndices)
-			FlushAndResetLines();
-
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
 			* glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
 			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
@@ -606,21 +666,7 @@ namespace Luma {
 		};
 
 		for (int i = 0; i < 4; i++)
-		{
-			auto& v0 = positions[i];
-			auto& v1 = positions[(i + 1) % 4];
-
-			s_Data.LineVertexBufferPtr->Position = v0;
-			s_Data.LineVertexBufferPtr->Color = color;
-			s_Data.LineVertexBufferPtr++;
-
-			s_Data.LineVertexBufferPtr->Position = v1;
-			s_Data.LineVertexBufferPtr->Color = color;
-			s_Data.LineVertexBufferPtr++;
-
-			s_Data.LineIndexCount += 2;
-			s_Data.Stats.LineCount++;
-		}
+			DrawLine(positions[i], positions[(i + 1) % 4], color);
 	}
 
 	void Renderer2D::DrawCircle(const glm::vec2& position, float radius, const glm::vec4& color, float thickness)
@@ -631,7 +677,7 @@ namespace Luma {
 	void Renderer2D::DrawCircle(const glm::vec3& position, float radius, const glm::vec4& color, float thickness)
 	{
 		if (s_Data.CircleIndexCount >= Renderer2DData::MaxIndices)
-			FlushAndReset();
+			NextCircleBatch();
 
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
 			* glm::scale(glm::mat4(1.0f), { radius * 2.0f, radius * 2.0f, 1.0f });
@@ -643,16 +689,16 @@ namespace Luma {
 			s_Data.CircleVertexBufferPtr->LocalPosition = s_Data.QuadVertexPositions[i] * 2.0f;
 			s_Data.CircleVertexBufferPtr->Color = color;
 			s_Data.CircleVertexBufferPtr++;
-
-			s_Data.CircleIndexCount += 6;
-			s_Data.Stats.QuadCount++;
 		}
+
+		s_Data.CircleIndexCount += 6;
+		s_Data.Stats.QuadCount++;
 	}
 
 	void Renderer2D::DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color)
 	{
 		if (s_Data.LineIndexCount >= Renderer2DData::MaxLineIndices)
-			FlushAndResetLines();
+			NextLineBatch();
 
 		s_Data.LineVertexBufferPtr->Position = p0;
 		s_Data.LineVertexBufferPtr->Color = color;
@@ -12,8 +12,12 @@ namespace Luma {
 		static void Init();
 		static void Shutdown();
 
+		// Any thread, the layer the texture had in a texture array is freed when the next scene begins
+		static void OnTextureDestroyed(uint64_t textureID);
+
 		static void BeginScene(const glm::mat4& viewProj, bool depthTest = true);
 		static void EndScene();
+		// Draws what has been batched so far, batching continues afterwards
 		static void Flush();
 
 		// Primitives
@@ -50,9 +54,6 @@ namespace Luma {
 		};
 		static void ResetStats();
 		static Statistics GetStats();
-	private:
-		static void FlushAndReset();
-		static void FlushAndResetLines();
 	};
 
 }
\ No newline at end of file
@@ -26,6 +26,22 @@ namespace Luma {
 		int MaxTextureUnits = 0;
 	};
 
+	// State changes of the last executed frame, counted on the thread executing render commands
+	struct RenderAPIStats
+	{
+		uint32_t ProgramSwitches = 0;
+		uint32_t VertexArraySwitches = 0;
+		uint32_t TextureSwitches = 0;
+		// Calls filtered out by the state cache because nothing would have changed
+		uint32_t RedundantBinds = 0;
+		uint32_t RedundantStateChanges = 0;
+		uint32_t MaterialUploads = 0;
+		uint32_t MaterialUploadsSkipped = 0;
+		// glDraw* calls, a multi-draw counts once in DrawCalls and once per command in Draws
+		uint32_t DrawCalls = 0;
+		uint32_t Draws = 0;
+	};
+
 	class RendererAPI
 	{
 	public:
@@ -35,9 +51,14 @@ namespace Luma {
 		static void Clear(float r, float g, float b, float a);
 		static void SetClearColor(float r, float g, float b, float a);
 
-		static void DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest = true, bool faceCulling = true);
+		static void DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest = true, bool faceCulling = true, uint32_t baseVertex = 0);
+		static void DrawIndexedInstanced(uint32_t count, uint32_t instanceCount, PrimitiveType type, bool depthTest = true, bool faceCulling = true, uint32_t baseInstance = 0);
 		static void SetLineThickness(float thickness);
 
+		static const RenderAPIStats& GetStats();
+		// Called once the commands of a frame have executed
+		static void EndFrame();
+
 		static RenderAPICapabilities& GetCapabilities()
 		{
 			static RenderAPICapabilities capabilities;
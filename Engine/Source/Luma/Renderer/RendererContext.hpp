@@ -12,6 +12,10 @@ namespace Luma {
 
 		virtual void Init() = 0;
 
+		// Binds the context to the calling thread, or unbinds it so another thread can take it
+		virtual void MakeCurrent() = 0;
+		virtual void ReleaseCurrent() = 0;
+
 		static Ref<RendererContext> Create();
 	};
 
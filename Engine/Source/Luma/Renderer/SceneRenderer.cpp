@@ -4,18 +4,55 @@
 #include "Renderer.hpp"
 #include "SceneEnvironment.hpp"
 #include "Renderer2D.hpp"
+#include "UniformBuffer.hpp"
+#include "ShadowCascadeCache.hpp"
 
 #include "Luma/ImGui/ImGui.hpp"
 #include "Luma/Core/Timer.hpp"
+#include "Luma/Core/FrameAllocator.hpp"
+#include "Luma/Core/RadixSort.hpp"
+#include "Luma/Math/Frustum.hpp"
+#include "Luma/Renderer/Backend/OpenGL/OpenGLState.hpp"
+#include "Luma/Utilities/StringUtils.hpp"
 
 #include <glad/glad.h>
 
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <limits>
+#include <unordered_set>
 
 namespace Luma {
 
+	// SceneData block of the PBR shaders, std140 layout
+	struct SceneUniformData
+	{
+		glm::mat4 ViewProjection;
+		glm::mat4 View;
+		glm::mat4 LightMatrices[4];
+		glm::mat4 LightView;
+		glm::vec4 CascadeSplits;
+
+		glm::vec3 LightDirection;
+		float Padding0;
+		glm::vec3 LightRadiance;
+		float LightMultiplier;
+
+		glm::vec3 CameraPosition;
+		float LightSize;
+		float MaxShadowDistance;
+		float ShadowFade;
+		float CascadeTransitionFade;
+		float IBLContribution;
+		uint32_t ShowCascades;
+		uint32_t SoftShadows;
+		uint32_t CascadeFading;
+		uint32_t Padding1;
+	};
+	static_assert(sizeof(SceneUniformData) == 544, "SceneUniformData has to match the std140 layout of SceneData");
+
+	static constexpr uint32_t s_SceneUniformBinding = 0;
+
 	struct SceneRendererData
 	{
 		const Scene* ActiveScene = nullptr;
@@ -32,6 +69,7 @@ namespace Luma {
 		} SceneData;
 
 		Ref<Texture2D> BRDFLUT;
+		Ref<UniformBuffer> SceneUniformBuffer;
 		Ref<Shader> CompositeShader;
 		Ref<Shader> BloomBlurShader;
 		Ref<Shader> BloomBlendShader;
@@ -71,18 +109,64 @@ namespace Luma {
 			Ref<MaterialInstance> Material;
 			glm::mat4 Transform;
 		};
-		std::vector<DrawCommand> DrawList;
-		std::vector<DrawCommand> SelectedMeshDrawList;
-		std::vector<DrawCommand> ShadowPassDrawList;
+		// Draw lists live in the frame arena; the sizes from the previous frame are used to reserve them up front
+		FrameVector<DrawCommand> DrawList;
+		FrameVector<DrawCommand> SelectedMeshDrawList;
+		FrameVector<DrawCommand> ShadowPassDrawList;
+		size_t DrawListReserve = 0, SelectedMeshDrawListReserve = 0, ShadowPassDrawListReserve = 0;
+
+		// Submeshes of DrawList that passed frustum culling, ordered by SortKey
+		struct SubmeshDrawCommand
+		{
+			uint32_t DrawCommandIndex;
+			uint32_t SubmeshIndex;
+			uint64_t SortKey = 0;
+		};
+		FrameVector<SubmeshDrawCommand> VisibleDrawList;
+		size_t VisibleDrawListReserve = 0;
+
+		// Runs of a submesh draw list that draw the same static submesh, drawn with one instanced draw call
+		struct InstanceBatch
+		{
+			uint32_t First;
+			uint32_t Count;
+		};
+		FrameVector<InstanceBatch> VisibleBatches;
+		size_t VisibleBatchesReserve = 0;
+
+		// Runs of instance batches of pooled static submeshes, drawn with one multi-draw indirect call
+		struct MultiDrawBatch
+		{
+			uint32_t FirstBatch;
+			uint32_t BatchCount;
+		};
+		FrameVector<MultiDrawBatch> VisibleMultiDraws;
+		size_t VisibleMultiDrawsReserve = 0;
+
+		// A cascade keeps last frame's shadow map while nothing it was rendered with changed
+		ShadowCascadeCache ShadowCascadeCaches[4];
 
 		// Grid
 		Ref<MaterialInstance> GridMaterial;
 		Ref<MaterialInstance> OutlineMaterial, OutlineAnimMaterial;
+		MaterialUniformHandle GridViewProjection, OutlineViewProjection, OutlineAnimViewProjection;
 
 		SceneRendererOptions Options;
 	};
 
+	// Recorded on the main thread, reset when a frame starts recording
 	struct SceneRendererStats
+	{
+		uint32_t VisibleSubmeshes = 0;
+		uint32_t CulledSubmeshes = 0;
+		uint32_t ShadowCasters[4] = {};
+		uint32_t SkippedCascades = 0;
+		uint32_t MeshDrawCalls = 0;
+		uint32_t ShadowDrawCalls = 0;
+	};
+
+	// Only touched by the commands executing a frame, which may run on the render thread
+	struct SceneRendererTimings
 	{
 		float ShadowPass = 0.0f;
 		float GeometryPass = 0.0f;
@@ -95,6 +179,244 @@ namespace Luma {
 
 	static SceneRendererData s_Data;
 	static SceneRendererStats s_Stats;
+	static SceneRendererTimings s_Timings;
+
+	// Draw commands recorded per secondary command buffer
+	static constexpr uint32_t s_DrawCommandBatchSize = 64;
+
+	// Mesh materials come and go with the scene, their handles are looked up by precomputed hash
+	static constexpr Identifier s_EnvRadianceTexName("u_EnvRadianceTex");
+	static constexpr Identifier s_EnvIrradianceTexName("u_EnvIrradianceTex");
+	static constexpr Identifier s_BRDFLUTTextureName("u_BRDFLUTTexture");
+	static constexpr Identifier s_ShadowMapTextureName("u_ShadowMapTexture");
+
+	// The storage belongs to this frame's arena, so it must not be reused once the arena is recycled
+	template<typename T>
+	static void ReleaseDrawList(FrameVector<T>& drawList, size_t& reserve)
+	{
+		reserve = drawList.size();
+		FrameVector<T>().swap(drawList);
+	}
+
+	static uint32_t CountSubmeshes(const FrameVector<SceneRendererData::DrawCommand>& drawList)
+	{
+		uint32_t submeshCount = 0;
+		for (auto& dc : drawList)
+			submeshCount += (uint32_t)dc.Mesh->GetSubmeshes().size();
+		return submeshCount;
+	}
+
+	// World space bounds of every submesh in drawList, in draw list order
+	static AABBPacket* BuildSubmeshBounds(const FrameVector<SceneRendererData::DrawCommand>& drawList, uint32_t submeshCount)
+	{
+		AABBPacket* packets = FrameAllocator::Allocate<AABBPacket>((submeshCount + 3) / 4);
+		uint32_t submeshIndex = 0;
+		for (auto& dc : drawList)
+		{
+			for (const Submesh& submesh : dc.Mesh->GetSubmeshes())
+			{
+				packets[submeshIndex / 4].Set(submeshIndex % 4, submesh.BoundingBox, dc.Transform * submesh.Transform);
+				submeshIndex++;
+			}
+		}
+		return packets;
+	}
+
+	// Appends the submeshes of drawList whose bounds intersect frustum to visibleDrawList, everything passes without a frustum
+	static void CullSubmeshes(const FrameVector<SceneRendererData::DrawCommand>& drawList, const AABBPacket* bounds, uint32_t submeshCount,
+		const Frustum* frustum, FrameVector<SceneRendererData::SubmeshDrawCommand>& visibleDrawList)
+	{
+		uint8_t* visible = FrameAllocator::Allocate<uint8_t>(submeshCount);
+		if (frustum)
+			frustum->Cull(bounds, submeshCount, visible);
+		else
+			memset(visible, 1, submeshCount);
+
+		uint32_t submeshIndex = 0;
+		for (uint32_t i = 0; i < (uint32_t)drawList.size(); i++)
+		{
+			// Skinned vertices can leave the bind pose bounds, so animated meshes are never culled
+			const bool animated = drawList[i].Mesh->IsAnimated();
+			const uint32_t count = (uint32_t)drawList[i].Mesh->GetSubmeshes().size();
+			for (uint32_t j = 0; j < count; j++, submeshIndex++)
+			{
+				if (visible[submeshIndex] || animated)
+					visibleDrawList.push_back({ i, j });
+			}
+		}
+	}
+
+	enum class DrawPass : uint64_t
+	{
+		Shadow = 0, Opaque = 1
+	};
+
+	static uint64_t HashPointer(const void* pointer, uint32_t bits)
+	{
+		// Fibonacci hashing spreads the aligned addresses over the available bits
+		return ((uint64_t)(uintptr_t)pointer * 0x9E3779B97F4A7C15ull) >> (64 - bits);
+	}
+
+	// Most significant first: pass (4 bits) | shader (12) | material (16) | submesh (16) | depth (16).
+	// Draws that share state end up next to each other and are ordered front to back within a group,
+	// so every instance of a submesh forms one run for BuildInstanceBatches.
+	// Colliding hashes only cost a few extra state changes or draw calls.
+	static uint64_t MakeSortKey(DrawPass pass, const Shader* shader, const MaterialInstance* material, const Mesh* mesh, uint32_t submeshIndex, float depth)
+	{
+		uint64_t quantizedDepth = (uint64_t)(glm::clamp(depth, 0.0f, 1.0f) * 65535.0f);
+		const uint8_t* submesh = (const uint8_t*)mesh + submeshIndex;
+		return ((uint64_t)pass << 60) | (HashPointer(shader, 12) << 48) | (HashPointer(material, 16) << 32) | (HashPointer(submesh, 16) << 16) | quantizedDepth;
+	}
+
+	// Sorts by the keys getKey(submeshDrawCommand, depth) returns. depth is the view space depth of the submesh
+	// bounds center, normalized to 0 for the nearest and 1 for the farthest submesh in the list.
+	template<typename KeyFn>
+	static void SortDrawList(const FrameVector<SceneRendererData::DrawCommand>& drawList, FrameVector<SceneRendererData::SubmeshDrawCommand>& submeshDrawList,
+		const glm::mat4& viewMatrix, KeyFn&& getKey)
+	{
+		const uint32_t count = (uint32_t)submeshDrawList.size();
+		if (!s_Data.Options.SortDrawLists || count < 2)
+			return;
+
+		float* depths = FrameAllocator::Allocate<float>(count);
+		float minDepth = std::numeric_limits<float>::max();
+		float maxDepth = std::numeric_limits<float>::lowest();
+		for (uint32_t i = 0; i < count; i++)
+		{
+			auto& submeshDC = submeshDrawList[i];
+			auto& dc = drawList[submeshDC.DrawCommandIndex];
+			const Submesh& submesh = dc.Mesh->GetSubmeshes()[submeshDC.SubmeshIndex];
+			glm::vec3 center = (submesh.BoundingBox.Min + submesh.BoundingBox.Max) * 0.5f;
+			depths[i] = -(viewMatrix * (dc.Transform * (submesh.Transform * glm::vec4(center, 1.0f)))).z;
+			minDepth = std::min(minDepth, depths[i]);
+			maxDepth = std::max(maxDepth, depths[i]);
+		}
+
+		const float depthScale = maxDepth > minDepth ? 1.0f / (maxDepth - minDepth) : 0.0f;
+		for (uint32_t i = 0; i < count; i++)
+			submeshDrawList[i].SortKey = getKey(submeshDrawList[i], (depths[i] - minDepth) * depthScale);
+
+		auto* scratch = FrameAllocator::Allocate<SceneRendererData::SubmeshDrawCommand>(count);
+		RadixSort(submeshDrawList.data(), scratch, count, [](const SceneRendererData::SubmeshDrawCommand& submeshDC)
+		{
+			return submeshDC.SortKey;
+		});
+	}
+
+	// Splits submeshDrawList into runs of the same static submesh. Animated meshes and lists recorded
+	// with instancing disabled get one batch per submesh.
+	static void BuildInstanceBatches(const FrameVector<SceneRendererData::DrawCommand>& drawList, const FrameVector<SceneRendererData::SubmeshDrawCommand>& submeshDrawList,
+		FrameVector<SceneRendererData::InstanceBatch>& batches)
+	{
+		for (uint32_t i = 0; i < (uint32_t)submeshDrawList.size(); i++)
+		{
+			auto& submeshDC = submeshDrawList[i];
+			auto& dc = drawList[submeshDC.DrawCommandIndex];
+			if (s_Data.Options.Instancing && !batches.empty() && !dc.Mesh->IsAnimated())
+			{
+				auto& batch = batches.back();
+				auto& first = submeshDrawList[batch.First];
+				if (drawList[first.DrawCommandIndex].Mesh.Raw() == dc.Mesh.Raw() && first.SubmeshIndex == submeshDC.SubmeshIndex)
+				{
+					batch.Count++;
+					continue;
+				}
+			}
+
+			batches.push_back({ i, 1 });
+		}
+	}
+
+	static const MaterialInstance* GetSubmeshMaterial(const SceneRendererData::DrawCommand& dc, uint32_t submeshIndex)
+	{
+		return dc.Mesh->GetMaterials()[dc.Mesh->GetSubmeshes()[submeshIndex].MaterialIndex].Raw();
+	}
+
+	// Merges consecutive batches of submeshes in the static mesh pool into multi-draws. Lists drawn with the
+	// submesh materials only merge batches that share the material, lists drawn with one shader merge all of them.
+	static void BuildMultiDrawBatches(const FrameVector<SceneRendererData::DrawCommand>& drawList, const FrameVector<SceneRendererData::SubmeshDrawCommand>& submeshDrawList,
+		const FrameVector<SceneRendererData::InstanceBatch>& batches, bool matchMaterials, FrameVector<SceneRendererData::MultiDrawBatch>& multiDraws)
+	{
+		const SceneRendererData::SubmeshDrawCommand* previous = nullptr;
+		for (uint32_t i = 0; i < (uint32_t)batches.size(); i++)
+		{
+			auto& submeshDC = submeshDrawList[batches[i].First];
+			auto& dc = drawList[submeshDC.DrawCommandIndex];
+			if (s_Data.Options.MultiDrawIndirect && previous && dc.Mesh->GetStaticMeshAllocation().IsValid())
+			{
+				auto& previousDC = drawList[previous->DrawCommandIndex];
+				if (previousDC.Mesh->GetStaticMeshAllocation().IsValid() &&
+					(!matchMaterials || GetSubmeshMaterial(previousDC, previous->SubmeshIndex) == GetSubmeshMaterial(dc, submeshDC.SubmeshIndex)))
+				{
+					multiDraws.back().BatchCount++;
+					previous = &submeshDC;
+					continue;
+				}
+			}
+
+			multiDraws.push_back({ i, 1 });
+			previous = &submeshDC;
+		}
+	}
+
+	// Submeshes and instance transforms of multiDraw laid out for Renderer::SubmitMultiDrawIndirect, in frame memory
+	static const MultiDrawSubmesh* GetMultiDrawSubmeshes(const FrameVector<SceneRendererData::DrawCommand>& drawList, const FrameVector<SceneRendererData::SubmeshDrawCommand>& submeshDrawList,
+		const FrameVector<SceneRendererData::InstanceBatch>& batches, const SceneRendererData::MultiDrawBatch& multiDraw, const glm::mat4*& transforms)
+	{
+		MultiDrawSubmesh* draws = FrameAllocator::Allocate<MultiDrawSubmesh>(multiDraw.BatchCount);
+		uint32_t instanceCount = 0;
+		for (uint32_t i = 0; i < multiDraw.BatchCount; i++)
+		{
+			auto& batch = batches[multiDraw.FirstBatch + i];
+			auto& submeshDC = submeshDrawList[batch.First];
+			draws[i] = { drawList[submeshDC.DrawCommandIndex].Mesh.Raw(), submeshDC.SubmeshIndex, batch.Count };
+			instanceCount += batch.Count;
+		}
+
+		glm::mat4* instanceTransforms = FrameAllocator::Allocate<glm::mat4>(instanceCount);
+		uint32_t instance = 0;
+		for (uint32_t i = 0; i < multiDraw.BatchCount; i++)
+		{
+			auto& batch = batches[multiDraw.FirstBatch + i];
+			for (uint32_t j = 0; j < batch.Count; j++)
+			{
+				auto& submeshDC = submeshDrawList[batch.First + j];
+				auto& dc = drawList[submeshDC.DrawCommandIndex];
+				instanceTransforms[instance++] = dc.Transform * dc.Mesh->GetSubmeshes()[submeshDC.SubmeshIndex].Transform;
+			}
+		}
+
+		transforms = instanceTransforms;
+		return draws;
+	}
+
+	// World transforms of the instances in batch, in frame memory so they live until the frame has rendered
+	static const glm::mat4* GetInstanceTransforms(const FrameVector<SceneRendererData::DrawCommand>& drawList, const FrameVector<SceneRendererData::SubmeshDrawCommand>& submeshDrawList,
+		const SceneRendererData::InstanceBatch& batch)
+	{
+		glm::mat4* transforms = FrameAllocator::Allocate<glm::mat4>(batch.Count);
+		for (uint32_t i = 0; i < batch.Count; i++)
+		{
+			auto& submeshDC = submeshDrawList[batch.First + i];
+			auto& dc = drawList[submeshDC.DrawCommandIndex];
+			transforms[i] = dc.Transform * dc.Mesh->GetSubmeshes()[submeshDC.SubmeshIndex].Transform;
+		}
+		return transforms;
+	}
+
+	// Returns false if the cascade was last rendered with the same matrix, casters and shadow map
+	static bool UpdateShadowCascadeCache(uint32_t cascade, const glm::mat4& viewProjection, const FrameVector<SceneRendererData::SubmeshDrawCommand>& casters)
+	{
+		ShadowCascadeCache::Caster* cacheCasters = FrameAllocator::Allocate<ShadowCascadeCache::Caster>((uint32_t)casters.size());
+		for (size_t i = 0; i < casters.size(); i++)
+		{
+			const auto& dc = s_Data.ShadowPassDrawList[casters[i].DrawCommandIndex];
+			cacheCasters[i] = { dc.Mesh->GetID(), casters[i].SubmeshIndex, dc.Transform, dc.Mesh->IsAnimated() };
+		}
+
+		const uint32_t framebufferVersion = s_Data.ShadowMapRenderPass[cascade]->GetSpecification().TargetFramebuffer->GetVersion();
+		return s_Data.ShadowCascadeCaches[cascade].Update(viewProjection, framebufferVersion, cacheCasters, (uint32_t)casters.size());
+	}
 
 	void SceneRenderer::Init()
 	{
@@ -137,6 +459,7 @@ namespace Luma {
 		s_Data.BloomBlurShader = Shader::Create("Resources/Shaders/BloomBlur.glsl");
 		s_Data.BloomBlendShader = Shader::Create("Resources/Shaders/BloomBlend.glsl");
 		s_Data.BRDFLUT = Texture2D::Create("Resources/Textures/BRDF_LUT.tga");
+		s_Data.SceneUniformBuffer = UniformBuffer::Create(sizeof(SceneUniformData), s_SceneUniformBinding);
 
 		// Grid
 		auto gridShader = Shader::Create("Resources/Shaders/Grid.glsl");
@@ -145,15 +468,18 @@ namespace Luma {
 		float gridScale = 16.025f, gridSize = 0.025f;
 		s_Data.GridMaterial->Set("u_Scale", gridScale);
 		s_Data.GridMaterial->Set("u_Res", gridSize);
+		s_Data.GridViewProjection = s_Data.GridMaterial->GetUniformHandle("u_ViewProjection");
 
 		// Outline
 		auto outlineShader = Shader::Create("Resources/Shaders/Outline.glsl");
 		s_Data.OutlineMaterial = MaterialInstance::Create(Material::Create(outlineShader));
 		s_Data.OutlineMaterial->SetFlag(MaterialFlag::DepthTest, false);
+		s_Data.OutlineViewProjection = s_Data.OutlineMaterial->GetUniformHandle("u_ViewProjection");
 
 		auto outlineAnimShader = Shader::Create("Resources/Shaders/Outline_Anim.glsl");
 		s_Data.OutlineAnimMaterial = MaterialInstance::Create(Material::Create(outlineAnimShader));
 		s_Data.OutlineAnimMaterial->SetFlag(MaterialFlag::DepthTest, false);
+		s_Data.OutlineAnimViewProjection = s_Data.OutlineAnimMaterial->GetUniformHandle("u_ViewProjection");
 
 		// Shadow Map
 		s_Data.ShadowMapShader = Shader::Create("Resources/Shaders/ShadowMap.glsl");
@@ -204,6 +530,13 @@ namespace Luma {
 		s_Data.SceneData.SceneEnvironmentIntensity = scene->m_EnvironmentIntensity;
 		s_Data.SceneData.ActiveLight = scene->m_Light;
 		s_Data.SceneData.SceneLightEnvironment = scene->m_LightEnvironment;
+
+		s_Data.DrawList.reserve(s_Data.DrawListReserve);
+		s_Data.SelectedMeshDrawList.reserve(s_Data.SelectedMeshDrawListReserve);
+		s_Data.ShadowPassDrawList.reserve(s_Data.ShadowPassDrawListReserve);
+		s_Data.VisibleDrawList.reserve(s_Data.VisibleDrawListReserve);
+		s_Data.VisibleBatches.reserve(s_Data.VisibleBatchesReserve);
+		s_Data.VisibleMultiDraws.reserve(s_Data.VisibleMultiDrawsReserve);
 	}
 
 	void SceneRenderer::EndScene()
@@ -217,7 +550,7 @@ namespace Luma {
 
 	void SceneRenderer::SubmitMesh(Ref<Mesh> mesh, const glm::mat4& transform, Ref<MaterialInstance> overrideMaterial)
 	{
-		// TODO: Culling, sorting, etc.
+		// Culled per submesh in CullDrawList once the scene is complete
 		s_Data.DrawList.push_back({ mesh, overrideMaterial, transform });
 		s_Data.ShadowPassDrawList.push_back({ mesh, overrideMaterial, transform });
 	}
@@ -292,6 +625,36 @@ namespace Luma {
 		return { envFiltered, irradianceMap };
 	}
 
+	static void UpdateSceneUniformBuffer(const glm::mat4& viewProjection, const glm::vec3& cameraPosition)
+	{
+		const auto& directionalLight = s_Data.SceneData.SceneLightEnvironment.DirectionalLights[0];
+
+		SceneUniformData data;
+		data.ViewProjection = viewProjection;
+		data.View = s_Data.SceneData.SceneCamera.ViewMatrix;
+		for (uint32_t i = 0; i < 4; i++)
+			data.LightMatrices[i] = s_Data.LightMatrices[i];
+		data.LightView = s_Data.LightViewMatrix;
+		data.CascadeSplits = s_Data.CascadeSplits;
+		data.LightDirection = directionalLight.Direction;
+		data.Padding0 = 0.0f;
+		data.LightRadiance = directionalLight.Radiance;
+		data.LightMultiplier = directionalLight.Multiplier;
+		data.CameraPosition = cameraPosition;
+		data.LightSize = s_Data.LightSize;
+		data.MaxShadowDistance = s_Data.MaxShadowDistance;
+		data.ShadowFade = s_Data.ShadowFade;
+		data.CascadeTransitionFade = s_Data.CascadeTransitionFade;
+		data.IBLContribution = s_Data.SceneData.SceneEnvironmentIntensity;
+		data.ShowCascades = s_Data.ShowCascades;
+		data.SoftShadows = s_Data.SoftShadows;
+		data.CascadeFading = s_Data.CascadeFading;
+		data.Padding1 = 0;
+
+		s_Data.SceneUniformBuffer->SetData(&data, sizeof(SceneUniformData));
+		s_Data.SceneUniformBuffer->Bind();
+	}
+
 	void SceneRenderer::GeometryPass()
 	{
 		bool outline = s_Data.SelectedMeshDrawList.size() > 0;
@@ -300,7 +663,7 @@ namespace Luma {
 		{
 			Renderer::Submit([]()
 			{
-				glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+				OpenGLState::SetStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
 			});
 		}
 
@@ -310,7 +673,7 @@ namespace Luma {
 		{
 			Renderer::Submit([]()
 			{
-				glStencilMask(0);
+				OpenGLState::SetStencilMask(0);
 			});
 		}
 
@@ -325,41 +688,40 @@ namespace Luma {
 		s_Data.SceneData.SkyboxMaterial->Set("u_SkyIntensity", s_Data.SceneData.SceneEnvironmentIntensity);
 		Renderer::SubmitFullscreenQuad(s_Data.SceneData.SkyboxMaterial);
 
-		// Render entities
+		// Camera, light and shadow data for every PBR shader
+		UpdateSceneUniformBuffer(viewProjection, cameraPosition);
+
+		// Samplers can't live in the uniform block, the environment maps are set once per material
+		// before recording in parallel
+		std::unordered_set<const Material*> environmentMaterials;
+		auto setEnvironmentMaps = [&environmentMaterials](Ref<Material> baseMaterial)
+		{
+			if (!environmentMaterials.insert(baseMaterial.Raw()).second)
+				return;
+
+			baseMaterial->Set(baseMaterial->GetResourceHandle(s_EnvRadianceTexName), s_Data.SceneData.SceneEnvironment.RadianceMap);
+			baseMaterial->Set(baseMaterial->GetResourceHandle(s_EnvIrradianceTexName), s_Data.SceneData.SceneEnvironment.IrradianceMap);
+			baseMaterial->Set(baseMaterial->GetResourceHandle(s_BRDFLUTTextureName), s_Data.BRDFLUT);
+		};
+
 		for (auto& dc : s_Data.DrawList)
+			setEnvironmentMaps(dc.Mesh->GetMaterial());
+
+		// Render entities
+		Renderer::RecordParallel((uint32_t)s_Data.VisibleMultiDraws.size(), s_DrawCommandBatchSize, [](uint32_t index)
 		{
+			auto& multiDraw = s_Data.VisibleMultiDraws[index];
+			auto& batch = s_Data.VisibleBatches[multiDraw.FirstBatch];
+			auto& submeshDC = s_Data.VisibleDrawList[batch.First];
+			auto& dc = s_Data.DrawList[submeshDC.DrawCommandIndex];
 			auto baseMaterial = dc.Mesh->GetMaterial();
-			baseMaterial->Set("u_ViewProjectionMatrix", viewProjection);
-			baseMaterial->Set("u_ViewMatrix", sceneCamera.ViewMatrix);
-			baseMaterial->Set("u_CameraPosition", cameraPosition);
-			baseMaterial->Set("u_LightMatrixCascade0", s_Data.LightMatrices[0]);
-			baseMaterial->Set("u_LightMatrixCascade1", s_Data.LightMatrices[1]);
-			baseMaterial->Set("u_LightMatrixCascade2", s_Data.LightMatrices[2]);
-			baseMaterial->Set("u_LightMatrixCascade3", s_Data.LightMatrices[3]);
-			baseMaterial->Set("u_ShowCascades", s_Data.ShowCascades);
-			baseMaterial->Set("u_LightView", s_Data.LightViewMatrix);
-			baseMaterial->Set("u_CascadeSplits", s_Data.CascadeSplits);
-			baseMaterial->Set("u_SoftShadows", s_Data.SoftShadows);
-			baseMaterial->Set("u_LightSize", s_Data.LightSize);
-			baseMaterial->Set("u_MaxShadowDistance", s_Data.MaxShadowDistance);
-			baseMaterial->Set("u_ShadowFade", s_Data.ShadowFade);
-			baseMaterial->Set("u_CascadeFading", s_Data.CascadeFading);
-			baseMaterial->Set("u_CascadeTransitionFade", s_Data.CascadeTransitionFade);
-			baseMaterial->Set("u_IBLContribution", s_Data.SceneData.SceneEnvironmentIntensity);
-
-			// Environment (TODO: don't do this per mesh)
-			baseMaterial->Set("u_EnvRadianceTex", s_Data.SceneData.SceneEnvironment.RadianceMap);
-			baseMaterial->Set("u_EnvIrradianceTex", s_Data.SceneData.SceneEnvironment.IrradianceMap);
-			baseMaterial->Set("u_BRDFLUTTexture", s_Data.BRDFLUT);
-
-			// Set lights (TODO: move to light environment and don't do per mesh)
-			auto directionalLight = s_Data.SceneData.SceneLightEnvironment.DirectionalLights[0];
-			baseMaterial->Set("u_DirectionalLights", directionalLight);
-
-			auto rd = baseMaterial->FindResourceDeclaration("u_ShadowMapTexture");
-			if (rd)
-			{
-				auto reg = rd->GetRegister();
+
+			// Bound for every multi-draw: one can merge batches of different meshes and the slot depends on the shader,
+			// OpenGLState drops the binds that don't change anything
+			auto shadowMaps = baseMaterial->GetResourceHandle(s_ShadowMapTextureName);
+			if (shadowMaps.IsValid())
+			{
+				auto reg = shadowMaps.Slot;
 
 				auto tex = s_Data.ShadowMapRenderPass[0]->GetSpecification().TargetFramebuffer->GetDepthAttachmentRendererID();
 				auto tex1 = s_Data.ShadowMapRenderPass[1]->GetSpecification().TargetFramebuffer->GetDepthAttachmentRendererID();
@@ -369,66 +731,51 @@ namespace Luma {
 				Renderer::Submit([reg, tex, tex1, tex2, tex3]() mutable
 				{
 					// 4 cascades
-					glBindTextureUnit(reg, tex);
-					glBindSampler(reg++, s_Data.ShadowMapSampler);
+					OpenGLState::BindTextureUnit(reg, tex);
+					OpenGLState::BindSampler(reg++, s_Data.ShadowMapSampler);
 
-					glBindTextureUnit(reg, tex1);
-					glBindSampler(reg++, s_Data.ShadowMapSampler);
+					OpenGLState::BindTextureUnit(reg, tex1);
+					OpenGLState::BindSampler(reg++, s_Data.ShadowMapSampler);
 
-					glBindTextureUnit(reg, tex2);
-					glBindSampler(reg++, s_Data.ShadowMapSampler);
+					OpenGLState::BindTextureUnit(reg, tex2);
+					OpenGLState::BindSampler(reg++, s_Data.ShadowMapSampler);
 
-					glBindTextureUnit(reg, tex3);
-					glBindSampler(reg++, s_Data.ShadowMapSampler);
+					OpenGLState::BindTextureUnit(reg, tex3);
+					OpenGLState::BindSampler(reg++, s_Data.ShadowMapSampler);
 				});
 			}
 
-
 			auto overrideMaterial = nullptr; // dc.Material;
-			Renderer::SubmitMesh(dc.Mesh, dc.Transform, overrideMaterial);
-		}
+			if (multiDraw.BatchCount > 1)
+			{
+				const glm::mat4* transforms = nullptr;
+				const MultiDrawSubmesh* draws = GetMultiDrawSubmeshes(s_Data.DrawList, s_Data.VisibleDrawList, s_Data.VisibleBatches, multiDraw, transforms);
+				const Submesh& submesh = dc.Mesh->GetSubmeshes()[submeshDC.SubmeshIndex];
+				Renderer::SubmitMultiDrawIndirect(draws, multiDraw.BatchCount, transforms, dc.Mesh->GetMaterials()[submesh.MaterialIndex]);
+			}
+			else if (dc.Mesh->IsAnimated())
+				Renderer::SubmitSubmesh(dc.Mesh, submeshDC.SubmeshIndex, dc.Transform, overrideMaterial);
+			else
+				Renderer::SubmitSubmeshInstanced(dc.Mesh, submeshDC.SubmeshIndex, GetInstanceTransforms(s_Data.DrawList, s_Data.VisibleDrawList, batch), batch.Count, overrideMaterial);
+		});
 
 		if (outline)
 		{
 			Renderer::Submit([]()
 			{
-				glStencilFunc(GL_ALWAYS, 1, 0xff);
-				glStencilMask(0xff);
+				OpenGLState::SetStencilFunc(GL_ALWAYS, 1, 0xff);
+				OpenGLState::SetStencilMask(0xff);
 			});
 		}
 		for (auto& dc : s_Data.SelectedMeshDrawList)
 		{
 			auto baseMaterial = dc.Mesh->GetMaterial();
-			baseMaterial->Set("u_ViewProjectionMatrix", viewProjection);
-			baseMaterial->Set("u_ViewMatrix", sceneCamera.ViewMatrix);
-			baseMaterial->Set("u_CameraPosition", cameraPosition);
-			baseMaterial->Set("u_CascadeSplits", s_Data.CascadeSplits);
-			baseMaterial->Set("u_ShowCascades", s_Data.ShowCascades);
-			baseMaterial->Set("u_SoftShadows", s_Data.SoftShadows);
-			baseMaterial->Set("u_LightSize", s_Data.LightSize);
-			baseMaterial->Set("u_MaxShadowDistance", s_Data.MaxShadowDistance);
-			baseMaterial->Set("u_ShadowFade", s_Data.ShadowFade);
-			baseMaterial->Set("u_CascadeFading", s_Data.CascadeFading);
-			baseMaterial->Set("u_CascadeTransitionFade", s_Data.CascadeTransitionFade);
-			baseMaterial->Set("u_IBLContribution", s_Data.SceneData.SceneEnvironmentIntensity);
-
-			// Environment (TODO: don't do this per mesh)
-			baseMaterial->Set("u_EnvRadianceTex", s_Data.SceneData.SceneEnvironment.RadianceMap);
-			baseMaterial->Set("u_EnvIrradianceTex", s_Data.SceneData.SceneEnvironment.IrradianceMap);
-			baseMaterial->Set("u_BRDFLUTTexture", s_Data.BRDFLUT);
-
-			baseMaterial->Set("u_LightMatrixCascade0", s_Data.LightMatrices[0]);
-			baseMaterial->Set("u_LightMatrixCascade1", s_Data.LightMatrices[1]);
-			baseMaterial->Set("u_LightMatrixCascade2", s_Data.LightMatrices[2]);
-			baseMaterial->Set("u_LightMatrixCascade3", s_Data.LightMatrices[3]);
-
-			// Set lights (TODO: move to light environment and don't do per mesh)
-			baseMaterial->Set("u_DirectionalLights", s_Data.SceneData.SceneLightEnvironment.DirectionalLights[0]);
-			s_Data.OutlineAnimMaterial->Set("u_ViewProjection", viewProjection);
-			auto rd = baseMaterial->FindResourceDeclaration("u_ShadowMapTexture");
-			if (rd)
-			{
-				auto reg = rd->GetRegister();
+			setEnvironmentMaps(baseMaterial);
+			s_Data.OutlineAnimMaterial->Set(s_Data.OutlineAnimViewProjection, viewProjection);
+			auto shadowMaps = baseMaterial->GetResourceHandle(s_ShadowMapTextureName);
+			if (shadowMaps.IsValid())
+			{
+				auto reg = shadowMaps.Slot;
 
 				auto tex = s_Data.ShadowMapRenderPass[0]->GetSpecification().TargetFramebuffer->GetDepthAttachmentRendererID();
 				auto tex1 = s_Data.ShadowMapRenderPass[1]->GetSpecification().TargetFramebuffer->GetDepthAttachmentRendererID();
@@ -438,17 +785,17 @@ namespace Luma {
 				Renderer::Submit([reg, tex, tex1, tex2, tex3]() mutable
 				{
 					// 4 cascades
-					glBindTextureUnit(reg, tex);
-					glBindSampler(reg++, s_Data.ShadowMapSampler);
+					OpenGLState::BindTextureUnit(reg, tex);
+					OpenGLState::BindSampler(reg++, s_Data.ShadowMapSampler);
 
-					glBindTextureUnit(reg, tex1);
-					glBindSampler(reg++, s_Data.ShadowMapSampler);
+					OpenGLState::BindTextureUnit(reg, tex1);
+					OpenGLState::BindSampler(reg++, s_Data.ShadowMapSampler);
 
-					glBindTextureUnit(reg, tex2);
-					glBindSampler(reg++, s_Data.ShadowMapSampler);
+					OpenGLState::BindTextureUnit(reg, tex2);
+					OpenGLState::BindSampler(reg++, s_Data.ShadowMapSampler);
 
-					glBindTextureUnit(reg, tex3);
-					glBindSampler(reg++, s_Data.ShadowMapSampler);
+					OpenGLState::BindTextureUnit(reg, tex3);
+					OpenGLState::BindSampler(reg++, s_Data.ShadowMapSampler);
 				});
 			}
 
@@ -460,17 +807,17 @@ namespace Luma {
 		{
 			Renderer::Submit([]()
 			{
-				glStencilFunc(GL_NOTEQUAL, 1, 0xff);
-				glStencilMask(0);
+				OpenGLState::SetStencilFunc(GL_NOTEQUAL, 1, 0xff);
+				OpenGLState::SetStencilMask(0);
 
 				glLineWidth(10);
 				glEnable(GL_LINE_SMOOTH);
-				glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-				glDisable(GL_DEPTH_TEST);
+				OpenGLState::SetPolygonMode(GL_LINE);
+				OpenGLState::SetDepthTest(false);
 			});
 
 			// Draw outline here
-			s_Data.OutlineMaterial->Set("u_ViewProjection", viewProjection);
+			s_Data.OutlineMaterial->Set(s_Data.OutlineViewProjection, viewProjection);
 			for (auto& dc : s_Data.SelectedMeshDrawList)
 			{
 				Renderer::SubmitMesh(dc.Mesh, dc.Transform, dc.Mesh->IsAnimated() ? s_Data.OutlineAnimMaterial : s_Data.OutlineMaterial);
@@ -479,7 +826,7 @@ namespace Luma {
 			Renderer::Submit([]()
 			{
 				glPointSize(10);
-				glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
+				OpenGLState::SetPolygonMode(GL_POINT);
 			});
 			for (auto& dc : s_Data.SelectedMeshDrawList)
 			{
@@ -488,17 +835,17 @@ namespace Luma {
 
 			Renderer::Submit([]()
 			{
-				glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-				glStencilMask(0xff);
-				glStencilFunc(GL_ALWAYS, 1, 0xff);
-				glEnable(GL_DEPTH_TEST);
+				OpenGLState::SetPolygonMode(GL_FILL);
+				OpenGLState::SetStencilMask(0xff);
+				OpenGLState::SetStencilFunc(GL_ALWAYS, 1, 0xff);
+				OpenGLState::SetDepthTest(true);
 			});
 		}
 
 		// Grid
 		if (GetOptions().ShowGrid)
 		{
-			s_Data.GridMaterial->Set("u_ViewProjection", viewProjection);
+			s_Data.GridMaterial->Set(s_Data.GridViewProjection, viewProjection);
 			Renderer::SubmitQuad(s_Data.GridMaterial, glm::rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f)) * glm::scale(glm::mat4(1.0f), glm::vec3(16.0f)));
 		}
 
@@ -528,7 +875,7 @@ namespace Luma {
 		s_Data.GeoPass->GetSpecification().TargetFramebuffer->BindTexture();
 		Renderer::Submit([]()
 		{
-			glBindTextureUnit(1, s_Data.GeoPass->GetSpecification().TargetFramebuffer->GetDepthAttachmentRendererID());
+			OpenGLState::BindTextureUnit(1, s_Data.GeoPass->GetSpecification().TargetFramebuffer->GetDepthAttachmentRendererID());
 		});
 		Renderer::SubmitFullscreenQuad(nullptr);
 		Renderer::EndRenderPass();
@@ -561,7 +908,7 @@ namespace Luma {
 				auto id = fb->GetColorAttachmentRendererID(1);
 				Renderer::Submit([id]()
 				{
-					glBindTextureUnit(0, id);
+					OpenGLState::BindTextureUnit(0, id);
 				});
 			}
 			Renderer::SubmitFullscreenQuad(nullptr);
@@ -724,6 +1071,7 @@ namespace Luma {
 				// Clear shadow maps
 				Renderer::BeginRenderPass(s_Data.ShadowMapRenderPass[i]);
 				Renderer::EndRenderPass();
+				s_Data.ShadowCascadeCaches[i].Invalidate();
 			}
 			return;
 		}
@@ -734,80 +1082,160 @@ namespace Luma {
 
 		Renderer::Submit([]()
 		{
-			glEnable(GL_CULL_FACE);
-			glCullFace(GL_BACK);
+			OpenGLState::SetFaceCulling(true);
+			OpenGLState::SetCullFace(GL_BACK);
 		});
 
+		// Caster bounds are shared by all cascades
+		const uint32_t casterCount = CountSubmeshes(s_Data.ShadowPassDrawList);
+		const AABBPacket* casterBounds = GetOptions().FrustumCulling ? BuildSubmeshBounds(s_Data.ShadowPassDrawList, casterCount) : nullptr;
+
 		for (int i = 0; i < 4; i++)
 		{
 			s_Data.CascadeSplits[i] = cascades[i].SplitDepth;
 
-			Renderer::BeginRenderPass(s_Data.ShadowMapRenderPass[i]);
-
 			glm::mat4 shadowMapVP = cascades[i].ViewProj;
 
 			static glm::mat4 scaleBiasMatrix = glm::scale(glm::mat4(1.0f), { 0.5f, 0.5f, 0.5f }) * glm::translate(glm::mat4(1.0f), { 1, 1, 1 });
 			s_Data.LightMatrices[i] = scaleBiasMatrix * cascades[i].ViewProj;
 
+			// Casters between the light and the cascade still throw shadows into it, so the near plane is dropped
+			Frustum cascadeFrustum = Frustum::FromMatrix(shadowMapVP);
+			cascadeFrustum.Planes[4] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
 
-			// Render entities
-			for (auto& dc : s_Data.ShadowPassDrawList)
+			FrameVector<SceneRendererData::SubmeshDrawCommand> casters;
+			CullSubmeshes(s_Data.ShadowPassDrawList, casterBounds, casterCount, casterBounds ? &cascadeFrustum : nullptr, casters);
+			s_Stats.ShadowCasters[i] = (uint32_t)casters.size();
+
+			// Only the shader differs between casters, front to back as seen from the light
+			SortDrawList(s_Data.ShadowPassDrawList, casters, cascades[i].View, [](const SceneRendererData::SubmeshDrawCommand& caster, float depth)
 			{
-				Ref<Shader> shader = dc.Mesh->IsAnimated() ? s_Data.ShadowMapAnimShader : s_Data.ShadowMapShader;
-				shader->SetMat4("u_ViewProjection", shadowMapVP);
-				Renderer::SubmitMeshWithShader(dc.Mesh, dc.Transform, shader);
+				auto& dc = s_Data.ShadowPassDrawList[caster.DrawCommandIndex];
+				const Shader* shader = dc.Mesh->IsAnimated() ? s_Data.ShadowMapAnimShader.Raw() : s_Data.ShadowMapShader.Raw();
+				return MakeSortKey(DrawPass::Shadow, shader, nullptr, dc.Mesh.Raw(), caster.SubmeshIndex, depth);
+			});
+
+			if (!UpdateShadowCascadeCache(i, shadowMapVP, casters))
+			{
+				s_Stats.SkippedCascades++;
+				continue;
 			}
 
+			FrameVector<SceneRendererData::InstanceBatch> batches;
+			BuildInstanceBatches(s_Data.ShadowPassDrawList, casters, batches);
+			FrameVector<SceneRendererData::MultiDrawBatch> multiDraws;
+			BuildMultiDrawBatches(s_Data.ShadowPassDrawList, casters, batches, false, multiDraws);
+			s_Stats.ShadowDrawCalls += (uint32_t)multiDraws.size();
+
+			Renderer::BeginRenderPass(s_Data.ShadowMapRenderPass[i]);
+
+			s_Data.ShadowMapShader->SetMat4("u_ViewProjection", shadowMapVP);
+			s_Data.ShadowMapAnimShader->SetMat4("u_ViewProjection", shadowMapVP);
+
+			// Render entities
+			Renderer::RecordParallel((uint32_t)multiDraws.size(), s_DrawCommandBatchSize, [&casters, &batches, &multiDraws](uint32_t index)
+			{
+				auto& multiDraw = multiDraws[index];
+				auto& batch = batches[multiDraw.FirstBatch];
+				auto& caster = casters[batch.First];
+				auto& dc = s_Data.ShadowPassDrawList[caster.DrawCommandIndex];
+				if (multiDraw.BatchCount > 1)
+				{
+					const glm::mat4* transforms = nullptr;
+					const MultiDrawSubmesh* draws = GetMultiDrawSubmeshes(s_Data.ShadowPassDrawList, casters, batches, multiDraw, transforms);
+					Renderer::SubmitMultiDrawIndirectWithShader(draws, multiDraw.BatchCount, transforms, s_Data.ShadowMapShader);
+				}
+				else if (dc.Mesh->IsAnimated())
+					Renderer::SubmitSubmeshWithShader(dc.Mesh, caster.SubmeshIndex, dc.Transform, s_Data.ShadowMapAnimShader);
+				else
+					Renderer::SubmitSubmeshInstancedWithShader(dc.Mesh, caster.SubmeshIndex, GetInstanceTransforms(s_Data.ShadowPassDrawList, casters, batch), batch.Count, s_Data.ShadowMapShader);
+			});
+
 			Renderer::EndRenderPass();
 		}
 	}
 
+	void SceneRenderer::CullDrawList()
+	{
+		const uint32_t submeshCount = CountSubmeshes(s_Data.DrawList);
+		if (GetOptions().FrustumCulling)
+		{
+			auto& sceneCamera = s_Data.SceneData.SceneCamera;
+			Frustum frustum = Frustum::FromMatrix(sceneCamera.Camera.GetProjectionMatrix() * sceneCamera.ViewMatrix);
+			CullSubmeshes(s_Data.DrawList, BuildSubmeshBounds(s_Data.DrawList, submeshCount), submeshCount, &frustum, s_Data.VisibleDrawList);
+		}
+		else
+		{
+			CullSubmeshes(s_Data.DrawList, nullptr, submeshCount, nullptr, s_Data.VisibleDrawList);
+		}
+
+		s_Stats.VisibleSubmeshes = (uint32_t)s_Data.VisibleDrawList.size();
+		s_Stats.CulledSubmeshes = submeshCount - s_Stats.VisibleSubmeshes;
+	}
+
 	void SceneRenderer::FlushDrawList()
 	{
 		LM_CORE_ASSERT(!s_Data.ActiveScene, "");
 
-		memset(&s_Stats, 0, sizeof(SceneRendererStats));
+		s_Stats = {};
+
+		CullDrawList();
+
+		// Opaque draws grouped by state, front to back within a group
+		SortDrawList(s_Data.DrawList, s_Data.VisibleDrawList, s_Data.SceneData.SceneCamera.ViewMatrix, [](const SceneRendererData::SubmeshDrawCommand& submeshDC, float depth)
+		{
+			auto& dc = s_Data.DrawList[submeshDC.DrawCommandIndex];
+			const Submesh& submesh = dc.Mesh->GetSubmeshes()[submeshDC.SubmeshIndex];
+			Ref<MaterialInstance> material = dc.Mesh->GetMaterials()[submesh.MaterialIndex];
+			return MakeSortKey(DrawPass::Opaque, material->GetShader().Raw(), material.Raw(), dc.Mesh.Raw(), submeshDC.SubmeshIndex, depth);
+		});
+		BuildInstanceBatches(s_Data.DrawList, s_Data.VisibleDrawList, s_Data.VisibleBatches);
+		BuildMultiDrawBatches(s_Data.DrawList, s_Data.VisibleDrawList, s_Data.VisibleBatches, true, s_Data.VisibleMultiDraws);
+		s_Stats.MeshDrawCalls = (uint32_t)s_Data.VisibleMultiDraws.size();
 
 		{
 			Renderer::Submit([]()
 			{
-				s_Stats.ShadowPassTimer.Reset();
+				s_Timings.ShadowPassTimer.Reset();
 			});
 			ShadowMapPass();
 			Renderer::Submit([]
 			{
-				s_Stats.ShadowPass = s_Stats.ShadowPassTimer.ElapsedMillis();
+				s_Timings.ShadowPass = s_Timings.ShadowPassTimer.ElapsedMillis();
 			});
 		}
 		{
 			Renderer::Submit([]()
 			{
-				s_Stats.GeometryPassTimer.Reset();
+				s_Timings.GeometryPassTimer.Reset();
 			});
 			GeometryPass();
 			Renderer::Submit([]
 			{
-				s_Stats.GeometryPass = s_Stats.GeometryPassTimer.ElapsedMillis();
+				s_Timings.GeometryPass = s_Timings.GeometryPassTimer.ElapsedMillis();
 			});
 		}
 		{
 			Renderer::Submit([]()
 			{
-				s_Stats.CompositePassTimer.Reset();
+				s_Timings.CompositePassTimer.Reset();
 			});
 
 			CompositePass();
 			Renderer::Submit([]
 			{
-				s_Stats.CompositePass = s_Stats.CompositePassTimer.ElapsedMillis();
+				s_Timings.CompositePass = s_Timings.CompositePassTimer.ElapsedMillis();
 			});
 
 		//	BloomBlurPass();
 		}
 
-		s_Data.DrawList.clear();
-		s_Data.SelectedMeshDrawList.clear();
-		s_Data.ShadowPassDrawList.clear();
+		ReleaseDrawList(s_Data.DrawList, s_Data.DrawListReserve);
+		ReleaseDrawList(s_Data.SelectedMeshDrawList, s_Data.SelectedMeshDrawListReserve);
+		ReleaseDrawList(s_Data.ShadowPassDrawList, s_Data.ShadowPassDrawListReserve);
+		ReleaseDrawList(s_Data.VisibleDrawList, s_Data.VisibleDrawListReserve);
+		ReleaseDrawList(s_Data.VisibleBatches, s_Data.VisibleBatchesReserve);
+		ReleaseDrawList(s_Data.VisibleMultiDraws, s_Data.VisibleMultiDrawsReserve);
 		s_Data.SceneData = {};
 	}
 
@@ -896,6 +1324,63 @@ namespace Luma {
 			UI::EndTreeNode();
 		}
 
+		if (UI::BeginTreeNode("Culling", false))
+		{
+			UI::BeginPropertyGrid();
+			UI::Property("Frustum Culling", GetOptions().FrustumCulling);
+			UI::Property("Visible Submeshes", std::to_string(s_Stats.VisibleSubmeshes).c_str());
+			UI::Property("Culled Submeshes", std::to_string(s_Stats.CulledSubmeshes).c_str());
+			UI::Property("Shadow Casters", std::format("{} / {} / {} / {}", s_Stats.ShadowCasters[0], s_Stats.ShadowCasters[1], s_Stats.ShadowCasters[2], s_Stats.ShadowCasters[3]).c_str());
+			UI::Property("Unchanged Cascades", std::to_string(s_Stats.SkippedCascades).c_str());
+			UI::EndPropertyGrid();
+			UI::EndTreeNode();
+		}
+
+		if (UI::BeginTreeNode("Draw Order", false))
+		{
+			const RenderAPIStats& apiStats = RendererAPI::GetStats();
+
+			UI::BeginPropertyGrid();
+			UI::Property("Sort Draw Lists", GetOptions().SortDrawLists);
+			UI::Property("Draw Calls", std::format("{} ({} draws)", apiStats.DrawCalls, apiStats.Draws).c_str());
+			UI::Property("Program Switches", std::to_string(apiStats.ProgramSwitches).c_str());
+			UI::Property("Vertex Array Switches", std::to_string(apiStats.VertexArraySwitches).c_str());
+			UI::Property("Texture Switches", std::to_string(apiStats.TextureSwitches).c_str());
+			UI::Property("Redundant Binds", std::to_string(apiStats.RedundantBinds).c_str());
+			UI::Property("Redundant State Changes", std::to_string(apiStats.RedundantStateChanges).c_str());
+			UI::Property("Material Uploads", std::to_string(apiStats.MaterialUploads).c_str());
+			UI::Property("Material Uploads Skipped", std::to_string(apiStats.MaterialUploadsSkipped).c_str());
+			UI::EndPropertyGrid();
+			UI::EndTreeNode();
+		}
+
+		if (UI::BeginTreeNode("Instancing", false))
+		{
+			UI::BeginPropertyGrid();
+			UI::Property("Instancing", GetOptions().Instancing);
+			UI::Property("Multi Draw Indirect", GetOptions().MultiDrawIndirect);
+			UI::Property("Mesh Draw Calls", std::to_string(s_Stats.MeshDrawCalls).c_str());
+			UI::Property("Shadow Draw Calls", std::to_string(s_Stats.ShadowDrawCalls).c_str());
+
+			StaticMeshPoolStats poolStats = StaticMeshPool::GetStats();
+			UI::Property("Pooled Vertices", std::format("{} / {}", poolStats.UsedVertices, poolStats.VertexCapacity).c_str());
+			UI::Property("Pooled Indices", std::format("{} / {}", poolStats.UsedIndices, poolStats.IndexCapacity).c_str());
+			UI::EndPropertyGrid();
+			UI::EndTreeNode();
+		}
+
+		if (UI::BeginTreeNode("Render Command Queue", false))
+		{
+			RenderCommandQueueStats stats = Renderer::GetRenderCommandQueueStats();
+
+			UI::BeginPropertyGrid();
+			UI::Property("Commands", std::format("{} (peak {})", stats.CommandCount, stats.PeakCommandCount).c_str());
+			UI::Property("Size", std::format("{} (peak {})", Utils::BytesToString(stats.Size), Utils::BytesToString(stats.PeakSize)).c_str());
+			UI::Property("Reserved", std::format("{} in {} chunks", Utils::BytesToString(stats.ReservedSize), stats.ChunkCount).c_str());
+			UI::EndPropertyGrid();
+			UI::EndTreeNode();
+		}
+
 		ImGui::End();
 	}
 
@@ -10,6 +10,10 @@ namespace Luma {
 	{
 		bool ShowGrid = true;
 		bool ShowBoundingBoxes = false;
+		bool FrustumCulling = true;
+		bool SortDrawLists = true;
+		bool Instancing = true;
+		bool MultiDrawIndirect = true;
 	};
 
 	struct SceneRendererCamera
@@ -47,6 +51,7 @@ namespace Luma {
 		static void OnImGuiRender();
 	private:
 		static void FlushDrawList();
+		static void CullDrawList();
 		static void GeometryPass();
 		static void CompositePass();
 		static void BloomBlurPass();
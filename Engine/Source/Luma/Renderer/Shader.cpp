@@ -3,6 +3,7 @@
 
 #include "Luma/Renderer/Renderer.hpp"
 #include "Luma/Renderer/Backend/OpenGL/OpenGLShader.hpp"
+#include "Luma/Renderer/Backend/OpenGL/OpenGLShaderCache.hpp"
 
 namespace Luma {
 
@@ -34,6 +35,25 @@ namespace Luma {
 		return result;
 	}
 
+	void Shader::SetProgramCacheDirectory(const std::filesystem::path& directory)
+	{
+		switch (RendererAPI::Current())
+		{
+			case RendererAPIType::None: return;
+			case RendererAPIType::OpenGL: OpenGLShaderCache::SetDirectory(directory); return;
+		}
+	}
+
+	ShaderProgramCacheStats Shader::GetProgramCacheStats()
+	{
+		switch (RendererAPI::Current())
+		{
+			case RendererAPIType::None: return {};
+			case RendererAPIType::OpenGL: return OpenGLShaderCache::GetStats();
+		}
+		return {};
+	}
+
 	ShaderLibrary::ShaderLibrary()
 	{
 	}
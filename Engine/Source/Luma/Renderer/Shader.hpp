@@ -10,9 +10,21 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include <string>
+#include <filesystem>
 
 namespace Luma {
 
+	// Where the shader programs created so far came from, see Shader::SetProgramCacheDirectory
+	struct ShaderProgramCacheStats
+	{
+		uint32_t LoadedPrograms = 0;
+		uint32_t CompiledPrograms = 0;
+		// Rejected by the driver, compiled instead
+		uint32_t RejectedPrograms = 0;
+		// Spent creating programs on the render thread, loading or compiling
+		float ProgramCreationTime = 0.0f;
+	};
+
 	struct ShaderUniform
 	{
 	};
@@ -36,16 +48,15 @@ namespace Luma {
 		std::string Name;
 	};
 
-	struct UniformBuffer
+	// Material uniform data handed to a shader on bind. Version identifies the contents, 0 means untracked and
+	// always uploads everything. A shader that still holds PreviousVersion only needs the dirty byte range.
+	struct MaterialUniformUpdate
 	{
-		// TODO: This currently represents a byte buffer that has been
-		// packed with uniforms. This was primarily created for OpenGL,
-		// and needs to be revisted for other rendering APIs. Furthermore,
-		// this currently does not assume any alignment. This also has
-		// nothing to do with GL uniform buffers, this is simply a CPU-side
-		// buffer abstraction.
-		byte* Buffer;
-		std::vector<UniformDecl> Uniforms;
+		Buffer Data;
+		uint64_t Version = 0;
+		uint64_t PreviousVersion = 0;
+		uint32_t DirtyOffset = 0;
+		uint32_t DirtySize = 0;
 	};
 
 	struct UniformBufferBase
@@ -136,8 +147,13 @@ namespace Luma {
 		static Ref<Shader> Create(const std::string& filepath);
 		static Ref<Shader> CreateFromString(const std::string& source);
 
-		virtual void SetVSMaterialUniformBuffer(Buffer buffer) = 0;
-		virtual void SetPSMaterialUniformBuffer(Buffer buffer) = 0;
+		// Linked programs are stored in directory and loaded from there instead of being compiled again,
+		// as long as the sources and the driver stay the same. An empty path disables the cache.
+		static void SetProgramCacheDirectory(const std::filesystem::path& directory);
+		static ShaderProgramCacheStats GetProgramCacheStats();
+
+		virtual void SetVSMaterialUniformBuffer(const MaterialUniformUpdate& update) = 0;
+		virtual void SetPSMaterialUniformBuffer(const MaterialUniformUpdate& update) = 0;
 
 		virtual const ShaderUniformBufferList& GetVSRendererUniforms() const = 0;
 		virtual const ShaderUniformBufferList& GetPSRendererUniforms() const = 0;
@@ -0,0 +1,26 @@
+#include "lmpch.hpp"
+#include "ShadowCascadeCache.hpp"
+
+namespace Luma {
+
+	bool ShadowCascadeCache::Update(const glm::mat4& viewProjection, uint32_t framebufferVersion, const Caster* casters, uint32_t casterCount)
+	{
+		bool changed = !m_Valid || m_ViewProjection != viewProjection || m_FramebufferVersion != framebufferVersion || m_Casters.size() != casterCount;
+		for (uint32_t i = 0; i < casterCount && !changed; i++)
+		{
+			const Caster& caster = casters[i];
+			const Caster& cached = m_Casters[i];
+			changed = caster.Animated || cached.MeshID != caster.MeshID || cached.SubmeshIndex != caster.SubmeshIndex || cached.Transform != caster.Transform;
+		}
+
+		if (!changed)
+			return false;
+
+		m_Valid = true;
+		m_ViewProjection = viewProjection;
+		m_FramebufferVersion = framebufferVersion;
+		m_Casters.assign(casters, casters + casterCount);
+		return true;
+	}
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Luma/Core/Base.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Luma {
+
+	// What a shadow cascade was last rendered with. The cascade keeps its shadow map as long as its matrix,
+	// its casters and the framebuffer holding the map stay the same.
+	class ShadowCascadeCache
+	{
+	public:
+		struct Caster
+		{
+			uint64_t MeshID;
+			uint32_t SubmeshIndex;
+			glm::mat4 Transform;
+			// Animated casters count as changed every frame
+			bool Animated = false;
+		};
+
+		// Returns false if nothing changed since the last call, otherwise records the new state.
+		// framebufferVersion is Framebuffer::GetVersion of the shadow map.
+		bool Update(const glm::mat4& viewProjection, uint32_t framebufferVersion, const Caster* casters, uint32_t casterCount);
+		// The shadow map no longer holds what was recorded, e.g. because it was cleared
+		void Invalidate() { m_Valid = false; }
+
+		bool IsValid() const { return m_Valid; }
+	private:
+		bool m_Valid = false;
+		glm::mat4 m_ViewProjection;
+		uint32_t m_FramebufferVersion = 0;
+		std::vector<Caster> m_Casters;
+	};
+
+}
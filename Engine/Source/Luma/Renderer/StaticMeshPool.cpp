@@ -0,0 +1,144 @@
+#include "lmpch.hpp"
+#include "StaticMeshPool.hpp"
+
+#include "Renderer.hpp"
+#include "UploadBuffer.hpp"
+
+#include "Luma/Core/RangeAllocator.hpp"
+#include "Luma/Renderer/Backend/OpenGL/OpenGLState.hpp"
+
+#include <glad/glad.h>
+
+namespace Luma {
+
+	struct StaticMeshPoolData
+	{
+		// Guards the allocators, the commands that resize and fill the buffers are submitted under it as well
+		// so that they execute in allocation order
+		std::mutex Mutex;
+		RangeAllocator Vertices;
+		RangeAllocator Indices;
+
+		// Render thread
+		RendererID VertexBuffer = 0;
+		RendererID IndexBuffer = 0;
+
+		Ref<Pipeline> VertexArray;
+	};
+
+	static StaticMeshPoolData s_Data;
+
+	static constexpr uint32_t s_InitialVertexCapacity = 64 * 1024;
+	static constexpr uint32_t s_InitialIndexCapacity = 256 * 1024;
+
+	// Render thread: moves the contents of buffer into new storage of newSize bytes
+	static void ResizeBuffer(RendererID& buffer, uint32_t oldSize, uint32_t newSize)
+	{
+		RendererID newBuffer = 0;
+		glCreateBuffers(1, &newBuffer);
+		glNamedBufferData(newBuffer, newSize, nullptr, GL_STATIC_DRAW);
+
+		if (buffer)
+		{
+			glCopyNamedBufferSubData(buffer, newBuffer, 0, 0, oldSize);
+			OpenGLState::OnBufferDeleted(buffer);
+			glDeleteBuffers(1, &buffer);
+		}
+		buffer = newBuffer;
+	}
+
+	// Grows allocator so that a range of size fits, returns its offset
+	static uint32_t AllocateRange(RangeAllocator& allocator, uint32_t size, uint32_t initialCapacity, uint32_t elementSize, RendererID* buffer)
+	{
+		uint32_t offset = allocator.Allocate(size);
+		if (offset != RangeAllocator::InvalidOffset)
+			return offset;
+
+		const uint32_t oldCapacity = allocator.GetCapacity();
+		const uint32_t newCapacity = std::max({ oldCapacity * 2, oldCapacity + size, initialCapacity });
+		allocator.Grow(newCapacity);
+		Renderer::Submit([buffer, oldSize = oldCapacity * elementSize, newSize = newCapacity * elementSize]()
+		{
+			ResizeBuffer(*buffer, oldSize, newSize);
+		});
+
+		offset = allocator.Allocate(size);
+		LM_CORE_ASSERT(offset != RangeAllocator::InvalidOffset);
+		return offset;
+	}
+
+	void StaticMeshPool::Init()
+	{
+		PipelineSpecification pipelineSpecification;
+		pipelineSpecification.Layout = {
+			{ ShaderDataType::Float3, "a_Position" },
+			{ ShaderDataType::Float3, "a_Normal" },
+			{ ShaderDataType::Float3, "a_Tangent" },
+			{ ShaderDataType::Float3, "a_Binormal" },
+			{ ShaderDataType::Float2, "a_TexCoord" },
+		};
+		s_Data.VertexArray = Pipeline::Create(pipelineSpecification);
+	}
+
+	StaticMeshAllocation StaticMeshPool::Allocate(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount)
+	{
+		if (vertexCount == 0 || indexCount == 0)
+			return {};
+
+		StaticMeshAllocation allocation;
+		allocation.VertexCount = vertexCount;
+		allocation.IndexCount = indexCount;
+
+		Ref<UploadBuffer> vertexData = UploadBuffer::Copy(vertices, vertexCount * sizeof(Vertex));
+		Ref<UploadBuffer> indexData = UploadBuffer::Copy(indices, indexCount * sizeof(uint32_t));
+
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+		allocation.BaseVertex = AllocateRange(s_Data.Vertices, vertexCount, s_InitialVertexCapacity, sizeof(Vertex), &s_Data.VertexBuffer);
+		allocation.BaseIndex = AllocateRange(s_Data.Indices, indexCount, s_InitialIndexCapacity, sizeof(uint32_t), &s_Data.IndexBuffer);
+
+		Renderer::Submit([allocation, vertexData, indexData]()
+		{
+			glNamedBufferSubData(s_Data.VertexBuffer, allocation.BaseVertex * sizeof(Vertex), vertexData->GetSize(), vertexData->GetData());
+			glNamedBufferSubData(s_Data.IndexBuffer, allocation.BaseIndex * sizeof(uint32_t), indexData->GetSize(), indexData->GetData());
+		});
+
+		return allocation;
+	}
+
+	void StaticMeshPool::Free(const StaticMeshAllocation& allocation)
+	{
+		if (!allocation.IsValid())
+			return;
+
+		// Draws recorded before this point still execute before anything that reuses the ranges gets uploaded
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+		s_Data.Vertices.Free(allocation.BaseVertex, allocation.VertexCount);
+		s_Data.Indices.Free(allocation.BaseIndex, allocation.IndexCount);
+	}
+
+	void StaticMeshPool::Bind()
+	{
+		Renderer::Submit([]()
+		{
+			OpenGLState::BindBuffer(GL_ARRAY_BUFFER, s_Data.VertexBuffer);
+		});
+		s_Data.VertexArray->Bind();
+		Renderer::Submit([]()
+		{
+			OpenGLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_Data.IndexBuffer);
+		});
+	}
+
+	StaticMeshPoolStats StaticMeshPool::GetStats()
+	{
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+
+		StaticMeshPoolStats stats;
+		stats.VertexCapacity = s_Data.Vertices.GetCapacity();
+		stats.UsedVertices = s_Data.Vertices.GetUsedSize();
+		stats.IndexCapacity = s_Data.Indices.GetCapacity();
+		stats.UsedIndices = s_Data.Indices.GetUsedSize();
+		return stats;
+	}
+
+}
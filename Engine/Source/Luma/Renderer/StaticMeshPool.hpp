@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Luma {
+
+	struct Vertex;
+
+	// Where a static mesh lives in the StaticMeshPool buffers, counted in vertices and indices
+	struct StaticMeshAllocation
+	{
+		uint32_t BaseVertex = 0;
+		uint32_t VertexCount = 0;
+		uint32_t BaseIndex = 0;
+		uint32_t IndexCount = 0;
+
+		bool IsValid() const { return VertexCount > 0; }
+	};
+
+	struct StaticMeshPoolStats
+	{
+		uint32_t VertexCapacity = 0;
+		uint32_t UsedVertices = 0;
+		uint32_t IndexCapacity = 0;
+		uint32_t UsedIndices = 0;
+	};
+
+	// Vertices and indices of every static Mesh merged into one vertex and one index buffer, so that submeshes
+	// of different meshes can be drawn by the same multi-draw. The buffers grow on demand and the ranges
+	// of destroyed meshes are reused. Indices stay relative to their mesh and are drawn with a base vertex.
+	class StaticMeshPool
+	{
+	public:
+		static void Init();
+
+		// Copies the data, returns an invalid allocation for empty meshes
+		static StaticMeshAllocation Allocate(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+		static void Free(const StaticMeshAllocation& allocation);
+
+		// Binds the buffers and the static vertex layout, like Mesh does with its own buffers
+		static void Bind();
+
+		static StaticMeshPoolStats GetStats();
+	};
+
+}
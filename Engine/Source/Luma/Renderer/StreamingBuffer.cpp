@@ -0,0 +1,21 @@
+#include "lmpch.hpp"
+#include "StreamingBuffer.hpp"
+
+#include "Renderer.hpp"
+
+#include "Luma/Renderer/Backend/OpenGL/OpenGLStreamingBuffer.hpp"
+
+namespace Luma {
+
+	Ref<StreamingBuffer> StreamingBuffer::Create(uint32_t regionSize, uint32_t maxRegionSize)
+	{
+		switch (RendererAPI::Current())
+		{
+			case RendererAPIType::None:    return nullptr;
+			case RendererAPIType::OpenGL:  return Ref<OpenGLStreamingBuffer>::Create(regionSize, maxRegionSize);
+		}
+		LM_CORE_ASSERT(false, "Unknown RendererAPI");
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Luma/Core/Ref.hpp"
+
+#include "RendererTypes.hpp"
+
+namespace Luma {
+
+	// Persistently mapped vertex buffer for data that is rewritten every frame. The storage is split into
+	// RegionCount regions and frame N writes into region N % RegionCount, so the CPU fills one region while
+	// the GPU still reads the previous ones. Writes go straight into GPU-visible memory, there is no staging
+	// copy and no buffer update call that could wait for the GPU. When a frame asks for more than a region holds,
+	// the buffer grows for the following frames, up to maxRegionSize.
+	class StreamingBuffer : public RefCounted
+	{
+	public:
+		static constexpr uint32_t RegionCount = 3;
+
+		virtual ~StreamingBuffer() {}
+
+		// Reserves size bytes in the region of the current frame and returns where to write them. Returns nullptr
+		// if the region is full or the GPU might still be reading it, the caller has to upload some other way then.
+		virtual void* Map(uint32_t size) = 0;
+		// Ends the write started by Map, only the first size bytes are kept. Returns the offset of the data in the buffer.
+		virtual uint32_t Unmap(uint32_t size) = 0;
+		// Call after the draws reading this frame's data have been submitted, the region is reused once they completed
+		virtual void Fence() = 0;
+		virtual void Bind() const = 0;
+
+		virtual uint32_t GetRegionSize() const = 0;
+		virtual RendererID GetRendererID() const = 0;
+
+		static Ref<StreamingBuffer> Create(uint32_t regionSize, uint32_t maxRegionSize = 0);
+	};
+
+}
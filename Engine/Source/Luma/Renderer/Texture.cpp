@@ -2,6 +2,7 @@
 #include "Texture.hpp"
 
 #include "Luma/Renderer/RendererAPI.hpp"
+#include "Luma/Renderer/Renderer2D.hpp"
 #include "Luma/Renderer/Backend/OpenGL/OpenGLTexture.hpp"
 
 namespace Luma {
@@ -26,6 +27,31 @@ namespace Luma {
 		return nullptr;
 	}
 
+	Texture2D::~Texture2D()
+	{
+		Renderer2D::OnTextureDestroyed(m_ID);
+	}
+
+	Ref<Texture2DArray> Texture2DArray::Create(const Ref<Texture2D>& layout, uint32_t layerCount)
+	{
+		switch (RendererAPI::Current())
+		{
+			case RendererAPIType::None: return nullptr;
+			case RendererAPIType::OpenGL: return Ref<OpenGLTexture2DArray>::Create(layout.As<OpenGLTexture2D>(), layerCount);
+		}
+		return nullptr;
+	}
+
+	uint64_t Texture2DArray::GetLayoutKey(const Ref<Texture2D>& texture)
+	{
+		switch (RendererAPI::Current())
+		{
+			case RendererAPIType::None: return 0;
+			case RendererAPIType::OpenGL: return OpenGLTexture2DArray::GetLayoutKey(texture.As<OpenGLTexture2D>());
+		}
+		return 0;
+	}
+
 	Ref<TextureCube> TextureCube::Create(TextureFormat format, uint32_t width, uint32_t height)
 	{
 		switch (RendererAPI::Current())
@@ -2,7 +2,9 @@
 
 #include "Luma/Core/Base.hpp"
 #include "Luma/Core/Buffer.hpp"
+#include "Luma/Core/UUID.hpp"
 #include "RendererTypes.hpp"
+#include "UploadBuffer.hpp"
 
 namespace Luma {
 
@@ -48,15 +50,44 @@ namespace Luma {
 		static Ref<Texture2D> Create(TextureFormat format, uint32_t width, uint32_t height, TextureWrap wrap = TextureWrap::Clamp);
 		static Ref<Texture2D> Create(const std::string& path, bool srgb = false);
 
+		virtual ~Texture2D();
+
 		virtual void Lock() = 0;
 		virtual void Unlock() = 0;
 
 		virtual void Resize(uint32_t width, uint32_t height) = 0;
 		virtual Buffer GetWriteableBuffer() = 0;
 
+		// Replaces the whole image with data, which must hold width * height * BPP bytes. Not copied
+		virtual void SetData(Ref<UploadBuffer> data) = 0;
+
 		virtual bool Loaded() const = 0;
+		// Incremented whenever Unlock or SetData replaces the image, copies of the texture compare against it
+		virtual uint32_t GetDataVersion() const = 0;
 
 		virtual const std::string& GetPath() const = 0;
+
+		// Unlike the address of a destroyed texture, never reused by another one
+		UUID GetID() const { return m_ID; }
+	private:
+		UUID m_ID;
+	};
+
+	// Layers of equally sized textures behind a single binding. The layers are filled by copying
+	// existing textures on the GPU, see Texture2DArray::GetLayoutKey for which textures fit together.
+	class Texture2DArray : public Texture
+	{
+	public:
+		// Size, format and sampling of the layers are taken from layout
+		static Ref<Texture2DArray> Create(const Ref<Texture2D>& layout, uint32_t layerCount);
+		// Textures with the same key can be copied into the same array. 0 if the texture can't be copied
+		static uint64_t GetLayoutKey(const Ref<Texture2D>& texture);
+
+		virtual uint32_t GetLayerCount() const = 0;
+		// Layers below the new count keep their contents
+		virtual void Resize(uint32_t layerCount) = 0;
+		// Copies the current contents of source into layer, source must match the layout of the array
+		virtual void CopyLayer(uint32_t layer, const Ref<Texture2D>& source) = 0;
 	};
 
 	class TextureCube : public Texture
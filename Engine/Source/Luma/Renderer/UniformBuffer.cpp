@@ -0,0 +1,21 @@
+#include "lmpch.hpp"
+#include "UniformBuffer.hpp"
+
+#include "Renderer.hpp"
+
+#include "Luma/Renderer/Backend/OpenGL/OpenGLUniformBuffer.hpp"
+
+namespace Luma {
+
+	Ref<UniformBuffer> UniformBuffer::Create(uint32_t size, uint32_t binding)
+	{
+		switch (RendererAPI::Current())
+		{
+			case RendererAPIType::None:    return nullptr;
+			case RendererAPIType::OpenGL:  return Ref<OpenGLUniformBuffer>::Create(size, binding);
+		}
+		LM_CORE_ASSERT(false, "Unknown RendererAPI");
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Luma/Core/Ref.hpp"
+
+#include "RendererTypes.hpp"
+
+namespace Luma {
+
+	// GPU buffer behind a shader uniform block. The block has to be declared with an explicit
+	// binding (layout(std140, binding = N)) and the C++ side has to follow the std140 rules.
+	class UniformBuffer : public RefCounted
+	{
+	public:
+		virtual ~UniformBuffer() {}
+
+		// Copies data, so the caller's memory can be reused right away
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+		// Binds the buffer to its binding point
+		virtual void Bind() const = 0;
+
+		virtual uint32_t GetSize() const = 0;
+		virtual uint32_t GetBinding() const = 0;
+		virtual RendererID GetRendererID() const = 0;
+
+		static Ref<UniformBuffer> Create(uint32_t size, uint32_t binding);
+	};
+
+}
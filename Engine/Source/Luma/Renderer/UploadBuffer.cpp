@@ -0,0 +1,115 @@
+#include "lmpch.hpp"
+#include "UploadBuffer.hpp"
+
+namespace Luma {
+
+	// Storage is rounded up to a power of two so a released block can be reused by any upload in the same class
+	static constexpr uint64_t s_MinStorageSize = 4 * 1024;
+	static constexpr uint32_t s_StorageClassCount = 20; // 4KB .. 2GB
+	static constexpr uint64_t s_MaxRecycledSize = 128 * 1024 * 1024;
+	static constexpr uint64_t s_StorageAlignment = 64;
+
+	struct UploadBufferData
+	{
+		std::mutex Mutex;
+		std::array<std::vector<Buffer>, s_StorageClassCount> FreeStorage;
+		UploadBufferStats Stats;
+	};
+
+	static UploadBufferData s_Data;
+
+	static uint32_t GetStorageClass(uint64_t size)
+	{
+		uint32_t storageClass = 0;
+		while ((s_MinStorageSize << storageClass) < size)
+			storageClass++;
+		return storageClass;
+	}
+
+	static Buffer AcquireStorage(uint64_t size)
+	{
+		uint32_t storageClass = GetStorageClass(size);
+		LM_CORE_ASSERT(storageClass < s_StorageClassCount, "Upload is too large!");
+
+		{
+			std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+			auto& freeStorage = s_Data.FreeStorage[storageClass];
+			if (!freeStorage.empty())
+			{
+				Buffer storage = freeStorage.back();
+				freeStorage.pop_back();
+				s_Data.Stats.RecycledSize -= storage.Size;
+				return storage;
+			}
+		}
+
+		Buffer storage;
+		storage.Allocate(s_MinStorageSize << storageClass, s_StorageAlignment);
+		return storage;
+	}
+
+	static void RecycleStorage(Buffer storage)
+	{
+		{
+			std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+			if (s_Data.Stats.RecycledSize + storage.Size <= s_MaxRecycledSize)
+			{
+				s_Data.FreeStorage[GetStorageClass(storage.Size)].push_back(storage);
+				s_Data.Stats.RecycledSize += storage.Size;
+				return;
+			}
+		}
+
+		storage.Release();
+	}
+
+	UploadBuffer::UploadBuffer(Buffer storage, uint64_t size)
+		: m_Storage(storage), m_Size(size)
+	{
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+		s_Data.Stats.LiveSize += m_Storage.Size;
+		s_Data.Stats.LiveCount++;
+	}
+
+	UploadBuffer::~UploadBuffer()
+	{
+		{
+			std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+			s_Data.Stats.LiveSize -= m_Storage.Size;
+			s_Data.Stats.LiveCount--;
+		}
+
+		RecycleStorage(m_Storage);
+	}
+
+	Ref<UploadBuffer> UploadBuffer::Create(uint64_t size)
+	{
+		return Ref<UploadBuffer>::Create(AcquireStorage(size), size);
+	}
+
+	Ref<UploadBuffer> UploadBuffer::Copy(const void* data, uint64_t size)
+	{
+		Ref<UploadBuffer> buffer = Create(size);
+		memcpy(buffer->GetWriteableData(), data, size);
+		return buffer;
+	}
+
+	UploadBufferStats UploadBuffer::GetStats()
+	{
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+		return s_Data.Stats;
+	}
+
+	void UploadBuffer::ReleaseRecycledStorage()
+	{
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+		for (auto& freeStorage : s_Data.FreeStorage)
+		{
+			for (Buffer& storage : freeStorage)
+				storage.Release();
+			freeStorage.clear();
+		}
+		s_Data.Stats.RecycledSize = 0;
+	}
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Luma/Core/Base.hpp"
+#include "Luma/Core/Buffer.hpp"
+
+namespace Luma {
+
+	struct UploadBufferStats
+	{
+		uint64_t LiveSize = 0;
+		uint64_t RecycledSize = 0;
+		uint32_t LiveCount = 0;
+	};
+
+	// Ref-counted staging memory for GPU uploads. Render commands capture the Ref, so the data stays alive
+	// until the upload has executed without being copied into the command. Once the last reference is
+	// released the storage goes back to a free list and is reused by the next upload of a similar size.
+	// The contents must not change after the buffer has been handed to a SetData call.
+	class UploadBuffer : public RefCounted
+	{
+	public:
+		UploadBuffer(Buffer storage, uint64_t size);
+		virtual ~UploadBuffer();
+
+		// Uninitialized storage, fill it through GetWriteableData before submitting it
+		static Ref<UploadBuffer> Create(uint64_t size);
+		static Ref<UploadBuffer> Copy(const void* data, uint64_t size);
+
+		void* GetWriteableData() { return m_Storage.Data; }
+		const void* GetData() const { return m_Storage.Data; }
+		uint64_t GetSize() const { return m_Size; }
+		BufferView GetView() const { return BufferView(m_Storage.Data, m_Size); }
+
+		static UploadBufferStats GetStats();
+		// Frees the storage kept for reuse
+		static void ReleaseRecycledStorage();
+	private:
+		Buffer m_Storage;
+		uint64_t m_Size = 0;
+	};
+
+	LM_POOLED_REF(UploadBuffer);
+
+}
@@ -52,6 +52,8 @@ namespace Luma {
 		auto skyboxShader = Shader::Create("Resources/Shaders/Skybox.glsl");
 		m_SkyboxMaterial = MaterialInstance::Create(Material::Create(skyboxShader));
 		m_SkyboxMaterial->SetFlag(MaterialFlag::DepthTest, false);
+		m_SkyboxTextureLodHandle = m_SkyboxMaterial->GetUniformHandle("u_TextureLod");
+		m_SkyboxTextureHandle = m_SkyboxMaterial->GetResourceHandle("u_Texture");
 	}
 
 	static std::tuple<glm::vec3, glm::quat, glm::vec3> GetTransformDecomposition(const glm::mat4& transform)
@@ -132,7 +134,7 @@ namespace Luma {
 			}
 		}
 
-		m_SkyboxMaterial->Set("u_TextureLod", m_SkyboxLod);
+		m_SkyboxMaterial->Set(m_SkyboxTextureLodHandle, m_SkyboxLod);
 
 		auto group = m_Registry.group<MeshComponent>(entt::get<TransformComponent>);
 		SceneRenderer::BeginScene(this, { camera, cameraViewMatrix });
@@ -206,7 +208,7 @@ namespace Luma {
 			}
 		}
 
-		m_SkyboxMaterial->Set("u_TextureLod", m_SkyboxLod);
+		m_SkyboxMaterial->Set(m_SkyboxTextureLodHandle, m_SkyboxLod);
 
 		auto group = m_Registry.group<MeshComponent>(entt::get<TransformComponent>);
 		SceneRenderer::BeginScene(this, { editorCamera, editorCamera.GetViewMatrix(), 0.1f, 1000.0f, 45.0f }); // TODO: real values
@@ -272,7 +274,7 @@ namespace Luma {
 	void Scene::SetSkybox(const Ref<TextureCube>& skybox)
 	{
 		m_SkyboxTexture = skybox;
-		m_SkyboxMaterial->Set("u_Texture", skybox);
+		m_SkyboxMaterial->Set(m_SkyboxTextureHandle, skybox);
 	}
 
 	Entity Scene::GetMainCameraEntity()
@@ -413,6 +415,8 @@ namespace Luma {
 		target->m_Environment = m_Environment;
 		target->m_SkyboxTexture = m_SkyboxTexture;
 		target->m_SkyboxMaterial = m_SkyboxMaterial;
+		target->m_SkyboxTextureLodHandle = m_SkyboxTextureLodHandle;
+		target->m_SkyboxTextureHandle = m_SkyboxTextureHandle;
 		target->m_SkyboxLod = m_SkyboxLod;
 
 		std::unordered_map<UUID, entt::entity> enttMap;
@@ -116,6 +116,8 @@ namespace Luma {
 		float m_EnvironmentIntensity = 1.0f;
 		Ref<TextureCube> m_SkyboxTexture;
 		Ref<MaterialInstance> m_SkyboxMaterial;
+		MaterialUniformHandle m_SkyboxTextureLodHandle;
+		MaterialResourceHandle m_SkyboxTextureHandle;
 
 		entt::entity m_SelectedEntity;
 
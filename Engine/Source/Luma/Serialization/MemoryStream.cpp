@@ -28,7 +28,7 @@ namespace Luma
 
 	//==============================================================================
 	/// MemoryStreamReader
-	MemoryStreamReader::MemoryStreamReader(const Buffer& buffer)
+	MemoryStreamReader::MemoryStreamReader(BufferView buffer)
 		: m_Buffer(buffer)
 	{
 	}
@@ -42,11 +42,21 @@ namespace Luma
 		if (m_ReadPos + size > m_Buffer.Size)
 			return false;
 
-		memcpy(destination, (char*)m_Buffer.Data + m_ReadPos, size);
+		memcpy(destination, (const char*)m_Buffer.Data + m_ReadPos, size);
 		m_ReadPos += size;
 		return true;
 	}
 
+	BufferView MemoryStreamReader::ReadView(uint64_t size)
+	{
+		if (m_ReadPos + size > m_Buffer.Size)
+			return {};
+
+		BufferView view = m_Buffer.Slice(m_ReadPos, size);
+		m_ReadPos += size;
+		return view;
+	}
+
 	size_t MemoryStreamReader::GetStreamLength()
 	{
 		return m_Buffer.Size;
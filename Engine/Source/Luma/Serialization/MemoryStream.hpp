@@ -30,7 +30,7 @@ namespace Luma
 	class MemoryStreamReader : public StreamReader
 	{
 	public:
-		MemoryStreamReader(const Buffer& buffer);
+		MemoryStreamReader(BufferView buffer);
 		MemoryStreamReader(const MemoryStreamReader&) = delete;
 		~MemoryStreamReader();
 
@@ -39,9 +39,10 @@ namespace Luma
 		void SetStreamPosition(uint64_t position) final { m_ReadPos = position; }
 		bool ReadData(char* destination, size_t size) final;
 		size_t GetStreamLength() override;
+		BufferView ReadView(uint64_t size) override;
 
 	private:
-		const Buffer& m_Buffer;
+		BufferView m_Buffer;
 		size_t m_ReadPos = 0;
 	};
 
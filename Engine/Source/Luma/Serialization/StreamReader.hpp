@@ -18,6 +18,10 @@ namespace Luma
 		// if applicable (may not be valid for network streams)
 		virtual size_t GetStreamLength() = 0;
 
+		// Returns the next size bytes without copying them and advances the stream. Only memory backed
+		// streams can do this, others return an empty view and leave the position unchanged.
+		virtual BufferView ReadView(uint64_t size) { return {}; }
+
 		operator bool() const { return IsStreamGood(); }
 
 		void ReadBuffer(Buffer& buffer, uint32_t size = 0);
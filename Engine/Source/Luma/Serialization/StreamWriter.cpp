@@ -3,12 +3,12 @@
 
 namespace Luma
 {
-	void StreamWriter::WriteBuffer(Buffer buffer, bool writeSize)
+	void StreamWriter::WriteBuffer(BufferView buffer, bool writeSize)
 	{
 		if (writeSize)
-			WriteData((char*)&buffer.Size, sizeof(uint64_t));
+			WriteData((const char*)&buffer.Size, sizeof(uint64_t));
 
-		WriteData((char*)buffer.Data, buffer.Size);
+		WriteData((const char*)buffer.Data, buffer.Size);
 	}
 
 	void StreamWriter::WriteZero(uint64_t size)
@@ -18,7 +18,7 @@ namespace Luma
 
 		operator bool() const { return IsStreamGood(); }
 
-		void WriteBuffer(Buffer buffer, bool writeSize = true);
+		void WriteBuffer(BufferView buffer, bool writeSize = true);
 		void WriteZero(uint64_t size);
 		void WriteString(const std::string& string);
 
@@ -54,8 +54,9 @@ namespace Luma {
 		static bool OpenDirectoryInExplorer(const std::filesystem::path& path);
 		static bool OpenExternally(const std::filesystem::path& path);
 
-		static bool WriteBytes(const std::filesystem::path& filepath, const Buffer& buffer);
-		static Buffer ReadBytes(const std::filesystem::path& filepath);
+		static bool WriteBytes(const std::filesystem::path& filepath, BufferView buffer);
+		// The whole file is read into one aligned allocation, slice it with BufferView instead of copying sub-ranges
+		static Buffer ReadBytes(const std::filesystem::path& filepath, uint64_t alignment = Buffer::DefaultAlignment);
 
 		static std::filesystem::path GetUniqueFileName(const std::filesystem::path& filepath);
 		static uint64_t GetLastWriteTime(const std::filesystem::path& filepath);
@@ -1,6 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "Luma/Core/Buffer.hpp"
+#include "Luma/Serialization/MemoryStream.hpp"
 
 #include <glm/glm.hpp>
 
@@ -521,4 +522,149 @@ TEST_CASE("Buffer edge cases", "[unit][core][buffer]")
 		REQUIRE(buffer[512 * 1024] == 0xBB);
 		REQUIRE(buffer[1024 * 1024 - 1] == 0xCC);
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("Buffer aligned allocation", "[unit][core][buffer]")
+{
+	SECTION("Default allocation keeps fundamental alignment")
+	{
+		Buffer buffer;
+		buffer.Allocate(100);
+
+		REQUIRE((uintptr_t)buffer.Data % alignof(std::max_align_t) == 0);
+		buffer.Release();
+	}
+
+	SECTION("Allocate honours larger alignments")
+	{
+		for (uint64_t alignment : { 16, 64, 256, 4096 })
+		{
+			Buffer buffer;
+			buffer.Allocate(33, alignment);
+
+			REQUIRE(buffer.GetView().IsAligned(alignment));
+			REQUIRE(buffer.Size == 33);
+			buffer.Release();
+		}
+	}
+
+	SECTION("Reallocating with a different alignment releases the old block")
+	{
+		Buffer buffer;
+		buffer.Allocate(64, 64);
+		buffer.Allocate(128, 16);
+
+		REQUIRE(buffer.Size == 128);
+		REQUIRE(buffer.GetView().IsAligned(16));
+		buffer.Release();
+
+		REQUIRE(buffer.Data == nullptr);
+	}
+}
+
+TEST_CASE("Buffer ownership", "[unit][core][buffer]")
+{
+	SECTION("Releasing a wrapped buffer leaves the memory alone")
+	{
+		byte testData[64] = {};
+		testData[0] = 0x42;
+
+		Buffer buffer(testData, sizeof(testData));
+		buffer.Release();
+
+		REQUIRE(buffer.Data == nullptr);
+		REQUIRE(buffer.Size == 0);
+		REQUIRE(testData[0] == 0x42);
+	}
+
+	SECTION("Data assigned after construction is not freed")
+	{
+		byte testData[16] = {};
+
+		Buffer buffer;
+		buffer.Data = testData;
+		buffer.Size = sizeof(testData);
+		buffer.Release();
+
+		REQUIRE(buffer.Data == nullptr);
+	}
+
+	SECTION("Allocating over wrapped memory only frees the new block")
+	{
+		byte testData[16] = {};
+
+		Buffer buffer(testData, sizeof(testData));
+		buffer.Allocate(32, 64);
+
+		REQUIRE(buffer.Data != testData);
+		REQUIRE(buffer.GetView().IsAligned(64));
+		buffer.Release();
+
+		REQUIRE(buffer.Data == nullptr);
+	}
+}
+
+TEST_CASE("BufferView", "[unit][core][buffer]")
+{
+	uint32_t values[] = { 10, 20, 30, 40 };
+	BufferView view(values, sizeof(values));
+
+	SECTION("View of a Buffer shares its memory")
+	{
+		Buffer buffer(values, sizeof(values));
+		BufferView bufferView = buffer;
+
+		REQUIRE(bufferView.Data == buffer.Data);
+		REQUIRE(bufferView.Size == buffer.Size);
+	}
+
+	SECTION("Slice points into the original memory")
+	{
+		BufferView slice = view.Slice(sizeof(uint32_t), 2 * sizeof(uint32_t));
+
+		REQUIRE(slice.Data == &values[1]);
+		REQUIRE(slice.Size == 2 * sizeof(uint32_t));
+		REQUIRE(slice.Read<uint32_t>() == 20);
+		REQUIRE(slice.Read<uint32_t>(sizeof(uint32_t)) == 30);
+	}
+
+	SECTION("Slice without a size runs to the end")
+	{
+		BufferView slice = view.Slice(3 * sizeof(uint32_t));
+
+		REQUIRE(slice.Size == sizeof(uint32_t));
+		REQUIRE(*slice.As<uint32_t>() == 40);
+	}
+
+	SECTION("Empty slices at the end are valid")
+	{
+		BufferView slice = view.Slice(sizeof(values), 0);
+		REQUIRE(slice.Size == 0);
+	}
+
+	SECTION("Buffer::ReadBytes returns a view instead of a copy")
+	{
+		Buffer buffer(values, sizeof(values));
+		BufferView bytes = buffer.ReadBytes(sizeof(uint32_t), 2 * sizeof(uint32_t));
+
+		REQUIRE(bytes.Data == &values[2]);
+		REQUIRE(bytes.Read<uint32_t>() == 30);
+	}
+
+	SECTION("MemoryStreamReader hands out views of its buffer")
+	{
+		MemoryStreamReader reader(view);
+
+		uint32_t first;
+		reader.ReadRaw(first);
+		BufferView rest = reader.ReadView(2 * sizeof(uint32_t));
+
+		REQUIRE(first == 10);
+		REQUIRE(rest.Data == &values[1]);
+		REQUIRE(reader.GetStreamPosition() == 3 * sizeof(uint32_t));
+
+		BufferView tooLarge = reader.ReadView(2 * sizeof(uint32_t));
+		REQUIRE_FALSE(tooLarge);
+		REQUIRE(reader.GetStreamPosition() == 3 * sizeof(uint32_t));
+	}
+}
@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "Luma/Core/Base.hpp"
+#include "Luma/Core/FrameAllocator.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace Luma;
+
+TEST_CASE("LinearAllocator", "[unit][core][memory]")
+{
+	SECTION("Allocations respect the requested alignment")
+	{
+		LinearAllocator allocator(1024);
+
+		allocator.Allocate(1);
+		for (size_t alignment : { 4, 16, 64, 256 })
+		{
+			void* memory = allocator.Allocate(8, alignment);
+			REQUIRE((uintptr_t)memory % alignment == 0);
+		}
+	}
+
+	SECTION("Reset hands out the same memory again")
+	{
+		LinearAllocator allocator(1024);
+
+		void* first = allocator.Allocate(64);
+		allocator.Reset();
+
+		REQUIRE(allocator.GetUsedSize() == 0);
+		REQUIRE(allocator.Allocate(64) == first);
+	}
+
+	SECTION("Overflow grows the block on the next reset")
+	{
+		LinearAllocator allocator(256);
+
+		void* a = allocator.Allocate(200);
+		void* b = allocator.Allocate(200);
+		REQUIRE(a != nullptr);
+		REQUIRE(b != nullptr);
+		REQUIRE(allocator.GetUsedSize() == 400);
+
+		allocator.Reset();
+
+		REQUIRE(allocator.GetCapacity() >= 400);
+		REQUIRE(allocator.GetPeakUsedSize() == 400);
+
+		size_t grownCapacity = allocator.GetCapacity();
+		allocator.Allocate(200);
+		allocator.Allocate(200);
+		allocator.Reset();
+
+		REQUIRE(allocator.GetCapacity() == grownCapacity);
+	}
+
+	SECTION("Concurrent allocations don't overlap")
+	{
+		constexpr uint32_t threadCount = 8;
+		constexpr uint32_t allocationsPerThread = 1000;
+
+		LinearAllocator allocator(threadCount * allocationsPerThread * sizeof(uint64_t) / 2);
+		std::atomic<uint32_t> failures = 0;
+
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0; t < threadCount; t++)
+		{
+			threads.emplace_back([&allocator, &failures, t]()
+			{
+				std::vector<uint64_t*> values;
+				for (uint32_t i = 0; i < allocationsPerThread; i++)
+				{
+					uint64_t* value = (uint64_t*)allocator.Allocate(sizeof(uint64_t), alignof(uint64_t));
+					*value = ((uint64_t)t << 32) | i;
+					values.push_back(value);
+				}
+
+				for (uint32_t i = 0; i < allocationsPerThread; i++)
+				{
+					if (*values[i] != (((uint64_t)t << 32) | i))
+						failures++;
+				}
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		REQUIRE(failures == 0);
+	}
+}
+
+TEST_CASE("FrameAllocator", "[unit][core][memory]")
+{
+	FrameAllocator::Init(1024);
+
+	SECTION("Memory stays valid for one frame after it was allocated")
+	{
+		uint32_t* value = FrameAllocator::Allocate<uint32_t>(1);
+		*value = 42;
+
+		FrameAllocator::BeginFrame();
+		FrameAllocator::Allocate<uint32_t>(16);
+
+		REQUIRE(*value == 42);
+	}
+
+	SECTION("Arenas are reused every other frame")
+	{
+		FrameAllocator::BeginFrame();
+		void* first = FrameAllocator::Allocate(32);
+		FrameAllocator::BeginFrame();
+		FrameAllocator::BeginFrame();
+
+		REQUIRE(FrameAllocator::Allocate(32) == first);
+	}
+
+	SECTION("FrameVector allocates from the current arena")
+	{
+		FrameAllocator::BeginFrame();
+		size_t usedBefore = FrameAllocator::GetStats().UsedSize;
+
+		FrameVector<int> values;
+		for (int i = 0; i < 100; i++)
+			values.push_back(i);
+
+		REQUIRE(values[99] == 99);
+		REQUIRE(FrameAllocator::GetStats().UsedSize - usedBefore >= 100 * sizeof(int));
+	}
+
+	FrameAllocator::Shutdown();
+}
+
+TEST_CASE("FrameAllocator throughput", "[benchmark][core][memory][.]")
+{
+	constexpr uint32_t ElementCount = 10000;
+
+	FrameAllocator::Init();
+
+	BENCHMARK("std::vector push_back")
+	{
+		std::vector<uint64_t> values;
+		for (uint32_t i = 0; i < ElementCount; i++)
+			values.push_back(i);
+		return values.size();
+	};
+
+	BENCHMARK("FrameVector push_back")
+	{
+		FrameAllocator::BeginFrame();
+		FrameVector<uint64_t> values;
+		for (uint32_t i = 0; i < ElementCount; i++)
+			values.push_back(i);
+		return values.size();
+	};
+
+	FrameAllocator::Shutdown();
+}
@@ -177,6 +177,25 @@ TEST_CASE("Hash FNV special cases", "[unit][core][hash]")
 	}
 }
 
+TEST_CASE("Hash FNV 64-bit", "[unit][core][hash]")
+{
+	SECTION("Known FNV-1a values")
+	{
+		STATIC_REQUIRE(Hash::GenerateFNVHash64("") == 0xcbf29ce484222325ull);
+		STATIC_REQUIRE(Hash::GenerateFNVHash64("a") == 0xaf63dc4c8601ec8cull);
+		STATIC_REQUIRE(Hash::GenerateFNVHash64("foobar") == 0x85944171f73967e8ull);
+	}
+
+	SECTION("Continuing a hash equals hashing the concatenation")
+	{
+		uint64_t hash = Hash::GenerateFNVHash64("vertex source");
+		hash = Hash::GenerateFNVHash64("fragment source", hash);
+
+		REQUIRE(hash == Hash::GenerateFNVHash64("vertex sourcefragment source"));
+		REQUIRE(hash != Hash::GenerateFNVHash64("fragment sourcevertex source"));
+	}
+}
+
 TEST_CASE("Hash CRC32 basic functionality", "[unit][core][hash]")
 {
 	SECTION("CRC32 with C-string produces non-zero hash")
@@ -0,0 +1,202 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "Luma/Core/Base.hpp"
+#include "Luma/Core/JobSystem.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace Luma;
+
+static uint64_t Fibonacci(uint32_t n)
+{
+	if (n < 2)
+		return n;
+
+	uint64_t a = 0, b = 0;
+	if (n < 16)
+	{
+		a = Fibonacci(n - 1);
+		b = Fibonacci(n - 2);
+		return a + b;
+	}
+
+	// Waiting inside a job has to keep the worker busy instead of blocking it
+	JobCounter counter;
+	JobSystem::Schedule([&a, n]() { a = Fibonacci(n - 1); }, &counter);
+	b = Fibonacci(n - 2);
+	JobSystem::Wait(counter);
+	return a + b;
+}
+
+TEST_CASE("JobSystem", "[unit][core][jobs]")
+{
+	JobSystem::Init(3);
+	REQUIRE(JobSystem::GetWorkerCount() == 3);
+
+	SECTION("ParallelFor visits every index once")
+	{
+		constexpr uint32_t count = 10000;
+		std::vector<std::atomic<uint32_t>> visits(count);
+
+		JobSystem::ParallelFor(count, 64, [&visits](uint32_t index)
+		{
+			visits[index].fetch_add(1, std::memory_order_relaxed);
+		});
+
+		uint32_t wrongCount = 0;
+		for (auto& visit : visits)
+			wrongCount += visit.load() != 1;
+		REQUIRE(wrongCount == 0);
+	}
+
+	SECTION("Wait returns once every job of a counter has run")
+	{
+		std::atomic<uint32_t> sum = 0;
+		JobCounter counter;
+		for (uint32_t i = 1; i <= 1000; i++)
+			JobSystem::Schedule([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); }, &counter);
+
+		JobSystem::Wait(counter);
+		REQUIRE(counter.IsDone());
+		REQUIRE(sum.load() == 500500);
+	}
+
+	SECTION("Dependent jobs run after their dependency")
+	{
+		std::atomic<uint32_t> firstDone = 0;
+		std::atomic<uint32_t> startedEarly = 0;
+
+		JobCounter first;
+		JobCounter second;
+		for (uint32_t i = 0; i < 100; i++)
+		{
+			JobSystem::Schedule([&firstDone]()
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(50));
+				firstDone.fetch_add(1);
+			}, &first);
+		}
+
+		for (uint32_t i = 0; i < 100; i++)
+		{
+			JobSystem::Schedule([&firstDone, &startedEarly]()
+			{
+				if (firstDone.load() != 100)
+					startedEarly.fetch_add(1);
+			}, &second, &first);
+		}
+
+		JobSystem::Wait(second);
+		REQUIRE(first.IsDone());
+		REQUIRE(startedEarly.load() == 0);
+	}
+
+	SECTION("Nested waits help instead of blocking")
+	{
+		REQUIRE(Fibonacci(24) == 46368);
+	}
+
+	SECTION("Jobs can be scheduled from threads outside the pool")
+	{
+		std::atomic<uint32_t> count = 0;
+		std::thread thread([&count]()
+		{
+			JobCounter counter;
+			for (uint32_t i = 0; i < 256; i++)
+				JobSystem::Schedule([&count]() { count.fetch_add(1); }, &counter);
+			JobSystem::Wait(counter);
+		});
+		thread.join();
+
+		REQUIRE(count.load() == 256);
+	}
+
+	JobSystem::Shutdown();
+	REQUIRE_FALSE(JobSystem::IsInitialized());
+}
+
+TEST_CASE("JobSystem without workers runs jobs inline", "[unit][core][jobs]")
+{
+	REQUIRE_FALSE(JobSystem::IsInitialized());
+
+	uint32_t sum = 0;
+	JobCounter counter;
+	JobSystem::Schedule([&sum]() { sum += 1; }, &counter);
+	JobSystem::ParallelFor(10, 1, [&sum](uint32_t index) { sum += index; });
+	JobSystem::Wait(counter);
+
+	REQUIRE(sum == 46);
+}
+
+TEST_CASE("JobSystem benchmarks", "[benchmark][core][jobs][.]")
+{
+	JobSystem::Init();
+
+	constexpr uint32_t elementCount = 1 << 20;
+	std::vector<float> input(elementCount);
+	std::vector<float> output(elementCount);
+	for (uint32_t i = 0; i < elementCount; i++)
+		input[i] = (float)i;
+
+	auto work = [&](uint32_t index) { output[index] = std::sqrt(input[index]) * std::sin(input[index]); };
+
+	BENCHMARK(std::format("Serial loop ({} elements)", elementCount))
+	{
+		for (uint32_t i = 0; i < elementCount; i++)
+			work(i);
+		return output[elementCount - 1];
+	};
+
+	BENCHMARK(std::format("ParallelFor ({} elements)", elementCount))
+	{
+		JobSystem::ParallelFor(elementCount, 4096, work);
+		return output[elementCount - 1];
+	};
+
+	BENCHMARK(std::format("std::async per batch ({} elements)", elementCount))
+	{
+		std::vector<std::future<void>> futures;
+		for (uint32_t begin = 0; begin < elementCount; begin += 4096)
+		{
+			futures.push_back(std::async(std::launch::async, [&work, begin]()
+			{
+				for (uint32_t i = begin; i < begin + 4096; i++)
+					work(i);
+			}));
+		}
+		for (auto& future : futures)
+			future.wait();
+		return output[elementCount - 1];
+	};
+
+	constexpr uint32_t jobCount = 10000;
+	std::atomic<uint32_t> sink = 0;
+
+	BENCHMARK(std::format("Schedule + Wait ({} small jobs)", jobCount))
+	{
+		JobCounter counter;
+		for (uint32_t i = 0; i < jobCount; i++)
+			JobSystem::Schedule([&sink]() { sink.fetch_add(1, std::memory_order_relaxed); }, &counter);
+		JobSystem::Wait(counter);
+		return sink.load();
+	};
+
+	BENCHMARK(std::format("std::async ({} small jobs)", jobCount))
+	{
+		std::vector<std::future<void>> futures;
+		futures.reserve(jobCount);
+		for (uint32_t i = 0; i < jobCount; i++)
+			futures.push_back(std::async(std::launch::async, [&sink]() { sink.fetch_add(1, std::memory_order_relaxed); }));
+		for (auto& future : futures)
+			future.wait();
+		return sink.load();
+	};
+
+	JobSystem::Shutdown();
+}
@@ -0,0 +1,161 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "Luma/Core/Base.hpp"
+#include "Luma/Core/Memory.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <thread>
+#include <vector>
+
+using namespace Luma;
+
+namespace {
+
+	constexpr uint32_t BlocksPerIteration = 1024;
+	constexpr std::array<size_t, 4> BlockSizes = { 16, 64, 256, 1024 };
+
+	template<typename AllocFn, typename FreeFn>
+	void AllocateAndFreeBlocks(AllocFn&& allocate, FreeFn&& free)
+	{
+		std::array<void*, BlocksPerIteration> blocks;
+		for (uint32_t i = 0; i < BlocksPerIteration; i++)
+			blocks[i] = allocate(BlockSizes[i % BlockSizes.size()]);
+
+		for (uint32_t i = 0; i < BlocksPerIteration; i++)
+			free(blocks[i]);
+	}
+
+	template<typename Fn>
+	void RunOnThreads(uint32_t threadCount, Fn&& func)
+	{
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount);
+		for (uint32_t i = 0; i < threadCount; i++)
+			threads.emplace_back(func);
+
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+}
+
+TEST_CASE("Allocator allocation header", "[unit][core][memory]")
+{
+	SECTION("Allocation size is recoverable from the block")
+	{
+		void* memory = Allocator::Allocate(123);
+
+		REQUIRE(memory != nullptr);
+		REQUIRE(Allocator::GetAllocationSize(memory) == 123);
+
+		Allocator::Free(memory);
+	}
+
+	SECTION("Blocks keep fundamental alignment")
+	{
+		for (size_t size : BlockSizes)
+		{
+			void* memory = Allocator::Allocate(size);
+			REQUIRE((uintptr_t)memory % alignof(std::max_align_t) == 0);
+			Allocator::Free(memory);
+		}
+	}
+
+	SECTION("Freeing nullptr is a no-op")
+	{
+		Allocator::Free(nullptr);
+		REQUIRE(Allocator::GetAllocationSize(nullptr) == 0);
+	}
+}
+
+TEST_CASE("Allocator statistics", "[unit][core][memory]")
+{
+	SECTION("Allocate and Free update the global totals")
+	{
+		AllocationStats before = Memory::GetAllocationStats();
+		void* memory = Allocator::Allocate(256);
+		AllocationStats allocated = Memory::GetAllocationStats();
+		Allocator::Free(memory);
+		AllocationStats freed = Memory::GetAllocationStats();
+
+		REQUIRE(allocated.TotalAllocated - before.TotalAllocated == 256);
+		REQUIRE(freed.TotalFreed - allocated.TotalFreed == 256);
+	}
+
+	SECTION("Categorised allocations are reported per category")
+	{
+		static const char* category = "MemoryTest";
+
+		void* memory = Allocator::Allocate(64, category);
+		REQUIRE(Allocator::GetAllocationStats().at(category).TotalAllocated >= 64);
+
+		size_t freedBefore = Allocator::GetAllocationStats().at(category).TotalFreed;
+		Allocator::Free(memory);
+		REQUIRE(Allocator::GetAllocationStats().at(category).TotalFreed - freedBefore == 64);
+	}
+
+	SECTION("Allocations from other threads are included in the totals")
+	{
+		constexpr uint32_t threadCount = 4;
+		constexpr size_t allocationSize = 48;
+
+		AllocationStats before = Memory::GetAllocationStats();
+		std::vector<void*> blocks(threadCount);
+		std::atomic<uint32_t> nextBlock = 0;
+
+		RunOnThreads(threadCount, [&]()
+		{
+			blocks[nextBlock++] = Allocator::Allocate(allocationSize);
+		});
+
+		AllocationStats after = Memory::GetAllocationStats();
+		REQUIRE(after.TotalAllocated - before.TotalAllocated >= threadCount * allocationSize);
+
+		for (void* block : blocks)
+			Allocator::Free(block);
+	}
+}
+
+TEST_CASE("Allocator throughput", "[benchmark][core][memory][.]")
+{
+	BENCHMARK("malloc/free (untracked)")
+	{
+		AllocateAndFreeBlocks([](size_t size) { return std::malloc(size); }, [](void* memory) { std::free(memory); });
+	};
+
+	BENCHMARK("Allocator::Allocate/Free (tracked)")
+	{
+		AllocateAndFreeBlocks([](size_t size) { return Allocator::Allocate(size); }, [](void* memory) { Allocator::Free(memory); });
+	};
+
+	BENCHMARK("operator new/delete")
+	{
+		AllocateAndFreeBlocks([](size_t size) { return ::operator new(size); }, [](void* memory) { ::operator delete(memory); });
+	};
+
+	const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+	{
+		BENCHMARK(std::format("malloc/free (untracked), {} thread(s)", threadCount))
+		{
+			RunOnThreads(threadCount, []()
+			{
+				AllocateAndFreeBlocks([](size_t size) { return std::malloc(size); }, [](void* memory) { std::free(memory); });
+			});
+		};
+
+		BENCHMARK(std::format("Allocator::Allocate/Free (tracked), {} thread(s)", threadCount))
+		{
+			RunOnThreads(threadCount, []()
+			{
+				AllocateAndFreeBlocks([](size_t size) { return Allocator::Allocate(size); }, [](void* memory) { Allocator::Free(memory); });
+			});
+		};
+	}
+}
@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Luma/Core/RadixSort.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace Luma;
+
+struct SortItem
+{
+	uint64_t Key;
+	uint32_t Index;
+};
+
+static std::vector<SortItem> RadixSorted(std::vector<SortItem> items)
+{
+	std::vector<SortItem> scratch(items.size());
+	RadixSort(items.data(), scratch.data(), (uint32_t)items.size(), [](const SortItem& item) { return item.Key; });
+	return items;
+}
+
+static std::vector<SortItem> StableSorted(std::vector<SortItem> items)
+{
+	std::stable_sort(items.begin(), items.end(), [](const SortItem& a, const SortItem& b) { return a.Key < b.Key; });
+	return items;
+}
+
+static bool SameOrder(const std::vector<SortItem>& a, const std::vector<SortItem>& b)
+{
+	return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const SortItem& x, const SortItem& y)
+	{
+		return x.Key == y.Key && x.Index == y.Index;
+	});
+}
+
+TEST_CASE("RadixSort", "[unit][core][sort]")
+{
+	std::mt19937_64 random(1234);
+	std::vector<SortItem> items;
+
+	SECTION("Random 64-bit keys sort like std::stable_sort")
+	{
+		for (uint32_t i = 0; i < 5000; i++)
+			items.push_back({ random(), i });
+
+		REQUIRE(SameOrder(RadixSorted(items), StableSorted(items)));
+	}
+
+	SECTION("Equal keys keep their order")
+	{
+		for (uint32_t i = 0; i < 5000; i++)
+			items.push_back({ (random() % 8) << 40, i });
+
+		REQUIRE(SameOrder(RadixSorted(items), StableSorted(items)));
+	}
+
+	SECTION("Keys with an odd number of differing bytes")
+	{
+		for (uint32_t i = 0; i < 1000; i++)
+			items.push_back({ 0xabcd000000000000ull | (random() & 0xffffff), i });
+
+		REQUIRE(SameOrder(RadixSorted(items), StableSorted(items)));
+	}
+
+	SECTION("Tiny and uniform inputs")
+	{
+		REQUIRE(RadixSorted({}).empty());
+		REQUIRE(SameOrder(RadixSorted({ { 7, 0 } }), { { 7, 0 } }));
+
+		for (uint32_t i = 0; i < 100; i++)
+			items.push_back({ 42, i });
+		REQUIRE(SameOrder(RadixSorted(items), items));
+	}
+}
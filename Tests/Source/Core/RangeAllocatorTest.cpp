@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Luma/Core/Base.hpp"
+#include "Luma/Core/RangeAllocator.hpp"
+
+using namespace Luma;
+
+TEST_CASE("RangeAllocator", "[unit][core][memory]")
+{
+	RangeAllocator allocator(100);
+
+	SECTION("Ranges are handed out back to back")
+	{
+		REQUIRE(allocator.Allocate(10) == 0);
+		REQUIRE(allocator.Allocate(20) == 10);
+		REQUIRE(allocator.Allocate(70) == 30);
+		REQUIRE(allocator.GetUsedSize() == 100);
+		REQUIRE(allocator.GetFreeRangeCount() == 0);
+
+		REQUIRE(allocator.Allocate(1) == RangeAllocator::InvalidOffset);
+	}
+
+	SECTION("Freed ranges are reused first fit")
+	{
+		uint32_t a = allocator.Allocate(10);
+		uint32_t b = allocator.Allocate(30);
+		allocator.Allocate(10);
+
+		allocator.Free(b, 30);
+		REQUIRE(allocator.Allocate(20) == b);
+		REQUIRE(allocator.Allocate(10) == b + 20);
+
+		allocator.Free(a, 10);
+		REQUIRE(allocator.Allocate(15) == 50);
+		REQUIRE(allocator.Allocate(5) == a);
+	}
+
+	SECTION("Free merges with both neighbours")
+	{
+		uint32_t a = allocator.Allocate(10);
+		uint32_t b = allocator.Allocate(10);
+		uint32_t c = allocator.Allocate(10);
+		allocator.Allocate(70);
+
+		allocator.Free(a, 10);
+		allocator.Free(c, 10);
+		REQUIRE(allocator.GetFreeRangeCount() == 2);
+
+		allocator.Free(b, 10);
+		REQUIRE(allocator.GetFreeRangeCount() == 1);
+		REQUIRE(allocator.Allocate(30) == a);
+		REQUIRE(allocator.GetUsedSize() == 100);
+	}
+
+	SECTION("Grow extends the free range at the end")
+	{
+		allocator.Allocate(90);
+		REQUIRE(allocator.Allocate(20) == RangeAllocator::InvalidOffset);
+
+		allocator.Grow(200);
+		REQUIRE(allocator.GetCapacity() == 200);
+		REQUIRE(allocator.GetFreeRangeCount() == 1);
+		REQUIRE(allocator.Allocate(20) == 90);
+	}
+
+	SECTION("Grow without free space at the end adds a new range")
+	{
+		allocator.Allocate(100);
+		allocator.Free(0, 10);
+
+		allocator.Grow(150);
+		REQUIRE(allocator.GetFreeRangeCount() == 2);
+		REQUIRE(allocator.Allocate(50) == 100);
+		REQUIRE(allocator.Allocate(10) == 0);
+	}
+}
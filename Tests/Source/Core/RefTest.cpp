@@ -0,0 +1,289 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "Luma/Core/Base.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <thread>
+#include <vector>
+
+using namespace Luma;
+
+namespace {
+
+	struct TestObject : public RefCounted
+	{
+		TestObject(int value) : Value(value) {}
+		int Value;
+	};
+
+	struct PooledTestObject : public RefCounted
+	{
+		PooledTestObject(int value) : Value(value) {}
+		int Value;
+	};
+
+	struct PooledBase
+	{
+		virtual ~PooledBase() = default;
+		uint64_t Padding[2] = {};
+	};
+
+	// RefCounted is not the first base, so Ref<RefCounted-derived> points into the middle of the block
+	struct PooledDerivedObject : public PooledBase, public PooledTestObject
+	{
+		PooledDerivedObject(int value, bool& destroyed) : PooledTestObject(value), Destroyed(destroyed) {}
+		~PooledDerivedObject() { Destroyed = true; }
+		bool& Destroyed;
+	};
+
+	template<typename Fn>
+	void RunOnThreads(uint32_t threadCount, Fn&& func)
+	{
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount);
+		for (uint32_t i = 0; i < threadCount; i++)
+			threads.emplace_back(func);
+
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	uint32_t GetMaxBenchmarkThreads()
+	{
+		return std::max(1u, std::thread::hardware_concurrency());
+	}
+
+}
+
+namespace Luma {
+	LM_POOLED_REF(PooledTestObject);
+	LM_POOLED_REF(PooledDerivedObject);
+}
+
+TEST_CASE("Ref reference counting", "[unit][core][ref]")
+{
+	SECTION("Create starts with a single reference")
+	{
+		Ref<TestObject> ref = Ref<TestObject>::Create(42);
+
+		REQUIRE(ref);
+		REQUIRE(ref->Value == 42);
+		REQUIRE(ref->GetRefCount() == 1);
+	}
+
+	SECTION("Copies increment and releases decrement")
+	{
+		Ref<TestObject> ref1 = Ref<TestObject>::Create(1);
+		{
+			Ref<TestObject> ref2 = ref1;
+			Ref<TestObject> ref3 = ref2;
+			REQUIRE(ref1->GetRefCount() == 3);
+		}
+
+		REQUIRE(ref1->GetRefCount() == 1);
+	}
+
+	SECTION("Move does not change the reference count")
+	{
+		Ref<TestObject> ref1 = Ref<TestObject>::Create(1);
+		Ref<TestObject> ref2 = std::move(ref1);
+
+		REQUIRE_FALSE(ref1);
+		REQUIRE(ref2->GetRefCount() == 1);
+	}
+
+	SECTION("Concurrent copies keep the count consistent")
+	{
+		Ref<TestObject> ref = Ref<TestObject>::Create(1);
+		std::atomic<uint32_t> failures = 0;
+
+		RunOnThreads(8, [&ref, &failures]()
+		{
+			for (uint32_t i = 0; i < 10000; i++)
+			{
+				Ref<TestObject> copy = ref;
+				if (copy->GetRefCount() < 2)
+					failures++;
+			}
+		});
+
+		REQUIRE(failures == 0);
+		REQUIRE(ref->GetRefCount() == 1);
+	}
+}
+
+TEST_CASE("WeakRef liveness", "[unit][core][ref]")
+{
+	SECTION("WeakRef is valid while a Ref is held")
+	{
+		Ref<TestObject> ref = Ref<TestObject>::Create(7);
+		WeakRef<TestObject> weak = ref;
+
+		REQUIRE(weak.IsValid());
+		REQUIRE(weak->Value == 7);
+	}
+
+	SECTION("WeakRef stays valid across copies of the Ref")
+	{
+		Ref<TestObject> ref = Ref<TestObject>::Create(7);
+		WeakRef<TestObject> weak = ref;
+
+		{
+			Ref<TestObject> copy = ref;
+		}
+
+		REQUIRE(weak.IsValid());
+	}
+
+	SECTION("WeakRef is invalid after the last Ref is released")
+	{
+		Ref<TestObject> ref = Ref<TestObject>::Create(7);
+		WeakRef<TestObject> weak = ref;
+
+		ref = nullptr;
+
+		REQUIRE_FALSE(weak.IsValid());
+	}
+
+	SECTION("Default WeakRef is invalid")
+	{
+		WeakRef<TestObject> weak;
+		REQUIRE_FALSE(weak);
+	}
+
+	SECTION("Objects created and destroyed concurrently are tracked")
+	{
+		std::atomic<uint32_t> failures = 0;
+
+		RunOnThreads(8, [&failures]()
+		{
+			for (uint32_t i = 0; i < 1000; i++)
+			{
+				Ref<TestObject> ref = Ref<TestObject>::Create((int)i);
+				WeakRef<TestObject> weak = ref;
+				if (!weak.IsValid())
+					failures++;
+			}
+		});
+
+		REQUIRE(failures == 0);
+	}
+}
+
+TEST_CASE("Pooled Ref allocation", "[unit][core][ref][memory]")
+{
+	SECTION("Pooled objects are reported as pool occupancy")
+	{
+		size_t usedBefore = Memory::GetAllocationStats().PoolUsed;
+		Ref<PooledTestObject> ref = Ref<PooledTestObject>::Create(3);
+
+		REQUIRE(ref->Value == 3);
+		REQUIRE(Memory::GetAllocationStats().PoolUsed > usedBefore);
+		REQUIRE(Memory::GetAllocationStats().PoolReserved >= Memory::GetAllocationStats().PoolUsed);
+
+		ref = nullptr;
+		REQUIRE(Memory::GetAllocationStats().PoolUsed == usedBefore);
+	}
+
+	SECTION("Released blocks are reused")
+	{
+		void* first = Ref<PooledTestObject>::Create(1).Raw();
+		void* second = Ref<PooledTestObject>::Create(2).Raw();
+
+		REQUIRE(first == second);
+	}
+
+	SECTION("Releasing through a base Ref destroys the derived object")
+	{
+		bool destroyed = false;
+		size_t usedBefore = Memory::GetAllocationStats().PoolUsed;
+
+		Ref<PooledTestObject> ref = Ref<PooledDerivedObject>::Create(5, destroyed);
+		WeakRef<PooledTestObject> weak = ref;
+		REQUIRE(ref->Value == 5);
+		REQUIRE(weak.IsValid());
+
+		// Registered through Ref<PooledDerivedObject>, removed through Ref<PooledTestObject>
+		ref = nullptr;
+		REQUIRE(destroyed);
+		REQUIRE_FALSE(weak.IsValid());
+		REQUIRE(Memory::GetAllocationStats().PoolUsed == usedBefore);
+	}
+
+	SECTION("WeakRef tracks pooled objects")
+	{
+		Ref<PooledTestObject> ref = Ref<PooledTestObject>::Create(1);
+		WeakRef<PooledTestObject> weak = ref;
+		REQUIRE(weak.IsValid());
+
+		ref = nullptr;
+		REQUIRE_FALSE(weak.IsValid());
+	}
+}
+
+TEST_CASE("Ref copy contention", "[benchmark][core][ref][.]")
+{
+	constexpr uint32_t CopiesPerThread = 100000;
+
+	Ref<TestObject> shared = Ref<TestObject>::Create(1);
+
+	for (uint32_t threadCount = 1; threadCount <= GetMaxBenchmarkThreads(); threadCount *= 2)
+	{
+		BENCHMARK(std::format("Copy shared Ref, {} thread(s) x {} copies", threadCount, CopiesPerThread))
+		{
+			RunOnThreads(threadCount, [&shared]()
+			{
+				for (uint32_t i = 0; i < CopiesPerThread; i++)
+				{
+					Ref<TestObject> copy = shared;
+				}
+			});
+			return shared->GetRefCount();
+		};
+	}
+}
+
+TEST_CASE("Ref create/destroy contention", "[benchmark][core][ref][.]")
+{
+	constexpr uint32_t ObjectsPerThread = 20000;
+
+	for (uint32_t threadCount = 1; threadCount <= GetMaxBenchmarkThreads(); threadCount *= 2)
+	{
+		BENCHMARK(std::format("Create and release Ref, {} thread(s) x {} objects", threadCount, ObjectsPerThread))
+		{
+			RunOnThreads(threadCount, []()
+			{
+				for (uint32_t i = 0; i < ObjectsPerThread; i++)
+				{
+					Ref<TestObject> ref = Ref<TestObject>::Create((int)i);
+				}
+			});
+		};
+	}
+}
+
+TEST_CASE("Pooled Ref create/destroy", "[benchmark][core][ref][.]")
+{
+	constexpr uint32_t ObjectCount = 1000;
+
+	BENCHMARK("Create and release heap Refs")
+	{
+		std::vector<Ref<TestObject>> refs;
+		refs.reserve(ObjectCount);
+		for (uint32_t i = 0; i < ObjectCount; i++)
+			refs.push_back(Ref<TestObject>::Create((int)i));
+		return refs.size();
+	};
+
+	BENCHMARK("Create and release pooled Refs")
+	{
+		std::vector<Ref<PooledTestObject>> refs;
+		refs.reserve(ObjectCount);
+		for (uint32_t i = 0; i < ObjectCount; i++)
+			refs.push_back(Ref<PooledTestObject>::Create((int)i));
+		return refs.size();
+	};
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Luma/Math/Frustum.hpp"
+#include "Luma/Math/AABB.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace Luma;
+
+static Frustum CreateTestFrustum()
+{
+	// Looking down -Z from the origin
+	glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	return Frustum::FromMatrix(projection * view);
+}
+
+static AABB UnitBoxAt(const glm::vec3& center)
+{
+	return AABB(center - glm::vec3(0.5f), center + glm::vec3(0.5f));
+}
+
+TEST_CASE("Frustum box tests", "[unit][math][frustum]")
+{
+	Frustum frustum = CreateTestFrustum();
+
+	SECTION("Boxes inside and outside the frustum")
+	{
+		REQUIRE(frustum.Intersects(UnitBoxAt({ 0.0f, 0.0f, -10.0f })));
+		REQUIRE(frustum.Intersects(UnitBoxAt({ 9.0f, 0.0f, -10.0f })));
+
+		REQUIRE_FALSE(frustum.Intersects(UnitBoxAt({ 0.0f, 0.0f, 10.0f })));
+		REQUIRE_FALSE(frustum.Intersects(UnitBoxAt({ 20.0f, 0.0f, -10.0f })));
+		REQUIRE_FALSE(frustum.Intersects(UnitBoxAt({ 0.0f, -20.0f, -10.0f })));
+		REQUIRE_FALSE(frustum.Intersects(UnitBoxAt({ 0.0f, 0.0f, -200.0f })));
+	}
+
+	SECTION("Boxes straddling a plane are visible")
+	{
+		REQUIRE(frustum.Intersects(UnitBoxAt({ 10.4f, 0.0f, -10.0f })));
+		REQUIRE(frustum.Intersects(UnitBoxAt({ 0.0f, 0.0f, 0.3f })));
+		REQUIRE(frustum.Intersects(UnitBoxAt({ 0.0f, 0.0f, -100.3f })));
+	}
+
+	SECTION("Near and far planes sit at the clip distances")
+	{
+		auto distance = [](const glm::vec4& plane, const glm::vec3& point) { return glm::dot(glm::vec3(plane), point) + plane.w; };
+
+		REQUIRE(std::abs(distance(frustum.Planes[4], { 0.0f, 0.0f, -0.1f })) < 1e-4f);
+		REQUIRE(std::abs(distance(frustum.Planes[5], { 0.0f, 0.0f, -100.0f })) < 1e-2f);
+
+		// Between the camera and the near plane
+		REQUIRE_FALSE(frustum.Intersects(AABB({ -0.01f, -0.01f, -0.08f }, { 0.01f, 0.01f, -0.06f })));
+		REQUIRE(frustum.Intersects(AABB({ -0.01f, -0.01f, -0.2f }, { 0.01f, 0.01f, -0.12f })));
+	}
+
+	SECTION("Packet culling matches the single box test")
+	{
+		std::vector<AABB> boxes;
+		for (int x = -30; x <= 30; x += 3)
+		{
+			for (int z = -120; z <= 20; z += 7)
+				boxes.push_back(UnitBoxAt({ (float)x, 0.5f * x, (float)z }));
+		}
+
+		const uint32_t count = (uint32_t)boxes.size();
+		std::vector<AABBPacket> packets((count + 3) / 4);
+		for (uint32_t i = 0; i < count; i++)
+			packets[i / 4].Set(i % 4, boxes[i], glm::mat4(1.0f));
+
+		std::vector<uint8_t> visible(count, 0xff);
+		uint32_t visibleCount = frustum.Cull(packets.data(), count, visible.data());
+
+		uint32_t expectedCount = 0;
+		uint32_t mismatches = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			bool expected = frustum.Intersects(boxes[i]);
+			expectedCount += expected;
+			mismatches += visible[i] != (uint8_t)expected;
+		}
+
+		REQUIRE(mismatches == 0);
+		REQUIRE(visibleCount == expectedCount);
+		REQUIRE(visibleCount > 0);
+		REQUIRE(visibleCount < count);
+	}
+
+	SECTION("Transformed boxes enclose the transformed corners")
+	{
+		glm::mat4 transform = glm::translate(glm::mat4(1.0f), { 0.0f, 0.0f, -10.0f })
+			* glm::rotate(glm::mat4(1.0f), glm::radians(45.0f), { 0.0f, 1.0f, 0.0f })
+			* glm::scale(glm::mat4(1.0f), { 2.0f, 1.0f, 1.0f });
+
+		AABBPacket packet;
+		packet.Set(0, AABB({ -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f }), transform);
+
+		REQUIRE(packet.CenterZ[0] == -10.0f);
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			glm::vec4 corner = transform * glm::vec4(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f, 1.0f);
+			REQUIRE(std::abs(corner.x - packet.CenterX[0]) <= packet.ExtentX[0] + 1e-5f);
+			REQUIRE(std::abs(corner.y - packet.CenterY[0]) <= packet.ExtentY[0] + 1e-5f);
+			REQUIRE(std::abs(corner.z - packet.CenterZ[0]) <= packet.ExtentZ[0] + 1e-5f);
+		}
+	}
+}
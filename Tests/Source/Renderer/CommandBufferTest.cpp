@@ -0,0 +1,92 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "Luma/Core/Base.hpp"
+#include "Luma/Core/JobSystem.hpp"
+#include "Luma/Renderer/Renderer.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+using namespace Luma;
+
+TEST_CASE("Parallel command recording", "[unit][renderer][commands]")
+{
+	std::vector<uint32_t> executed;
+	auto record = [&executed](uint32_t index)
+	{
+		Renderer::Submit([&executed, index]() { executed.push_back(index); });
+	};
+
+	SECTION("Without workers commands are recorded serially")
+	{
+		Renderer::RecordParallel(1000, 16, record);
+		Renderer::WaitAndRender();
+
+		REQUIRE(executed.size() == 1000);
+		for (uint32_t i = 0; i < 1000; i++)
+			REQUIRE(executed[i] == i);
+	}
+
+	SECTION("Secondary command buffers execute in index order")
+	{
+		JobSystem::Init(3);
+
+		Renderer::Submit([&executed]() { executed.push_back(~0u); });
+		Renderer::RecordParallel(1000, 16, record);
+		Renderer::Submit([&executed]() { executed.push_back(~0u); });
+
+		// Recycled command buffers must not replay the previous frame
+		Renderer::WaitAndRender();
+		Renderer::RecordParallel(1000, 16, record);
+		Renderer::WaitAndRender();
+
+		JobSystem::Shutdown();
+
+		REQUIRE(executed.size() == 2002);
+		REQUIRE(executed.front() == ~0u);
+		REQUIRE(executed[1001] == ~0u);
+		for (uint32_t i = 0; i < 1000; i++)
+		{
+			REQUIRE(executed[1 + i] == i);
+			REQUIRE(executed[1002 + i] == i);
+		}
+	}
+}
+
+TEST_CASE("Parallel command recording benchmarks", "[benchmark][renderer][commands][.]")
+{
+	// Draw-like commands that never reach a graphics API, so only the recording is measured
+	constexpr uint32_t drawCount = 100000;
+	std::vector<glm::mat4> transforms(drawCount, glm::mat4(1.0f));
+	glm::mat4 viewProjection(2.0f);
+
+	auto record = [&](uint32_t index)
+	{
+		glm::mat4 transform = viewProjection * transforms[index];
+		Renderer::Submit([transform]() { (void)transform; });
+	};
+
+	BENCHMARK(std::format("Serial ({} draws)", drawCount))
+	{
+		for (uint32_t i = 0; i < drawCount; i++)
+			record(i);
+		Renderer::WaitAndRender();
+		return drawCount;
+	};
+
+	for (uint32_t workerCount : { 1u, 3u, 7u })
+	{
+		JobSystem::Init(workerCount);
+
+		BENCHMARK(std::format("RecordParallel, {} threads ({} draws)", workerCount + 1, drawCount))
+		{
+			Renderer::RecordParallel(drawCount, 256, record);
+			Renderer::WaitAndRender();
+			return drawCount;
+		};
+
+		JobSystem::Shutdown();
+	}
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Luma/Core/Base.hpp"
+#include "Luma/Renderer/RenderCommandQueue.hpp"
+
+#include <array>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
+
+using namespace Luma;
+
+// Same recording scheme as Renderer::Submit
+template<typename FuncT>
+static void Submit(RenderCommandQueue& queue, FuncT&& func)
+{
+	auto renderCmd = [](void* ptr)
+	{
+		auto pFunc = (FuncT*)ptr;
+		(*pFunc)();
+		pFunc->~FuncT();
+	};
+	void* storageBuffer = queue.Allocate(renderCmd, sizeof(func));
+	new (storageBuffer) FuncT(std::forward<FuncT>(func));
+}
+
+TEST_CASE("RenderCommandQueue", "[unit][renderer][commands]")
+{
+	RenderCommandQueue queue;
+	std::vector<uint32_t> executed;
+
+	SECTION("Commands execute in submission order")
+	{
+		for (uint32_t i = 0; i < 100; i++)
+			Submit(queue, [&executed, i]() { executed.push_back(i); });
+
+		queue.Execute();
+
+		REQUIRE(executed.size() == 100);
+		for (uint32_t i = 0; i < 100; i++)
+			REQUIRE(executed[i] == i);
+
+		executed.clear();
+		queue.Execute();
+		REQUIRE(executed.empty());
+	}
+
+	SECTION("The queue grows past a single chunk")
+	{
+		struct LargeCommand
+		{
+			std::array<uint8_t, 1000> Data;
+		};
+
+		const uint32_t commandCount = (uint32_t)(3 * RenderCommandQueue::ChunkSize / sizeof(LargeCommand));
+		for (uint32_t i = 0; i < commandCount; i++)
+		{
+			LargeCommand command;
+			command.Data.fill((uint8_t)i);
+			Submit(queue, [&executed, command, i]()
+			{
+				if (command.Data.front() == (uint8_t)i && command.Data.back() == (uint8_t)i)
+					executed.push_back(i);
+			});
+		}
+
+		queue.Execute();
+
+		REQUIRE(executed.size() == commandCount);
+		REQUIRE(queue.GetStats().ChunkCount > 1);
+	}
+
+	SECTION("Commands larger than a chunk are supported")
+	{
+		std::vector<uint8_t> payload(RenderCommandQueue::ChunkSize * 2, 7);
+		uint8_t* data = (uint8_t*)queue.Allocate([](void* ptr) {}, (uint32_t)payload.size());
+		memcpy(data, payload.data(), payload.size());
+
+		Submit(queue, [&executed]() { executed.push_back(1); });
+		queue.Execute();
+
+		REQUIRE(executed.size() == 1);
+		REQUIRE(queue.GetStats().ReservedSize >= 3 * RenderCommandQueue::ChunkSize);
+	}
+
+	SECTION("Commands recorded while executing run in the same execution")
+	{
+		Submit(queue, [&queue, &executed]()
+		{
+			executed.push_back(0);
+			Submit(queue, [&executed]() { executed.push_back(1); });
+		});
+
+		queue.Execute();
+
+		REQUIRE(executed == std::vector<uint32_t>{ 0, 1 });
+	}
+
+	SECTION("Statistics keep the high-water marks")
+	{
+		for (uint32_t i = 0; i < 50; i++)
+			Submit(queue, []() {});
+		queue.Execute();
+
+		Submit(queue, []() {});
+		queue.Execute();
+
+		const RenderCommandQueueStats& stats = queue.GetStats();
+		REQUIRE(stats.CommandCount == 1);
+		REQUIRE(stats.PeakCommandCount == 50);
+		REQUIRE(stats.PeakSize > stats.Size);
+	}
+
+	SECTION("Unused chunks are trimmed after quiet executions")
+	{
+		std::vector<uint8_t> payload(RenderCommandQueue::ChunkSize);
+		for (uint32_t i = 0; i < 4; i++)
+			queue.Allocate([](void* ptr) {}, (uint32_t)payload.size());
+		queue.Execute();
+
+		const uint32_t grownChunkCount = queue.GetStats().ChunkCount;
+		REQUIRE(grownChunkCount >= 4);
+
+		// The busy execution above counts towards the first trim window
+		for (uint32_t i = 0; i < 2 * RenderCommandQueue::TrimExecuteCount; i++)
+			queue.Execute();
+
+		REQUIRE(queue.GetStats().ChunkCount == 1);
+		REQUIRE(queue.GetStats().ReservedSize == RenderCommandQueue::ChunkSize);
+		REQUIRE(queue.GetStats().PeakSize >= 4 * RenderCommandQueue::ChunkSize);
+	}
+}
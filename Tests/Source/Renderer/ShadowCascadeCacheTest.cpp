@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Luma/Renderer/ShadowCascadeCache.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Luma;
+
+TEST_CASE("ShadowCascadeCache", "[unit][renderer][shadows]")
+{
+	const glm::mat4 viewProjection = glm::ortho(-10.0f, 10.0f, -10.0f, 10.0f, 0.0f, 50.0f);
+	ShadowCascadeCache::Caster casters[] = {
+		{ 1, 0, glm::mat4(1.0f) },
+		{ 2, 1, glm::translate(glm::mat4(1.0f), { 5.0f, 0.0f, 0.0f }) },
+	};
+
+	ShadowCascadeCache cache;
+	REQUIRE_FALSE(cache.IsValid());
+	REQUIRE(cache.Update(viewProjection, 1, casters, 2));
+	REQUIRE(cache.IsValid());
+
+	SECTION("Unchanged cascades hit the cache")
+	{
+		REQUIRE_FALSE(cache.Update(viewProjection, 1, casters, 2));
+		REQUIRE_FALSE(cache.Update(viewProjection, 1, casters, 2));
+	}
+
+	SECTION("A different matrix invalidates it")
+	{
+		REQUIRE(cache.Update(glm::translate(viewProjection, { 0.0f, 1.0f, 0.0f }), 1, casters, 2));
+	}
+
+	SECTION("Moved, added or removed casters invalidate it")
+	{
+		casters[1].Transform = glm::mat4(1.0f);
+		REQUIRE(cache.Update(viewProjection, 1, casters, 2));
+		REQUIRE(cache.Update(viewProjection, 1, casters, 1));
+		REQUIRE_FALSE(cache.Update(viewProjection, 1, casters, 1));
+	}
+
+	SECTION("Another mesh in the same place invalidates it")
+	{
+		casters[0].MeshID = 3;
+		REQUIRE(cache.Update(viewProjection, 1, casters, 2));
+
+		casters[0].SubmeshIndex = 4;
+		REQUIRE(cache.Update(viewProjection, 1, casters, 2));
+	}
+
+	SECTION("Animated casters never hit the cache")
+	{
+		casters[1].Animated = true;
+		REQUIRE(cache.Update(viewProjection, 1, casters, 2));
+		REQUIRE(cache.Update(viewProjection, 1, casters, 2));
+	}
+
+	SECTION("A recreated shadow map invalidates it")
+	{
+		REQUIRE(cache.Update(viewProjection, 2, casters, 2));
+		REQUIRE_FALSE(cache.Update(viewProjection, 2, casters, 2));
+	}
+
+	SECTION("Invalidate forces the next update to render")
+	{
+		cache.Invalidate();
+		REQUIRE_FALSE(cache.IsValid());
+		REQUIRE(cache.Update(viewProjection, 1, casters, 2));
+	}
+}
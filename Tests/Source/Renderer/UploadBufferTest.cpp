@@ -0,0 +1,57 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Luma/Core/Base.hpp"
+#include "Luma/Renderer/UploadBuffer.hpp"
+
+#include <cstring>
+
+using namespace Luma;
+
+TEST_CASE("UploadBuffer", "[unit][renderer][upload]")
+{
+	UploadBuffer::ReleaseRecycledStorage();
+
+	SECTION("Copy holds the source data")
+	{
+		uint32_t values[] = { 1, 2, 3, 4 };
+		Ref<UploadBuffer> buffer = UploadBuffer::Copy(values, sizeof(values));
+
+		REQUIRE(buffer->GetSize() == sizeof(values));
+		REQUIRE(memcmp(buffer->GetData(), values, sizeof(values)) == 0);
+		REQUIRE(buffer->GetView().Read<uint32_t>(3 * sizeof(uint32_t)) == 4);
+	}
+
+	SECTION("Storage is aligned for GPU uploads")
+	{
+		Ref<UploadBuffer> buffer = UploadBuffer::Create(100);
+		REQUIRE(buffer->GetView().IsAligned(64));
+	}
+
+	SECTION("Storage is recycled once the last reference is released")
+	{
+		Ref<UploadBuffer> first = UploadBuffer::Create(10000);
+		const void* storage = first->GetData();
+
+		Ref<UploadBuffer> copy = first;
+		first = nullptr;
+		REQUIRE(UploadBuffer::GetStats().RecycledSize == 0);
+
+		copy = nullptr;
+		REQUIRE(UploadBuffer::GetStats().RecycledSize > 0);
+
+		Ref<UploadBuffer> second = UploadBuffer::Create(9000);
+		REQUIRE(second->GetData() == storage);
+		REQUIRE(UploadBuffer::GetStats().RecycledSize == 0);
+	}
+
+	SECTION("Live buffers are reported in the stats")
+	{
+		UploadBufferStats before = UploadBuffer::GetStats();
+		Ref<UploadBuffer> buffer = UploadBuffer::Create(4096);
+
+		REQUIRE(UploadBuffer::GetStats().LiveCount == before.LiveCount + 1);
+		REQUIRE(UploadBuffer::GetStats().LiveSize >= before.LiveSize + 4096);
+	}
+
+	UploadBuffer::ReleaseRecycledStorage();
+}
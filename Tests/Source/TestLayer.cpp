@@ -36,9 +36,13 @@ namespace Luma {
 		RegisterTest<RendererInitTest>();
 		RegisterTest<TextureLoadTest>();
 		RegisterTest<ShaderCompileTest>();
+		RegisterTest<ShaderProgramCacheTest>();
 		RegisterTest<FramebufferTest>();
 		RegisterTest<VertexBufferTest>();
 		RegisterTest<RenderCommandTest>();
+		RegisterTest<Renderer2DBenchmarkTest>();
+		RegisterTest<MultiDrawIndirectTest>();
+		RegisterTest<Renderer2DTextureArrayTest>();
 
 		for (auto& test : m_Tests)
 			test->OnInit();
@@ -10,11 +10,38 @@
 #include "Luma/Renderer/IndexBuffer.hpp"
 #include "Luma/Renderer/Renderer2D.hpp"
 #include "Luma/Renderer/Renderer.hpp"
+#include "Luma/Renderer/Mesh.hpp"
+#include "Luma/Renderer/Backend/OpenGL/OpenGLState.hpp"
 
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <filesystem>
 #include <sstream>
 
 namespace Luma {
 
+	// Runs everything submitted so far and reads the first color attachment (RGBA8) back, bottom row first
+	inline std::vector<uint32_t> ReadColorAttachment(const Ref<Framebuffer>& framebuffer)
+	{
+		std::vector<uint32_t> pixels(framebuffer->GetWidth() * framebuffer->GetHeight());
+		Renderer::Submit([framebuffer, data = pixels.data(), size = (GLsizei)(pixels.size() * sizeof(uint32_t))]()
+		{
+			glGetTextureImage(framebuffer->GetColorAttachmentRendererID(0), 0, GL_RGBA, GL_UNSIGNED_BYTE, size, data);
+		});
+		Application::Get().FlushRenderCommands();
+		return pixels;
+	}
+
+	// Draw calls and draws the commands submitted so far executed with, see ReadColorAttachment
+	inline RenderAPIStats ReadRenderAPIStats()
+	{
+		RenderAPIStats stats;
+		Renderer::Submit([&stats]() { stats = OpenGLState::GetStats(); });
+		Application::Get().FlushRenderCommands();
+		return stats;
+	}
+
 	class RendererInitTest : public Test
 	{
 	public:
@@ -216,6 +243,144 @@ namespace Luma {
 		Ref<Shader> m_TestShader;
 	};
 
+	class ShaderProgramCacheTest : public Test
+	{
+	public:
+		const char* GetName() const override { return "Shader Program Cache"; }
+		const char* GetCategory() const override { return "Renderer"; }
+
+		void OnImGuiRender() override
+		{
+			ShaderProgramCacheStats stats = Shader::GetProgramCacheStats();
+			ImGui::Text("Loaded: %u", stats.LoadedPrograms);
+			ImGui::Text("Compiled: %u", stats.CompiledPrograms);
+			ImGui::Text("Rejected: %u", stats.RejectedPrograms);
+		}
+
+		TestResult Run() override
+		{
+			TestResult result;
+			result.Name = GetName();
+
+			// A directory of its own, the test must not touch the binaries of the real cache
+			const std::filesystem::path directory = std::filesystem::temp_directory_path() / "LumaShaderProgramCacheTest";
+			std::error_code error;
+			std::filesystem::remove_all(directory, error);
+
+			Application::Get().FlushRenderCommands();
+			Shader::SetProgramCacheDirectory(directory);
+
+			try
+			{
+				RunWithCache(directory, result);
+			}
+			catch (const std::exception& e)
+			{
+				result.Passed = false;
+				result.Message = std::string("Exception: ") + e.what();
+			}
+
+			Application::Get().FlushRenderCommands();
+			Shader::SetProgramCacheDirectory(Application::Get().GetSpecification().ShaderCacheDirectory);
+			std::filesystem::remove_all(directory, error);
+			return result;
+		}
+
+	private:
+		void RunWithCache(const std::filesystem::path& directory, TestResult& result)
+		{
+			Ref<Shader> shader;
+			ShaderProgramCacheStats created = CreateShader(shader);
+			if (created.CompiledPrograms != 1)
+			{
+				Fail(result, "First creation did not compile the program", created);
+				return;
+			}
+
+			std::vector<std::filesystem::path> files;
+			for (const auto& entry : std::filesystem::directory_iterator(directory))
+				files.push_back(entry.path());
+
+			if (files.empty())
+			{
+				result.Message = "Driver exposes no program binary formats, the cache is disabled";
+				return;
+			}
+
+			// Round trip
+			created = CreateShader(shader);
+			if (files.size() != 1 || created.LoadedPrograms != 1 || created.CompiledPrograms != 0 || !shader->GetRendererID())
+			{
+				Fail(result, "Stored program was not loaded back", created);
+				return;
+			}
+
+			// A truncated file, as a crash while writing would leave it, has to fall back to compiling
+			const uint64_t fileSize = std::filesystem::file_size(files[0]);
+			std::filesystem::resize_file(files[0], fileSize / 2);
+
+			created = CreateShader(shader);
+			if (created.RejectedPrograms != 1 || created.CompiledPrograms != 1 || !shader->GetRendererID())
+			{
+				Fail(result, "Corrupt program was not replaced by a compiled one", created);
+				return;
+			}
+
+			// The compiled program replaced the corrupt file
+			created = CreateShader(shader);
+			if (std::filesystem::file_size(files[0]) != fileSize || created.LoadedPrograms != 1)
+			{
+				Fail(result, "Corrupt program file was not rewritten", created);
+				return;
+			}
+
+			result.Message = "Program binary stored, loaded back and recompiled after corruption";
+		}
+
+		// Creates the test shader and returns how the cache counters changed
+		static ShaderProgramCacheStats CreateShader(Ref<Shader>& shader)
+		{
+			ShaderProgramCacheStats before = Shader::GetProgramCacheStats();
+			shader = Shader::CreateFromString(R"(
+#type vertex
+#version 430
+
+layout(location = 0) in vec3 a_Position;
+
+void main()
+{
+	gl_Position = vec4(a_Position, 1.0);
+}
+
+#type fragment
+#version 430
+
+layout(location = 0) out vec4 o_Color;
+
+void main()
+{
+	o_Color = vec4(1.0, 0.0, 1.0, 1.0);
+}
+)");
+			Application::Get().FlushRenderCommands();
+
+			ShaderProgramCacheStats after = Shader::GetProgramCacheStats();
+			ShaderProgramCacheStats delta;
+			delta.LoadedPrograms = after.LoadedPrograms - before.LoadedPrograms;
+			delta.CompiledPrograms = after.CompiledPrograms - before.CompiledPrograms;
+			delta.RejectedPrograms = after.RejectedPrograms - before.RejectedPrograms;
+			return delta;
+		}
+
+		static void Fail(TestResult& result, const char* message, const ShaderProgramCacheStats& created)
+		{
+			result.Passed = false;
+			std::ostringstream oss;
+			oss << message << " (loaded " << created.LoadedPrograms << ", compiled " << created.CompiledPrograms << ", rejected " << created.RejectedPrograms << ")";
+			result.Message = oss.str();
+		}
+	};
+
 	class FramebufferTest : public Test
 	{
 	public:
@@ -500,4 +665,455 @@ namespace Luma {
 		std::string m_LastTestResult = "No test run yet";
 	};
 
+	// Pushes a million quads and a million lines (AABB debug draw) through Renderer2D every frame while selected
+	class Renderer2DBenchmarkTest : public Test
+	{
+	public:
+		static constexpr uint32_t QuadsPerSide = 1000;
+		static constexpr uint32_t QuadCount = QuadsPerSide * QuadsPerSide;
+		static constexpr uint32_t AABBCount = 1000000 / 12 + 1;
+
+		const char* GetName() const override { return "Renderer2D Benchmark"; }
+		const char* GetCategory() const override { return "Renderer"; }
+
+		void OnInit() override
+		{
+			FramebufferSpecification spec;
+			spec.Width = 512;
+			spec.Height = 512;
+			spec.Attachments = { FramebufferTextureFormat::RGBA8 };
+			m_Framebuffer = Framebuffer::Create(spec);
+		}
+
+		void OnUpdate(Timestep ts) override
+		{
+			if (m_Continuous)
+				DrawFrame();
+		}
+
+		void OnImGuiRender() override
+		{
+			ImGui::Checkbox("Draw every frame", &m_Continuous);
+			ImGui::Text("Quads: %u", m_Stats.QuadCount);
+			ImGui::Text("Lines: %u", m_Stats.LineCount);
+			ImGui::Text("Draw Calls: %u", m_Stats.DrawCalls);
+			ImGui::Text("Submission: %.2f ms", m_SubmitTime);
+
+			if (m_Framebuffer)
+			{
+				ImGui::Separator();
+				auto colorAttachment = m_Framebuffer->GetColorAttachmentRendererID(0);
+				ImGui::Image((ImTextureID)(uint64_t)colorAttachment,
+					ImVec2(256, 256), ImVec2(0, 1), ImVec2(1, 0));
+			}
+		}
+
+		TestResult Run() override
+		{
+			TestResult result;
+			result.Name = GetName();
+
+			try
+			{
+				DrawFrame();
+
+				// Batches hold 20000 quads and 10000 lines, anything less means primitives were dropped or merged wrongly
+				const uint32_t lineCount = AABBCount * 12;
+				if (m_Stats.QuadCount != QuadCount || m_Stats.LineCount != lineCount || m_Stats.DrawCalls < QuadCount / 20000 + lineCount / 10000)
+				{
+					result.Passed = false;
+					std::ostringstream oss;
+					oss << "Unexpected stats: " << m_Stats.QuadCount << " quads, " << m_Stats.LineCount << " lines, " << m_Stats.DrawCalls << " draw calls";
+					result.Message = oss.str();
+					return result;
+				}
+
+				std::ostringstream oss;
+				oss << m_Stats.QuadCount << " quads and " << m_Stats.LineCount << " lines in " << m_Stats.DrawCalls
+					<< " draw calls, submitted in " << m_SubmitTime << " ms";
+				result.Message = oss.str();
+			}
+			catch (const std::exception& e)
+			{
+				result.Passed = false;
+				result.Message = std::string("Exception: ") + e.what();
+			}
+
+			return result;
+		}
+
+	private:
+		void DrawFrame()
+		{
+			Timer timer;
+
+			m_Framebuffer->Bind();
+			Renderer::Clear(0.1f, 0.1f, 0.1f, 1.0f);
+
+			Renderer2D::ResetStats();
+			Renderer2D::BeginScene(glm::ortho(0.0f, (float)QuadsPerSide, 0.0f, (float)QuadsPerSide), false);
+
+			const glm::vec2 quadSize = { 0.8f, 0.8f };
+			for (uint32_t y = 0; y < QuadsPerSide; y++)
+			{
+				for (uint32_t x = 0; x < QuadsPerSide; x++)
+				{
+					glm::vec4 color = { (float)x / QuadsPerSide, (float)y / QuadsPerSide, 0.5f, 1.0f };
+					Renderer2D::DrawQuad(glm::vec2{ x + 0.5f, y + 0.5f }, quadSize, color);
+				}
+			}
+
+			const AABB aabb = { glm::vec3(-0.5f), glm::vec3(0.5f) };
+			for (uint32_t i = 0; i < AABBCount; i++)
+			{
+				float x = (float)(i % QuadsPerSide) + 0.5f;
+				float y = (float)(i / QuadsPerSide) * 12.0f + 0.5f;
+				Renderer::DrawAABB(aabb, glm::translate(glm::mat4(1.0f), { x, y, 0.0f }));
+			}
+
+			Renderer2D::EndScene();
+			m_Framebuffer->Unbind();
+
+			m_SubmitTime = timer.ElapsedMillis();
+			m_Stats = Renderer2D::GetStats();
+		}
+
+		Ref<Framebuffer> m_Framebuffer;
+		Renderer2D::Statistics m_Stats;
+		float m_SubmitTime = 0.0f;
+		bool m_Continuous = false;
+	};
+
+	// Draws a grid of two different static meshes once through multi-draw indirect out of the static mesh
+	// pool and once submesh by submesh, both have to produce the same image
+	class MultiDrawIndirectTest : public Test
+	{
+	public:
+		static constexpr uint32_t Columns = 8;
+		static constexpr uint32_t Rows = 4;
+		static constexpr uint32_t EntityCount = Columns * Rows;
+
+		const char* GetName() const override { return "Multi-Draw Indirect"; }
+		const char* GetCategory() const override { return "Renderer"; }
+
+		void OnInit() override
+		{
+			FramebufferSpecification spec;
+			spec.Width = 512;
+			spec.Height = 256;
+			spec.Attachments = { FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::Depth };
+			m_Framebuffer = Framebuffer::Create(spec);
+
+			m_Meshes[0] = Ref<Mesh>::Create("Resources/Meshes/Cube1m.fbx");
+			m_Meshes[1] = Ref<Mesh>::Create("Resources/Meshes/Sphere1m.fbx");
+
+			// Instance transforms come from the instance attributes, like in the static mesh shaders
+			m_Shader = Shader::CreateFromString(R"(
+#type vertex
+#version 430
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec3 a_Normal;
+layout(location = 5) in mat4 a_Transform;
+
+uniform mat4 u_ViewProjection;
+
+out vec3 v_Normal;
+
+void main()
+{
+	v_Normal = mat3(a_Transform) * a_Normal;
+	gl_Position = u_ViewProjection * a_Transform * vec4(a_Position, 1.0);
+}
+
+#type fragment
+#version 430
+
+layout(location = 0) out vec4 o_Color;
+
+in vec3 v_Normal;
+
+void main()
+{
+	o_Color = vec4(abs(normalize(v_Normal)), 1.0);
+}
+)");
+		}
+
+		void OnShutdown() override
+		{
+			m_Meshes[0] = nullptr;
+			m_Meshes[1] = nullptr;
+		}
+
+		void OnImGuiRender() override
+		{
+			ImGui::Text("Entities: %u", EntityCount);
+			ImGui::Text("Multi-draw: %u draw calls, %u draws", m_MultiDrawStats.DrawCalls, m_MultiDrawStats.Draws);
+			ImGui::Text("Per draw: %u draw calls, %u draws", m_PerDrawStats.DrawCalls, m_PerDrawStats.Draws);
+
+			if (m_Framebuffer)
+			{
+				ImGui::Separator();
+				auto colorAttachment = m_Framebuffer->GetColorAttachmentRendererID(0);
+				ImGui::Image((ImTextureID)(uint64_t)colorAttachment,
+					ImVec2(512, 256), ImVec2(0, 1), ImVec2(1, 0));
+			}
+		}
+
+		TestResult Run() override
+		{
+			TestResult result;
+			result.Name = GetName();
+
+			try
+			{
+				uint32_t submeshCount = 0;
+				for (uint32_t i = 0; i < EntityCount; i++)
+					submeshCount += (uint32_t)m_Meshes[i % 2]->GetSubmeshes().size();
+
+				std::vector<uint32_t> multiDrawPixels = DrawFrame(true, m_MultiDrawStats);
+				std::vector<uint32_t> perDrawPixels = DrawFrame(false, m_PerDrawStats);
+
+				if (m_MultiDrawStats.DrawCalls != 1 || m_MultiDrawStats.Draws != submeshCount || m_PerDrawStats.DrawCalls != submeshCount)
+				{
+					result.Passed = false;
+					std::ostringstream oss;
+					oss << "Unexpected draw counts for " << submeshCount << " submeshes: multi-draw " << m_MultiDrawStats.DrawCalls << " calls / "
+						<< m_MultiDrawStats.Draws << " draws, per draw " << m_PerDrawStats.DrawCalls << " calls";
+					result.Message = oss.str();
+					return result;
+				}
+
+				// Every entity has to show up in the middle of its cell
+				const uint32_t width = m_Framebuffer->GetWidth();
+				const uint32_t cellSize = width / Columns;
+				for (uint32_t i = 0; i < EntityCount; i++)
+				{
+					uint32_t x = (i % Columns) * cellSize + cellSize / 2;
+					uint32_t y = (i / Columns) * cellSize + cellSize / 2;
+					if (multiDrawPixels[y * width + x] == ClearColor)
+					{
+						result.Passed = false;
+						result.Message = "Entity " + std::to_string(i) + " is missing from the multi-draw";
+						return result;
+					}
+				}
+
+				uint32_t mismatches = 0;
+				for (size_t i = 0; i < multiDrawPixels.size(); i++)
+					mismatches += multiDrawPixels[i] != perDrawPixels[i];
+
+				if (mismatches > multiDrawPixels.size() / 1000)
+				{
+					result.Passed = false;
+					result.Message = std::to_string(mismatches) + " pixels differ between the multi-draw and the per-draw path";
+					return result;
+				}
+
+				std::ostringstream oss;
+				oss << submeshCount << " submeshes in 1 multi-draw instead of " << m_PerDrawStats.DrawCalls << " draw calls, "
+					<< mismatches << " pixels differ";
+				result.Message = oss.str();
+			}
+			catch (const std::exception& e)
+			{
+				result.Passed = false;
+				result.Message = std::string("Exception: ") + e.what();
+			}
+
+			return result;
+		}
+
+	private:
+		// Black, as read back in RGBA8
+		static constexpr uint32_t ClearColor = 0xff000000;
+
+		std::vector<uint32_t> DrawFrame(bool multiDraw, RenderAPIStats& stats)
+		{
+			m_Framebuffer->Bind();
+			Renderer::Clear(0.0f, 0.0f, 0.0f, 1.0f);
+
+			// One cell of 2x2 units per entity
+			m_Shader->SetMat4("u_ViewProjection", glm::ortho(0.0f, 2.0f * Columns, 0.0f, 2.0f * Rows, -10.0f, 10.0f));
+
+			std::vector<MultiDrawSubmesh> draws;
+			std::vector<glm::mat4> transforms;
+			std::vector<uint32_t> meshIndices;
+			for (uint32_t i = 0; i < EntityCount; i++)
+			{
+				const Ref<Mesh>& mesh = m_Meshes[i % 2];
+				glm::mat4 transform = glm::translate(glm::mat4(1.0f), { (i % Columns) * 2.0f + 1.0f, (i / Columns) * 2.0f + 1.0f, 0.0f })
+					* glm::rotate(glm::mat4(1.0f), 0.3f * i, glm::normalize(glm::vec3(1.0f, 1.0f, 0.0f)));
+
+				const auto& submeshes = mesh->GetSubmeshes();
+				for (uint32_t submeshIndex = 0; submeshIndex < submeshes.size(); submeshIndex++)
+				{
+					draws.push_back({ mesh.Raw(), submeshIndex, 1 });
+					meshIndices.push_back(i % 2);
+					transforms.push_back(transform * submeshes[submeshIndex].Transform);
+				}
+			}
+
+			const RenderAPIStats before = ReadRenderAPIStats();
+
+			if (multiDraw)
+			{
+				Renderer::SubmitMultiDrawIndirectWithShader(draws.data(), (uint32_t)draws.size(), transforms.data(), m_Shader);
+			}
+			else
+			{
+				for (size_t i = 0; i < draws.size(); i++)
+					Renderer::SubmitSubmeshInstancedWithShader(m_Meshes[meshIndices[i]], draws[i].SubmeshIndex, &transforms[i], 1, m_Shader);
+			}
+
+			const RenderAPIStats after = ReadRenderAPIStats();
+			stats.DrawCalls = after.DrawCalls - before.DrawCalls;
+			stats.Draws = after.Draws - before.Draws;
+
+			m_Framebuffer->Unbind();
+			return ReadColorAttachment(m_Framebuffer);
+		}
+
+		Ref<Framebuffer> m_Framebuffer;
+		Ref<Shader> m_Shader;
+		Ref<Mesh> m_Meshes[2];
+		RenderAPIStats m_MultiDrawStats;
+		RenderAPIStats m_PerDrawStats;
+	};
+
+	class Renderer2DTextureArrayTest : public Test
+	{
+	public:
+		static constexpr uint32_t TextureCount = 256;
+		static constexpr uint32_t TextureSize = 16;
+		static constexpr uint32_t TexturesPerSide = 16;
+
+		const char* GetName() const override { return "Renderer2D Texture Arrays"; }
+		const char* GetCategory() const override { return "Renderer"; }
+
+		void OnInit() override
+		{
+			FramebufferSpecification spec;
+			spec.Width = 512;
+			spec.Height = 512;
+			spec.Attachments = { FramebufferTextureFormat::RGBA8 };
+			m_Framebuffer = Framebuffer::Create(spec);
+
+			m_Textures.reserve(TextureCount);
+			for (uint32_t i = 0; i < TextureCount; i++)
+			{
+				Ref<Texture2D> texture = Texture2D::Create(TextureFormat::RGBA, TextureSize, TextureSize);
+				texture->Lock();
+				Buffer buffer = texture->GetWriteableBuffer();
+				uint32_t color = GetTextureColor(i);
+				for (uint32_t pixel = 0; pixel < TextureSize * TextureSize; pixel++)
+					buffer.Write(&color, sizeof(uint32_t), pixel * sizeof(uint32_t));
+				texture->Unlock();
+				m_Textures.push_back(texture);
+			}
+		}
+
+		void OnShutdown() override
+		{
+			m_Textures.clear();
+		}
+
+		void OnImGuiRender() override
+		{
+			ImGui::Text("Textures: %u", TextureCount);
+			ImGui::Text("Draw Calls: %u", m_Stats.DrawCalls);
+
+			if (m_Framebuffer)
+			{
+				ImGui::Separator();
+				auto colorAttachment = m_Framebuffer->GetColorAttachmentRendererID(0);
+				ImGui::Image((ImTextureID)(uint64_t)colorAttachment,
+					ImVec2(256, 256), ImVec2(0, 1), ImVec2(1, 0));
+			}
+		}
+
+		TestResult Run() override
+		{
+			TestResult result;
+			result.Name = GetName();
+
+			try
+			{
+				DrawFrame();
+
+				// Same-sized textures share one array, more than MaxTextureSlots of them still fit into one batch
+				if (m_Stats.QuadCount != TextureCount || m_Stats.DrawCalls != 1)
+				{
+					result.Passed = false;
+					std::ostringstream oss;
+					oss << "Unexpected stats: " << m_Stats.QuadCount << " quads in " << m_Stats.DrawCalls << " draw calls";
+					result.Message = oss.str();
+					return result;
+				}
+
+				// Each cell has to show its own texture, a wrong layer or lost array would give another texture's color
+				std::vector<uint32_t> pixels = ReadColorAttachment(m_Framebuffer);
+				const uint32_t cellSize = m_Framebuffer->GetWidth() / TexturesPerSide;
+				uint32_t wrongCells = 0, firstWrongCell = 0;
+				for (uint32_t i = 0; i < TextureCount; i++)
+				{
+					uint32_t x = (i % TexturesPerSide) * cellSize + cellSize / 2;
+					uint32_t y = (i / TexturesPerSide) * cellSize + cellSize / 2;
+					if (pixels[x + y * m_Framebuffer->GetWidth()] != GetTextureColor(i) && wrongCells++ == 0)
+						firstWrongCell = i;
+				}
+
+				if (wrongCells)
+				{
+					result.Passed = false;
+					std::ostringstream oss;
+					oss << wrongCells << " of " << TextureCount << " cells show the wrong color, first one is cell " << firstWrongCell;
+					result.Message = oss.str();
+					return result;
+				}
+
+				result.Message = std::to_string(TextureCount) + " textures drawn in a single draw call";
+			}
+			catch (const std::exception& e)
+			{
+				result.Passed = false;
+				result.Message = std::string("Exception: ") + e.what();
+			}
+
+			return result;
+		}
+
+	private:
+		// Opaque and distinct for every texture, RGBA bytes in memory order
+		static uint32_t GetTextureColor(uint32_t index)
+		{
+			return 0xff000000 | (index * 0x9e3779b9 & 0x00ffffff);
+		}
+
+		void DrawFrame()
+		{
+			m_Framebuffer->Bind();
+			Renderer::Clear(0.1f, 0.1f, 0.1f, 1.0f);
+
+			Renderer2D::ResetStats();
+			Renderer2D::BeginScene(glm::ortho(0.0f, (float)TexturesPerSide, 0.0f, (float)TexturesPerSide), false);
+
+			for (uint32_t i = 0; i < TextureCount; i++)
+			{
+				glm::vec2 position = { (i % TexturesPerSide) + 0.5f, (i / TexturesPerSide) + 0.5f };
+				Renderer2D::DrawQuad(position, { 0.9f, 0.9f }, m_Textures[i]);
+			}
+
+			Renderer2D::EndScene();
+			m_Framebuffer->Unbind();
+
+			m_Stats = Renderer2D::GetStats();
+		}
+
+		Ref<Framebuffer> m_Framebuffer;
+		std::vector<Ref<Texture2D>> m_Textures;
+		Renderer2D::Statistics m_Stats;
+	};
+
 }
\ No newline at end of file